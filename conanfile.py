@@ -105,6 +105,8 @@ class UgLibsRecipe(conan.ConanFile):
             'range-v3::range-v3',
             'spdlog::spdlog',
         ]
+        if self.settings.os in ['Linux', 'FreeBSD']:
+            self.cpp_info.components['util'].system_libs = ['pthread']
         self.cpp_info.components['util'].set_property(
             'cmake_target_name',
             'util')
@@ -116,6 +118,8 @@ class UgLibsRecipe(conan.ConanFile):
 
         self.cpp_info.components['ia'].libs = ['ia']
         self.cpp_info.components['ia'].requires = ['util']
+        if self.settings.os in ['Linux', 'FreeBSD']:
+            self.cpp_info.components['ia'].system_libs = ['pthread']
         self.cpp_info.components['ia'].set_property(
             'cmake_target_name',
             'ia')
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "util/integers.hpp"
+#include "util/integer-variant.hpp"
+#include "util/meta.hpp"
+#include "util/variant.hpp"
+
+#include "containers/tight-integers-container.hpp"
+
+namespace containers{
+
+template<class IntegerVariant>
+class any_tight_integer_container;
+
+/**
+  * a tight integer container whose integer type is chosen at runtime
+  * among the types of the variant `std::variant<Ts...>`
+  *
+  * each bulk operation visits the variant once and then runs the loop
+  * of the concrete container, instead of dispatching on every element;
+  * the values are exchanged as `value_type`, which is `int64_t` if any
+  * of the integers is signed and `uint64_t` otherwise; a variant with
+  * signed integers cannot have an unsigned integer of 64 bits, whose
+  * values would not fit in `int64_t`
+  */
+template<class ... Ts>
+class any_tight_integer_container<std::variant<Ts...>>{
+public:
+	using integer_variant = std::variant<Ts...>;
+
+	using container_variant = util::generate_variant_with_t_t<
+		containers::tight_integer_container,
+		util::list_of_types<Ts...>>;
+
+	using value_type = std::conditional_t<
+		(std::is_same_v<
+			typename util::integer_info<Ts>::signess,
+			util::signed_flag> || ...),
+		int64_t,
+		uint64_t>;
+
+	static_assert(
+		std::is_unsigned_v<value_type>
+			|| ((util::integer_info<Ts>::n_bits < 64
+				|| std::is_same_v<
+					typename util::integer_info<Ts>::signess,
+					util::signed_flag>) && ...),
+		"the values of an unsigned integer of 64 bits do not fit in the "
+		"int64_t of a variant with signed integers");
+
+	using size_type = uint64_t;
+
+	/**
+	  * an empty container of the first integer type
+	  */
+	any_tight_integer_container() = default;
+
+	template<class T>
+	explicit any_tight_integer_container(
+		std::in_place_type_t<T>,
+		size_type n_elements = 0)
+		: m_container(
+			std::in_place_type<containers::tight_integer_container<T>>,
+			n_elements)
+	{}
+
+	/**
+	  * a container of the integer type held by `integer`, which is
+	  * what `util::integer_from_string` returns
+	  */
+	explicit any_tight_integer_container(
+		integer_variant const& integer,
+		size_type n_elements = 0)
+		: m_container(std::visit(
+			[n_elements]<class T>(T) -> container_variant
+			{
+				return containers::tight_integer_container<T>(n_elements);
+			},
+			integer))
+	{}
+
+	/**
+	  * a container of the integer with `precision` bits and sign `S`;
+	  * throws `std::runtime_error` if the variant does not have it
+	  */
+	template<util::signess S>
+	static any_tight_integer_container from_precision(
+		uint32_t precision,
+		size_type n_elements = 0)
+	{
+		std::optional<integer_variant> integer;
+
+		if constexpr(std::is_same_v<S, util::signed_flag>){
+			integer = util::signed_integer_from_precision<
+				integer_variant>(precision);
+		}else{
+			integer = util::unsigned_integer_from_precision<
+				integer_variant>(precision);
+		}
+
+		if(!integer.has_value()){
+			throw std::runtime_error(
+				"there is no integer with precision "
+				+ std::to_string(precision));
+		}
+
+		return any_tight_integer_container(*integer, n_elements);
+	}
+
+	/**
+	  * calls `f` with the concrete container
+	  */
+	template<class F>
+	decltype(auto) visit(F&& f)
+	{
+		return std::visit(std::forward<F>(f), m_container);
+	}
+
+	template<class F>
+	decltype(auto) visit(F&& f) const
+	{
+		return std::visit(std::forward<F>(f), m_container);
+	}
+
+	/**
+	  * the integer type of the elements, as a value of the variant
+	  */
+	integer_variant integer() const
+	{
+		return visit([]<class C>(C const&) -> integer_variant
+		{
+			return typename C::integer_type{};
+		});
+	}
+
+	uint32_t precision() const
+	{
+		return visit([]<class C>(C const&)
+		{
+			return static_cast<uint32_t>(
+				util::integer_info<typename C::integer_type>::n_bits);
+		});
+	}
+
+	bool is_signed() const
+	{
+		return visit([]<class C>(C const&){ return C::is_signed; });
+	}
+
+	size_type size() const
+	{
+		return visit([](auto const& c){ return static_cast<size_type>(c.size()); });
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	void resize(size_type n_elements)
+	{
+		visit([n_elements](auto& c){ c.resize(n_elements); });
+	}
+
+	/**
+	  * the element at `index`; throws `std::out_of_range`
+	  */
+	value_type get(size_type index) const
+	{
+		return visit([index](auto const& c)
+		{
+			check_index(index, c.size());
+			return static_cast<value_type>(c[index]);
+		});
+	}
+
+	/**
+	  * sets the element at `index`; throws `std::out_of_range` if the
+	  * index or the value is out of range
+	  */
+	void set(size_type index, value_type value)
+	{
+		visit([index, value](auto& c)
+		{
+			check_index(index, c.size());
+			c[index] = to_element(c, value);
+		});
+	}
+
+	/**
+	  * sets every element to `value`; throws `std::out_of_range` if the
+	  * value is out of range
+	  */
+	void fill(value_type value)
+	{
+		visit([value](auto& c)
+		{
+			auto const v = to_element(c, value);
+
+			// the containers of 1, 8, 16, 32 and 64 bits are a std::vector
+			if constexpr(requires{ c.fill(v); })
+				c.fill(v);
+			else
+				std::fill(c.begin(), c.end(), v);
+		});
+	}
+
+	/**
+	  * copies `values` to the elements starting at `offset`; throws
+	  * `std::out_of_range` if they do not fit or a value is out of range
+	  */
+	void copy_from(std::span<value_type const> values, size_type offset = 0)
+	{
+		visit([values, offset](auto& c)
+		{
+			check_range(offset, values.size(), c.size());
+			for(size_type i=0; i<values.size(); ++i)
+				c[offset + i] = to_element(c, values[i]);
+		});
+	}
+
+	/**
+	  * copies the elements starting at `offset` to `out`; throws
+	  * `std::out_of_range` if there are not enough elements
+	  */
+	void unpack(std::span<value_type> out, size_type offset = 0) const
+	{
+		visit([out, offset](auto const& c)
+		{
+			check_range(offset, out.size(), c.size());
+			for(size_type i=0; i<out.size(); ++i)
+				out[i] = static_cast<value_type>(c[offset + i]);
+		});
+	}
+
+	/**
+	  * resizes to the size of `other` and copies its elements,
+	  * which may have another precision
+	  */
+	void assign(any_tight_integer_container const& other)
+	{
+		std::visit(
+			[](auto& c, auto const& o)
+			{
+				c.resize(o.size());
+				for(size_type i=0; i<o.size(); ++i){
+					c[i] = to_element(c, static_cast<value_type>(o[i]));
+				}
+			},
+			m_container,
+			other.m_container);
+	}
+
+	/**
+	  * the sum of the elements, wrapping around on overflow
+	  */
+	value_type sum() const
+	{
+		return visit([](auto const& c)
+		{
+			using unsigned_t = std::make_unsigned_t<value_type>;
+
+			unsigned_t s = 0;
+			for(size_type i=0; i<c.size(); ++i)
+				s += static_cast<unsigned_t>(static_cast<value_type>(c[i]));
+
+			return static_cast<value_type>(s);
+		});
+	}
+
+	/**
+	  * the index of the first element equal to `value`
+	  */
+	std::optional<size_type> find(value_type value) const
+	{
+		return visit([value](auto const& c) -> std::optional<size_type>
+		{
+			if(!fits(c, value))
+				return std::nullopt;
+
+			for(size_type i=0; i<c.size(); ++i){
+				if(static_cast<value_type>(c[i]) == value)
+					return i;
+			}
+
+			return std::nullopt;
+		});
+	}
+
+	size_type count(value_type value) const
+	{
+		return visit([value](auto const& c)
+		{
+			size_type n = 0;
+
+			if(fits(c, value)){
+				for(size_type i=0; i<c.size(); ++i)
+					n += static_cast<value_type>(c[i]) == value;
+			}
+
+			return n;
+		});
+	}
+
+private:
+	template<class C>
+	static constexpr bool fits(C const&, value_type value)
+	{
+		using integer_type = typename C::integer_type;
+		using limits = std::numeric_limits<integer_type>;
+
+		if constexpr(std::is_signed_v<value_type>){
+			if constexpr(C::is_unsigned){
+				if(value < 0)
+					return false;
+				return static_cast<uint64_t>(value)
+					<= static_cast<uint64_t>(limits::max());
+			}else{
+				return value >= static_cast<value_type>(limits::min())
+					&& value <= static_cast<value_type>(limits::max());
+			}
+		}else{
+			return value <= static_cast<value_type>(limits::max());
+		}
+	}
+
+	template<class C>
+	static constexpr auto to_element(C const& c, value_type value)
+	{
+		if(!fits(c, value)){
+			throw std::out_of_range(
+				"value out of range: " + std::to_string(value));
+		}
+
+		return static_cast<typename C::underlying_integer_t>(value);
+	}
+
+	static void check_index(size_type index, size_type size)
+	{
+		if(index >= size){
+			throw std::out_of_range(
+				"index out of range: " + std::to_string(index));
+		}
+	}
+
+	static void check_range(size_type offset, size_type count, size_type size)
+	{
+		if(offset > size || count > size - offset){
+			throw std::out_of_range(
+				"range out of range: [" + std::to_string(offset) + ", "
+				+ std::to_string(offset + count) + ")");
+		}
+	}
+
+	container_variant m_container;
+};
+
+} // end of namespace containers
@@ -124,6 +124,110 @@ public:
 		{
 			return !(a == b);
 		}
+
+		constexpr auto get_data() const noexcept
+		{
+			return m_reference.get_data();
+		}
+
+		constexpr uint64_t get_bit_index() const noexcept
+		{
+			return static_cast<uint64_t>(m_reference.bit_index);
+		}
+
+		/*
+		 * the algorithms below are found by argument dependent lookup,
+		 * like the `std::vector<bool>` overloads of libc++, and work
+		 * on whole integers instead of going through the bit references
+		 */
+
+		template<std::integral R>
+		friend constexpr iterator<R> copy(
+			iterator first,
+			iterator last,
+			iterator<R> out)
+		{
+			auto const n = last - first;
+			util::copy_bits(
+				first.get_data(), first.get_bit_index(),
+				out.get_data(), out.get_bit_index(),
+				static_cast<uint64_t>(n));
+			return out + n;
+		}
+
+		template<std::integral R>
+		friend constexpr iterator<R> copy_backward(
+			iterator first,
+			iterator last,
+			iterator<R> out_last)
+		{
+			auto const n = last - first;
+			auto const out = out_last - n;
+			util::copy_bits(
+				first.get_data(), first.get_bit_index(),
+				out.get_data(), out.get_bit_index(),
+				static_cast<uint64_t>(n));
+			return out;
+		}
+
+		/**
+		  * sets the bits to the last bit of `value`, as assigning it
+		  * to each bit reference does
+		  */
+		friend constexpr void fill(
+			iterator first,
+			iterator last,
+			std::integral auto const& value)
+		{
+			util::fill_bits(
+				first.get_data(), first.get_bit_index(),
+				static_cast<uint64_t>(last - first),
+				(value & 1) != 0);
+		}
+
+		template<std::integral R>
+		friend constexpr bool equal(
+			iterator first,
+			iterator last,
+			iterator<R> other)
+		{
+			return util::equal_bits(
+				first.get_data(), first.get_bit_index(),
+				other.get_data(), other.get_bit_index(),
+				static_cast<uint64_t>(last - first));
+		}
+
+		friend constexpr iterator find(
+			iterator first,
+			iterator last,
+			std::integral auto const& value)
+		{
+			if(value != 0 && value != 1)
+				return last;
+
+			auto const i = util::find_bit(
+				first.get_data(), first.get_bit_index(),
+				static_cast<uint64_t>(last - first),
+				value == 1);
+
+			return first + static_cast<int64_t>(i - first.get_bit_index());
+		}
+
+		friend constexpr int64_t count(
+			iterator first,
+			iterator last,
+			std::integral auto const& value)
+		{
+			if(value != 0 && value != 1)
+				return 0;
+
+			auto const n = last - first;
+			auto const ones = static_cast<int64_t>(util::popcount(
+				first.get_data(), first.get_bit_index(),
+				static_cast<uint64_t>(n)));
+
+			return value == 1 ? ones : n - ones;
+		}
 	private:
 		constexpr auto max_index() const
 		{
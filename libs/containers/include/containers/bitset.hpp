@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include "util/ranges.hpp"
 
@@ -70,6 +71,44 @@ public:
 		return m_adaptor.rend();
 	}
 
+	/*
+	 * the members below call the algorithms of the adaptor iterators,
+	 * which work on whole bytes instead of bit by bit
+	 */
+
+	/**
+	  * sets every bit to the last bit of `value`
+	  */
+	constexpr void fill(std::integral auto value)
+	{
+		using std::fill;
+		fill(begin(), end(), value);
+	}
+
+	/**
+	  * @return the number of bits set to `value`
+	  */
+	constexpr int64_t count(std::integral auto value) const
+	{
+		using std::count;
+		return count(begin(), end(), value);
+	}
+
+	/**
+	  * @return the index of the first bit set to `value`, or `N`
+	  */
+	constexpr uint64_t find(std::integral auto value) const
+	{
+		using std::find;
+		return static_cast<uint64_t>(find(begin(), end(), value) - begin());
+	}
+
+	friend constexpr bool operator==(bitset const& a, bitset const& b)
+	{
+		using std::equal;
+		return equal(a.begin(), a.end(), b.begin());
+	}
+
 private:
 	underlying_array_t m_data;
 	adaptor_t m_adaptor = adaptor_t{m_data};
@@ -89,76 +89,32 @@ private:
 		return N * tight_index;
 	}
 
-	constexpr auto tight_container_bits() const noexcept
+	constexpr auto container_words() const noexcept
 	{
-		return bit_container_adaptor(std::span(
+		return std::span(
 			m_container_ptr->m_data.data(),
-			m_container_ptr->m_data.size()
-		));
-	}
-
-	constexpr auto get_element_bit_range() const noexcept
-	{
-		auto tcb = tight_container_bits();
-		auto b = tcb.begin() + compute_bit_index();
-		return rg::subrange(b, b + N);
+			m_container_ptr->m_data.size());
 	}
 
 	/**
-		* our number region from a element
-		* is the N bits of this element if the element is unsigned
-		* is the N-1 last bits of this element if the element is signed
-		*
-		*/
-	constexpr auto get_element_number_region_bits() const noexcept
-	{
-		return get_element_bit_range() | rg::vw::drop(int{is_signed});
-	}
-
-	/**
-		* our number region from a underlying_integer type
-		* is the last N bits for unsigned and the last
-		* N-1 bits for signed
-		*/
-	constexpr auto get_number_region_from_underlying_type(
-		underlying_integer_t& x) const noexcept
-	{
-		auto c = bit_container_adaptor(x);
-		auto const n =
-			bits_per_underlying_integer
-			- (N - int{is_signed});
-
-		return rg::subrange(rg::begin(c) + n, rg::end(c));
-	}
-
-	constexpr auto get_sign_iterator() const noexcept
-		requires is_signed
-	{
-		return get_element_bit_range().begin();
-	}
-
-	constexpr void set_sign_bit(underlying_integer_t v) const noexcept
-	{
-		v = static_cast<underlying_integer_t>(v&1);
-		*get_sign_iterator() = v;
-	}
-
-	constexpr underlying_integer_t get_sign_bit() const noexcept
-	{
-		return *get_sign_iterator();
-	}
-
+	  * the element is written with one read-modify-write per
+	  * underlying integer it touches, instead of bit by bit
+	  */
 	constexpr void impl_from_underlying_integer(underlying_integer_t x) const
 	{
-		auto e_bits = get_element_number_region_bits();
-		auto v_bits = get_number_region_from_underlying_type(x);
-		rg::copy(v_bits, e_bits.begin());
+		auto const v = static_cast<uint64_t>(x);
+		auto bits = v & util::low_bits_mask(N - int{is_signed});
+
 		if constexpr (is_signed){
 			if(x < underlying_integer_t{0})
-				set_sign_bit(1);
-			else
-				set_sign_bit(0);
+				bits |= uint64_t{1} << (N - 1);
 		}
+
+		util::write_bits(
+			container_words(),
+			static_cast<uint64_t>(compute_bit_index()),
+			N,
+			bits);
 	}
 
 	constexpr auto& from_underlying_integer(underlying_integer_t x)
@@ -176,16 +132,17 @@ private:
 	[[nodiscard]] constexpr
 	underlying_integer_t to_undelying_integer() const
 	{
-		underlying_integer_t v = 0;
+		auto v = util::read_bits(
+			container_words(),
+			static_cast<uint64_t>(compute_bit_index()),
+			N);
+
 		if constexpr (is_signed){
-			if(get_sign_bit())
-				v = ~0;
+			if(v >> (N - 1))
+				v |= ~util::low_bits_mask(N);
 		}
 
-		auto v_bits = get_number_region_from_underlying_type(v);
-		auto e_bits = get_element_number_region_bits();
-		rg::copy(e_bits, v_bits.begin());
-		return v;
+		return static_cast<underlying_integer_t>(v);
 	}
 
 public:
@@ -632,7 +589,29 @@ public:
 		const Alloc& alloc = Alloc())
 		: tight_integer_container(count, alloc)
 	{
-		rg::fill(*this, value);
+		fill(value);
+	}
+
+	/**
+	  * sets every element to `value`, the first element is written and
+	  * then the filled bits are doubled by whole integers
+	  */
+	constexpr void fill(underlying_integer_t value)
+	{
+		if(m_size == 0)
+			return;
+
+		(*this)[0] = value;
+
+		auto const words = std::span(m_data.data(), m_data.size());
+		uint64_t const n_bits = uint64_t{N}*m_size;
+
+		for(uint64_t filled = N; filled < n_bits; filled *= 2){
+			util::copy_bits(
+				words, 0,
+				words, filled,
+				std::min(filled, n_bits - filled));
+		}
 	}
 
 
@@ -810,7 +789,16 @@ public:
 			OtherAlloc,
 			OtherContainer> const& other)
 	{
-		return rg::equal(t, other);
+		// the same bits are the same values when the elements agree
+		// on their width and sign, so whole integers are compared
+		if constexpr(N == OtherN && std::is_same_v<S, OtherS>){
+			return t.size() == other.size() && util::equal_bits(
+				std::span(t.m_data.data(), t.m_data.size()), 0,
+				std::span(other.m_data.data(), other.m_data.size()), 0,
+				uint64_t{N}*t.size());
+		}else{
+			return rg::equal(t, other);
+		}
 	}
 
 	template<
@@ -832,6 +820,9 @@ public:
 	}
 
 private:
+	template<uint8_t, class, class, class, class>
+	friend class tight_integer_container;
+
 	container_t m_data;
 	size_t m_size = 0;
 };
@@ -0,0 +1,120 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "util/integer-variant.hpp"
+#include "containers/any-tight-integer-container.hpp"
+
+using integer_variant = util::merged_variant_t<
+	util::make_integer_variant_t<util::unsigned_flag, 1, 16>,
+	util::make_integer_variant_t<util::signed_flag, 2, 16>>;
+
+using any_container = containers::any_tight_integer_container<integer_variant>;
+
+TEST_CASE("any tight integer container construction", "[any-tight-integer-container]")
+{
+	STATIC_REQUIRE(std::is_same_v<any_container::value_type, int64_t>);
+
+	auto c = any_container::from_precision<util::unsigned_flag>(5, 10);
+	REQUIRE(c.precision() == 5);
+	REQUIRE(!c.is_signed());
+	REQUIRE(c.size() == 10);
+
+	auto s = any_container{ *util::integer_from_string<integer_variant>("int12"), 3 };
+	REQUIRE(s.precision() == 12);
+	REQUIRE(s.is_signed());
+	REQUIRE(s.size() == 3);
+	REQUIRE(std::holds_alternative<util::signed_integer<12>>(s.integer()));
+
+	auto b = any_container{ std::in_place_type<util::unsigned_integer<8>>, 4 };
+	REQUIRE(b.precision() == 8);
+
+	REQUIRE_THROWS_AS(
+		any_container::from_precision<util::signed_flag>(1),
+		std::runtime_error);
+}
+
+TEST_CASE("any tight integer container bulk operations", "[any-tight-integer-container]")
+{
+	for(uint32_t n = 2; n <= 16; ++n){
+		INFO(n);
+		auto c = any_container::from_precision<util::signed_flag>(n, 20);
+		auto const max = (int64_t{1} << (n - 1)) - 1;
+		auto const min = -max - 1;
+
+		c.fill(min);
+		REQUIRE(c.count(min) == 20);
+		REQUIRE(c.sum() == 20*min);
+
+		std::vector<int64_t> values(10);
+		for(std::size_t i=0; i<values.size(); ++i)
+			values[i] = static_cast<int64_t>(i) % (max + 1) - static_cast<int64_t>(i % 2);
+
+		c.copy_from(values, 5);
+
+		std::vector<int64_t> out(10);
+		c.unpack(out, 5);
+		REQUIRE(out == values);
+
+		REQUIRE(c.get(0) == min);
+		REQUIRE(c.get(4) == min);
+		REQUIRE(c.get(15) == min);
+		REQUIRE(c.find(values[3]).has_value());
+		REQUIRE(c.find(max + 1) == std::nullopt);
+
+		c.set(19, max);
+		REQUIRE(c.get(19) == max);
+
+		REQUIRE_THROWS_AS(c.set(0, max + 1), std::out_of_range);
+		REQUIRE_THROWS_AS(c.set(20, 0), std::out_of_range);
+		REQUIRE_THROWS_AS(c.copy_from(values, 15), std::out_of_range);
+		REQUIRE_THROWS_AS(c.unpack(out, 11), std::out_of_range);
+	}
+
+	SECTION("unsigned"){
+		auto c = any_container::from_precision<util::unsigned_flag>(3, 8);
+		std::vector<int64_t> const values{ 0, 1, 2, 3, 4, 5, 6, 7 };
+		c.copy_from(values);
+		REQUIRE(c.sum() == 28);
+		REQUIRE(c.find(7) == 7u);
+		REQUIRE(c.find(-1) == std::nullopt);
+		REQUIRE_THROWS_AS(c.fill(8), std::out_of_range);
+		REQUIRE_THROWS_AS(c.fill(-1), std::out_of_range);
+
+		SECTION("assign between precisions"){
+			auto wide = any_container::from_precision<util::signed_flag>(16);
+			wide.assign(c);
+			REQUIRE(wide.size() == 8);
+			REQUIRE(wide.precision() == 16);
+			REQUIRE(wide.sum() == 28);
+
+			wide.set(0, -1);
+			REQUIRE_THROWS_AS(c.assign(wide), std::out_of_range);
+		}
+	}
+}
+
+TEST_CASE("any tight integer container of 64 bits", "[any-tight-integer-container]")
+{
+	// without signed integers the values are not narrowed to int64_t
+	using unsigned_variant = std::variant<
+		util::unsigned_integer<7>,
+		util::unsigned_integer<64>>;
+
+	using container = containers::any_tight_integer_container<unsigned_variant>;
+	STATIC_REQUIRE(std::is_same_v<container::value_type, uint64_t>);
+
+	auto const max = std::numeric_limits<uint64_t>::max();
+
+	container c{ std::in_place_type<util::unsigned_integer<64>>, 5 };
+	c.fill(max);
+	REQUIRE(c.count(max) == 5);
+	REQUIRE(c.get(4) == max);
+
+	container small{ std::in_place_type<util::unsigned_integer<7>>, 5 };
+	REQUIRE_THROWS_AS(small.fill(max), std::out_of_range);
+	REQUIRE_THROWS_AS(small.assign(c), std::out_of_range);
+}
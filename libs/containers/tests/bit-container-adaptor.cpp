@@ -110,3 +110,95 @@ TEST_CASE("bit container adaptor related tests", "[containers]")
 	REQUIRE(rg::size(bits_c42) == rg::size(bits_42));
 	REQUIRE(rg::equal(bits_c42, bits_42));
 }
+
+TEST_CASE("bit container adaptor algorithms", "[containers]")
+{
+	std::array<uint16_t, 12> a;
+	uint64_t seed = 0x2545f4914f6cdd1d;
+	for(auto& x : a){
+		seed = seed*6364136223846793005 + 1442695040888963407;
+		x = static_cast<uint16_t>(seed >> 33);
+	}
+
+	auto c = containers::bit_container_adaptor(std::span(a));
+	std::vector<uint16_t> bits(c.begin(), c.end());
+
+	auto const n = static_cast<int64_t>(bits.size());
+
+	for(int64_t first : { 0L, 1L, 15L, 16L, 37L }){
+		for(int64_t last : { first, first + 1, first + 17, n - 3, n }){
+			if(last < first)
+				continue;
+
+			INFO(first << " " << last);
+
+			auto const b = c.begin() + first;
+			auto const e = c.begin() + last;
+
+			using std::count;
+			using std::find;
+			using std::equal;
+
+			REQUIRE(count(b, e, 1) == std::count(
+				bits.begin() + first, bits.begin() + last, 1));
+			REQUIRE(count(b, e, 0) == std::count(
+				bits.begin() + first, bits.begin() + last, 0));
+			REQUIRE(count(b, e, 2) == 0);
+
+			REQUIRE(find(b, e, 1) - c.begin() == std::find(
+				bits.begin() + first, bits.begin() + last, 1) - bits.begin());
+			REQUIRE(find(b, e, 0) - c.begin() == std::find(
+				bits.begin() + first, bits.begin() + last, 0) - bits.begin());
+
+			REQUIRE(equal(b, e, b));
+
+			auto other = a;
+			auto o = containers::bit_container_adaptor(std::span(other));
+			REQUIRE(equal(b, e, o.begin() + first));
+
+			if(last > first){
+				auto flipped = o.begin() + (first + last)/2;
+				*flipped = 1 - *flipped;
+				REQUIRE(!equal(b, e, o.begin() + first));
+			}
+		}
+	}
+
+	SECTION("fill"){
+		auto expected = bits;
+		using std::fill;
+
+		fill(c.begin() + 3, c.begin() + 150, 1);
+		std::fill(expected.begin() + 3, expected.begin() + 150, 1);
+		REQUIRE(std::equal(c.begin(), c.end(), expected.begin()));
+
+		fill(c.begin() + 40, c.begin() + 41, 2);
+		std::fill(expected.begin() + 40, expected.begin() + 41, 0);
+		REQUIRE(std::equal(c.begin(), c.end(), expected.begin()));
+	}
+
+	SECTION("copy"){
+		auto expected = bits;
+		using std::copy;
+		using std::copy_backward;
+
+		auto r = copy(c.begin() + 5, c.begin() + 105, c.begin() + 9);
+		std::copy_backward(
+			expected.begin() + 5, expected.begin() + 105,
+			expected.begin() + 109);
+		REQUIRE(r == c.begin() + 109);
+		REQUIRE(std::equal(c.begin(), c.end(), expected.begin()));
+
+		auto l = copy_backward(c.begin() + 20, c.begin() + 120, c.begin() + 117);
+		std::copy(
+			expected.begin() + 20, expected.begin() + 120,
+			expected.begin() + 17);
+		REQUIRE(l - c.begin() == 17);
+		REQUIRE(std::equal(c.begin(), c.end(), expected.begin()));
+
+		std::array<uint16_t, 12> other{};
+		auto o = containers::bit_container_adaptor(std::span(other));
+		copy(c.begin(), c.end(), o.begin());
+		REQUIRE(other == a);
+	}
+}
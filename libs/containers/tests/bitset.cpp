@@ -55,3 +55,31 @@ TEST_CASE("Bit set simple tests", "[containers][bitset]")
 
 	}
 }
+
+TEST_CASE("bit set word-level members", "[containers][bitset]")
+{
+	containers::bitset<37> bs;
+	bs.fill(1);
+	REQUIRE(rg::all_of(bs, [](auto&& x){ return x == 1; }));
+	REQUIRE(bs.count(1) == 37);
+	REQUIRE(bs.count(0) == 0);
+	REQUIRE(bs.find(0) == 37);
+
+	bs[3] = 0;
+	bs[30] = 0;
+	REQUIRE(bs.count(0) == 2);
+	REQUIRE(bs.find(0) == 3);
+	REQUIRE(bs.find(1) == 0);
+
+	containers::bitset<37> other;
+	other.fill(2);
+	REQUIRE(other.count(1) == 0);
+	REQUIRE(other.find(1) == 37);
+	REQUIRE(!(bs == other));
+
+	rg::copy(bs, other.begin());
+	REQUIRE(bs == other);
+
+	other[36] = 0;
+	REQUIRE(!(bs == other));
+}
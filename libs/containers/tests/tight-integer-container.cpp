@@ -402,3 +402,54 @@ TEST_CASE("constness", "[tight-integer-container]")
 	rg::copy(rg::vw::iota(0UL, c.size()), c.begin());
 	REQUIRE(check_constness(c));
 }
+
+template<class T>
+void check_fill_and_equality(uint64_t n, typename T::value_type value)
+{
+	T c(n, value);
+	REQUIRE(c.size() == n);
+	REQUIRE(rg::all_of(c, [value](auto&& x){ return x == value; }));
+
+	T other(n);
+	rg::copy(c, other.begin());
+	REQUIRE(c == other);
+
+	if(n > 0){
+		other[n/2] = static_cast<typename T::value_type>(value - 1);
+		REQUIRE(c != other);
+	}
+
+	other.resize(n + 1);
+	REQUIRE(c != other);
+}
+
+TEST_CASE("tight integers fill and equality", "[tight-integers-container]")
+{
+	using signed_t = containers::tight_integer_container<
+		util::signed_integer<5>>;
+	using unsigned_t = containers::tight_integer_container<
+		util::unsigned_integer<13>>;
+
+	for(uint64_t n : { 0, 1, 2, 7, 64, 100, 1001 }){
+		INFO(n);
+		check_fill_and_equality<signed_t>(n, -11);
+		check_fill_and_equality<signed_t>(n, 3);
+		check_fill_and_equality<unsigned_t>(n, 5000);
+	}
+
+	SECTION("fill overwrites the previous values"){
+		unsigned_t c;
+		c.resize(77);
+		rg::copy(rg::vw::iota(0UL, c.size()), c.begin());
+
+		c.fill(42);
+		REQUIRE(rg::all_of(c, [](auto&& x){ return x == 42; }));
+	}
+
+	SECTION("containers of other widths compare their values"){
+		containers::tight_integer_container<util::unsigned_integer<7>>
+			c(9, 100);
+		REQUIRE(c == unsigned_t(9, 100));
+		REQUIRE(c != unsigned_t(9, 101));
+	}
+}
@@ -0,0 +1,165 @@
+/**
+  * compares drawing balls and segments one by one against drawing them
+  * with the instanced batch calls of `ball2d_render` and
+  * `segment2d_render`, reporting the frame times of each
+  *
+  * runs without a GPU with Mesa llvmpipe, as in
+  *
+  *     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ug-graphics-batch-render-benchmark
+  *
+  * usage: ug-graphics-batch-render-benchmark [number of shapes] [frames]
+  */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ug/graphics/app.hpp"
+#include "ug/graphics/ball2d-render.hpp"
+#include "ug/graphics/segment2d-render.hpp"
+
+namespace{
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+  * frames discarded at the start of each mode, while the buffers grow
+  * and the driver compiles the shaders
+  */
+constexpr std::uint64_t warmup_frames = 5;
+
+void report(char const* name, std::vector<double> times)
+{
+	if(times.empty())
+		return;
+
+	std::ranges::sort(times);
+
+	auto mean = 0.0;
+	for(auto t : times)
+		mean += t;
+	mean /= static_cast<double>(times.size());
+
+	auto percentile = [&](double p)
+	{
+		auto const i = static_cast<std::size_t>(
+			p*static_cast<double>(times.size() - 1));
+		return times[i];
+	};
+
+	std::cout << name
+		<< ": mean " << mean
+		<< " ms, median " << percentile(0.5)
+		<< " ms, p95 " << percentile(0.95)
+		<< " ms\n";
+}
+
+class batch_render_benchmark : public ug::graphics::app {
+public:
+	batch_render_benchmark(std::uint64_t n_shapes, std::uint64_t n_frames)
+		: ug::graphics::app(800, 800, "batch render benchmark"),
+		  m_ball_render(this),
+		  m_segment_render(this),
+		  m_n_frames(n_frames)
+	{
+		// the frame time must not be bounded by the refresh rate
+		glfwSwapInterval(0);
+
+		std::mt19937 gen{ 42 };
+		std::uniform_real_distribution<float> position{ 0.f, 800.f };
+		std::uniform_real_distribution<float> radius{ 1.f, 8.f };
+
+		m_balls.reserve(n_shapes);
+		m_segments.reserve(n_shapes);
+
+		for(std::uint64_t i=0; i<n_shapes; ++i){
+			m_balls.push_back({
+				{ position(gen), position(gen) },
+				radius(gen)
+			});
+			m_segments.push_back({
+				{ position(gen), position(gen) },
+				{ position(gen), position(gen) }
+			});
+		}
+	}
+
+	void draw() override
+	{
+		if(m_frame < m_n_frames){
+			for(auto&& b : m_balls)
+				m_ball_render(b);
+			for(auto&& s : m_segments)
+				m_segment_render(s);
+		}else{
+			m_ball_render(m_balls);
+			m_segment_render(m_segments);
+		}
+	}
+
+	void finally() override
+	{
+		auto const now = clock_type::now();
+		std::chrono::duration<double, std::milli> const elapsed =
+			now - m_last_frame;
+		m_last_frame = now;
+
+		auto const frame_in_mode = m_frame % m_n_frames;
+		if(frame_in_mode >= warmup_frames){
+			auto& times = m_frame < m_n_frames ? m_single_times : m_batch_times;
+			times.push_back(elapsed.count());
+		}
+
+		if(++m_frame == 2*m_n_frames)
+			should_close(true);
+	}
+
+	std::vector<double> const& single_times() const
+	{
+		return m_single_times;
+	}
+
+	std::vector<double> const& batch_times() const
+	{
+		return m_batch_times;
+	}
+
+private:
+	ug::graphics::ball2d_render m_ball_render;
+	ug::graphics::segment2d_render m_segment_render;
+
+	std::vector<ug::graphics::ball2d> m_balls;
+	std::vector<ug::graphics::segment2d> m_segments;
+
+	std::uint64_t m_n_frames;
+	std::uint64_t m_frame = 0;
+	clock_type::time_point m_last_frame = clock_type::now();
+
+	std::vector<double> m_single_times;
+	std::vector<double> m_batch_times;
+};
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	std::uint64_t const n_shapes = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 10'000;
+
+	std::uint64_t const n_frames = std::max<std::uint64_t>(
+		argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100,
+		warmup_frames + 1);
+
+	batch_render_benchmark app{ n_shapes, n_frames };
+	app.run();
+
+	std::cout << n_shapes << " balls and " << n_shapes << " segments\n";
+	report("one draw per shape", app.single_times());
+	report("one instanced draw per batch", app.batch_times());
+
+	return EXIT_SUCCESS;
+}
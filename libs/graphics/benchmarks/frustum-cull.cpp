@@ -0,0 +1,130 @@
+/**
+  * measures the culling of cluster boxes against the view frustum on the
+  * CPU, comparing the `cull` lane kernel with `frustum3d::intersects`
+  * called for each box
+  *
+  * it creates no window and needs no GPU; the projection is the
+  * perspective of `app::compute_projection_matrix` for a 16:9 viewport
+  *
+  * usage: ug-graphics-frustum-cull-benchmark [number of boxes] [iterations]
+  */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ug/graphics/bounds3d.hpp"
+#include "ug/graphics/camera.hpp"
+
+namespace{
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::uint64_t warmup_iterations = 3;
+
+void report(char const* name, std::vector<double> times, std::uint64_t n)
+{
+	if(times.empty())
+		return;
+
+	std::ranges::sort(times);
+
+	auto mean = 0.0;
+	for(auto t : times)
+		mean += t;
+	mean /= static_cast<double>(times.size());
+
+	auto percentile = [&](double p)
+	{
+		auto const i = static_cast<std::size_t>(
+			p*static_cast<double>(times.size() - 1));
+		return times[i];
+	};
+
+	std::cout << name
+		<< ": mean " << mean
+		<< " ms, median " << percentile(0.5)
+		<< " ms, p95 " << percentile(0.95)
+		<< " ms, " << static_cast<double>(n)/(percentile(0.5)*1e3)
+		<< " Mboxes/s\n";
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	std::uint64_t const n_boxes = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 1'000'000;
+
+	std::uint64_t const n_iterations = argc > 2
+		? std::strtoull(argv[2], nullptr, 10)
+		: 50;
+
+	std::mt19937 gen{ 42 };
+	std::uniform_real_distribution<float> position{ -100.f, 100.f };
+	std::uniform_real_distribution<float> extent{ .1f, 2.f };
+
+	ug::graphics::aabb3d_array boxes;
+	for(std::uint64_t i=0; i<n_boxes; ++i){
+		glm::vec3 const c{ position(gen), position(gen), position(gen) };
+		glm::vec3 const e{ extent(gen), extent(gen), extent(gen) };
+		boxes.push_back({ c - e, c + e });
+	}
+
+	auto const projection = glm::perspective(
+		glm::radians(45.f), 16.f/9.f, .1f, 100.f);
+
+	std::vector<std::uint8_t> visible(n_boxes);
+	std::vector<double> kernel_times, scalar_times;
+	std::uint64_t n_visible = 0;
+	std::uint64_t checksum = 0;
+
+	for(std::uint64_t it=0; it<n_iterations + warmup_iterations; ++it){
+		// the camera turns around the origin, so the visible set changes
+		auto const angle = static_cast<float>(it)*.1f;
+		ug::graphics::camera const cam{
+			glm::vec3{ 0.f },
+			glm::vec3{ std::cos(angle), 0.f, std::sin(angle) }
+		};
+		ug::graphics::frustum3d const f{ projection*cam.view() };
+
+		auto const t0 = clock_type::now();
+		n_visible = ug::graphics::cull(f, boxes, visible);
+		auto const t1 = clock_type::now();
+
+		for(std::uint64_t i=0; i<n_boxes; ++i){
+			ug::graphics::aabb3d const b{
+				{
+					boxes.center_x[i] - boxes.extent_x[i],
+					boxes.center_y[i] - boxes.extent_y[i],
+					boxes.center_z[i] - boxes.extent_z[i]
+				},
+				{
+					boxes.center_x[i] + boxes.extent_x[i],
+					boxes.center_y[i] + boxes.extent_y[i],
+					boxes.center_z[i] + boxes.extent_z[i]
+				}
+			};
+			checksum += f.intersects(b);
+		}
+		auto const t2 = clock_type::now();
+
+		if(it >= warmup_iterations){
+			std::chrono::duration<double, std::milli> const kernel = t1 - t0;
+			std::chrono::duration<double, std::milli> const scalar = t2 - t1;
+			kernel_times.push_back(kernel.count());
+			scalar_times.push_back(scalar.count());
+		}
+	}
+
+	std::cout << n_boxes << " boxes, " << n_visible
+		<< " visible in the last frame (checksum " << checksum << ")\n";
+	report("cull kernel", kernel_times, n_boxes);
+	report("frustum3d::intersects per box", scalar_times, n_boxes);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/**
+  * draws a sphere with `mesh3d_render` for a fixed number of frames in an
+  * offscreen app, writing the time of each frame as CSV and, optionally,
+  * the frames as PPM images
+  *
+  * the window is hidden and the frames are drawn to a framebuffer object,
+  * so it runs on a machine without a GPU with Mesa llvmpipe, as in
+  *
+  *     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ug-graphics-offscreen-render-benchmark
+  *
+  * the camera turns at a fixed step per frame, so two runs draw the same
+  * images
+  *
+  * usage: ug-graphics-offscreen-render-benchmark
+  *            [frames] [sphere subdivisions] [image directory]
+  */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+#include "ug/graphics/app3d.hpp"
+#include "ug/graphics/light3d.hpp"
+#include "ug/graphics/mesh3d-render.hpp"
+
+namespace{
+
+/**
+  * the triangle soup of a sphere of radius 1 with `n` rings of `n`
+  * quads
+  */
+std::vector<ug::graphics::mesh3d_attributes_layout> make_sphere(
+	std::uint64_t n)
+{
+	auto vertex = [&](std::uint64_t i, std::uint64_t j)
+	{
+		auto const theta = std::numbers::pi_v<float>
+			*static_cast<float>(i)/static_cast<float>(n);
+		auto const phi = 2.f*std::numbers::pi_v<float>
+			*static_cast<float>(j % n)/static_cast<float>(n);
+
+		glm::vec3 const p{
+			std::sin(theta)*std::cos(phi),
+			std::cos(theta),
+			std::sin(theta)*std::sin(phi)
+		};
+
+		return ug::graphics::mesh3d_attributes_layout{
+			p,
+			p,
+			{ .5f + .5f*p.x, .5f + .5f*p.y, .5f + .5f*p.z, 1.f }
+		};
+	};
+
+	std::vector<ug::graphics::mesh3d_attributes_layout> soup;
+	soup.reserve(6*n*n);
+	for(std::uint64_t i=0; i<n; ++i){
+		for(std::uint64_t j=0; j<n; ++j){
+			auto const a = vertex(i, j);
+			auto const b = vertex(i + 1, j);
+			auto const c = vertex(i + 1, j + 1);
+			auto const d = vertex(i, j + 1);
+			soup.insert(soup.end(), { a, b, c, a, c, d });
+		}
+	}
+
+	return soup;
+}
+
+class offscreen_render_benchmark : public ug::graphics::app3d {
+public:
+	explicit offscreen_render_benchmark(std::uint64_t subdivisions)
+		: ug::graphics::app3d(
+			1280,
+			720,
+			"offscreen render benchmark",
+			projection_type::PERSPECTIVE,
+			ug::graphics::window_visibility::HIDDEN),
+		  m_render(this),
+		  m_mesh(make_sphere(subdivisions))
+	{
+		set_clear_color(.1f, .1f, .1f, 1.f);
+	}
+
+	void update() override
+	{
+		// the camera looks at the sphere from a circle around it
+		m_angle += static_cast<float>(get_delta())*.5f;
+		glm::vec3 const position{
+			3.f*std::cos(m_angle),
+			1.5f,
+			3.f*std::sin(m_angle)
+		};
+		get_camera() = ug::graphics::camera{
+			position,
+			glm::normalize(-position)
+		};
+	}
+
+	void draw() override
+	{
+		m_render(get_camera(), m_lights, m_mesh);
+	}
+
+private:
+	ug::graphics::mesh3d_render m_render;
+	ug::graphics::mesh3d m_mesh;
+	std::vector<ug::graphics::light3d> m_lights{
+		{ { 4.f, 4.f, 4.f }, { 1.f, 1.f, 1.f } }
+	};
+	float m_angle = 0.f;
+};
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	ug::graphics::app::frame_run_options options;
+	options.n_frames = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 300;
+
+	std::uint64_t const subdivisions = argc > 2
+		? std::max<std::uint64_t>(std::strtoull(argv[2], nullptr, 10), 3)
+		: 512;
+
+	if(argc > 3)
+		options.image_directory = argv[3];
+
+	offscreen_render_benchmark app{ subdivisions };
+	auto const timings = app.run_frames(options);
+
+	timings.write_csv(std::cout);
+
+	return EXIT_SUCCESS;
+}
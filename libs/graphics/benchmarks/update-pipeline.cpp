@@ -0,0 +1,182 @@
+/**
+  * compares the frame times of an offscreen app whose components spend
+  * CPU time in `update`, first updated on the thread of the context and
+  * then by the update pipeline while the frame is drawn
+  *
+  * runs without a GPU with Mesa llvmpipe, as in
+  *
+  *     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ug-graphics-update-pipeline-benchmark
+  *
+  * usage: ug-graphics-update-pipeline-benchmark
+  *            [components] [particles per component] [frames]
+  */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ug/graphics/app2d.hpp"
+#include "ug/graphics/ball2d-render.hpp"
+
+namespace{
+
+/**
+  * frames discarded at the start of each mode, while the threads start
+  * and the driver compiles the shaders
+  */
+constexpr std::uint64_t warmup_frames = 5;
+
+void report(char const* name, std::vector<double> times)
+{
+	times.erase(
+		times.begin(),
+		times.begin() + static_cast<std::ptrdiff_t>(
+			std::min<std::uint64_t>(warmup_frames, times.size())));
+
+	if(times.empty())
+		return;
+
+	std::ranges::sort(times);
+
+	auto mean = 0.0;
+	for(auto t : times)
+		mean += t;
+	mean /= static_cast<double>(times.size());
+
+	auto percentile = [&](double p)
+	{
+		auto const i = static_cast<std::size_t>(
+			p*static_cast<double>(times.size() - 1));
+		return times[i];
+	};
+
+	std::cout << name
+		<< ": mean " << mean*1e3
+		<< " ms, median " << percentile(0.5)*1e3
+		<< " ms, p95 " << percentile(0.95)*1e3
+		<< " ms\n";
+}
+
+/**
+  * particles bouncing in a box, integrated in `update` and copied to the
+  * drawn balls in `finally`, so `update` never touches what is drawn
+  */
+class particles : public ug::graphics::component {
+public:
+	particles(ug::graphics::app* a, std::uint64_t n, std::uint64_t seed)
+		: component(a),
+		  m_render(a)
+	{
+		std::mt19937 gen{ seed };
+		std::uniform_real_distribution<float> position{ 0.f, 800.f };
+		std::uniform_real_distribution<float> velocity{ -100.f, 100.f };
+
+		m_positions.resize(n);
+		m_velocities.resize(n);
+		for(std::uint64_t i=0; i<n; ++i){
+			m_positions[i] = { position(gen), position(gen) };
+			m_velocities[i] = { velocity(gen), velocity(gen) };
+		}
+		publish();
+	}
+
+	void update() override
+	{
+		auto const dt = static_cast<float>(m_app->get_delta());
+
+		// a few substeps, so each update costs a noticeable CPU time
+		for(int substep=0; substep<8; ++substep){
+			for(std::uint64_t i=0; i<m_positions.size(); ++i){
+				auto& p = m_positions[i];
+				auto& v = m_velocities[i];
+				v.y -= 9.8f*dt/8.f;
+				p += v*(dt/8.f);
+				for(int k=0; k<2; ++k){
+					if(p[k] < 0.f || p[k] > 800.f){
+						v[k] = -v[k];
+						p[k] = std::clamp(p[k], 0.f, 800.f);
+					}
+				}
+			}
+		}
+	}
+
+	bool is_parallel_safe() const override
+	{
+		return true;
+	}
+
+	void finally() override
+	{
+		publish();
+	}
+
+	void draw() override
+	{
+		m_render(m_balls);
+	}
+
+private:
+	void publish()
+	{
+		m_balls.resize(m_positions.size());
+		for(std::uint64_t i=0; i<m_positions.size(); ++i)
+			m_balls[i] = { m_positions[i], 1.f };
+	}
+
+	ug::graphics::ball2d_render m_render;
+	std::vector<glm::vec2> m_positions;
+	std::vector<glm::vec2> m_velocities;
+	std::vector<ug::graphics::ball2d> m_balls;
+};
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	std::uint64_t const n_components = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 8;
+
+	std::uint64_t const n_particles = argc > 2
+		? std::strtoull(argv[2], nullptr, 10)
+		: 100'000;
+
+	ug::graphics::app::frame_run_options options;
+	options.n_frames = std::max<std::uint64_t>(
+		argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100,
+		warmup_frames + 1);
+
+	ug::graphics::app2d app{
+		800,
+		800,
+		"update pipeline benchmark",
+		ug::graphics::window_visibility::HIDDEN
+	};
+
+	std::vector<std::shared_ptr<particles>> components;
+	for(std::uint64_t i=0; i<n_components; ++i){
+		components.push_back(
+			std::make_shared<particles>(&app, n_particles, i));
+		app.add_component(components.back());
+	}
+
+	auto const n_threads = app.get_update_threads();
+
+	app.set_update_threads(0);
+	auto const serial = app.run_frames(options);
+
+	app.set_update_threads(std::max<std::uint64_t>(n_threads, 1));
+	auto const pipelined = app.run_frames(options);
+
+	std::cout << n_components << " components of " << n_particles
+		<< " particles, " << app.get_update_threads()
+		<< " update threads\n";
+	report("updated on the context thread", serial.frame);
+	report("updated by the pipeline", pipelined.frame);
+
+	return EXIT_SUCCESS;
+}
@@ -1,20 +1,27 @@
 #pragma once
 
+#include <algorithm>
 #include <string_view>
 #include <unordered_map>
 #include <filesystem>
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
 
 #include <boost/gil.hpp>
 
 #include "ug/graphics/misc.hpp"
+#include "ug/graphics/buffers.hpp"
 #include "ug/graphics/window.hpp"
 #include "ug/graphics/component-manager.hpp"
 #include "ug/graphics/camera.hpp"
+#include "ug/graphics/frame-capture.hpp"
+#include "ug/graphics/framebuffer.hpp"
+#include "ug/graphics/update-pipeline.hpp"
 
 namespace ug::graphics{
 
@@ -34,11 +41,74 @@ public:
 		PERSPECTIVE
 	};
 
+	/**
+	  * the view and the projection matrices of the frame, uploaded once
+	  * per frame to a uniform buffer bound to `camera_uniform_binding`;
+	  * the layout is the std140 layout of `camera_uniform_block`
+	  */
+	struct camera_uniforms{
+		glm::mat4 view;
+		glm::mat4 projection;
+	};
+
+	static constexpr uint32_t camera_uniform_binding = 0;
+
+	/**
+	  * the declaration of the camera uniform block, to be placed after
+	  * the `#version` line of the shaders that use it; the program must
+	  * bind it with `program::set_uniform_block_binding`
+	  */
+	static constexpr char const* camera_uniform_block = R"__(
+layout (std140) uniform ug_camera{
+	mat4 view;
+	mat4 projection;
+} camera;
+)__";
+
+	/**
+	  * options of `run_frames`
+	  */
+	struct frame_run_options{
+		uint64_t n_frames = 60;
+
+		/**
+		  * the time between two frames returned by `get_delta`, fixed so
+		  * the frames do not depend on the speed of the machine
+		  */
+		double delta = 1./60.;
+
+		/**
+		  * if not empty, the frames are written to it as
+		  * `frame-<number>.ppm`
+		  */
+		std::filesystem::path image_directory;
+	};
+
+	/**
+	  * the durations of the frames of `run_frames`, in seconds; `draw`
+	  * includes waiting for the GPU to finish the frame
+	  */
+	struct frame_timings{
+		std::vector<double> update;
+		std::vector<double> draw;
+		std::vector<double> frame;
+
+		/**
+		  * writes a header and a row per frame
+		  */
+		void write_csv(std::ostream& out) const;
+	};
+
+	/**
+	  * with `window_visibility::HIDDEN` the window is never shown and the
+	  * frames are drawn to a framebuffer object of `width` x `height`
+	  */
 	explicit app(
 		int32_t width,
 		int32_t height,
 		char const* window_title,
-		app::projection_type proj_type = app::projection_type::ORTHOGRAPHIC
+		app::projection_type proj_type = app::projection_type::ORTHOGRAPHIC,
+		window_visibility visibility = window_visibility::SHOWN
 	);
 
 	virtual ~app();
@@ -62,14 +132,57 @@ public:
 	ug::graphics::camera const& get_camera() const;
 	ug::graphics::camera& get_camera();
 
+	/**
+	  * the time of the updates of the frame, the fixed step if there is
+	  * one, otherwise the time since the previous frame
+	  */
 	double get_delta() const;
 
+	/**
+	  * makes `run` update with a fixed time step: the time of the frames
+	  * is accumulated and the updates run once per whole step in it, up
+	  * to `max_steps_per_frame` per frame; 0 updates once per frame
+	  */
+	void set_fixed_step(double step);
+	double get_fixed_step() const;
+
+	static constexpr uint64_t max_steps_per_frame = 8;
+
+	/**
+	  * the fraction of a fixed step left in the accumulator after the
+	  * updates of the frame, to interpolate between the last two states
+	  * when drawing; 0 without a fixed step
+	  */
+	double get_interpolation() const;
+
+	/**
+	  * the number of threads that update the parallel-safe components
+	  * while the thread of the context draws, see
+	  * `component::is_parallel_safe`; with 0 they are updated with the
+	  * other components
+	  */
+	void set_update_threads(uint64_t n_threads);
+	uint64_t get_update_threads() const;
+
 	virtual void on_drop_path(path_input const& path) override;
 	virtual void on_key_input(key_input const& input) override;
 	virtual void on_scroll_input(scroll_input const& input) override;
 
 	virtual int32_t run();
 
+	/**
+	  * draws `options.n_frames` frames as `run` does, without the ui and
+	  * the events, and waits for the GPU after each one; the capture
+	  * started by `start_capture` is replaced if images are written
+	  */
+	frame_timings run_frames(frame_run_options const& options);
+
+	/**
+	  * whether the frames are drawn to a framebuffer object instead of
+	  * the window
+	  */
+	bool is_offscreen() const;
+
 	virtual void update();
 	virtual void draw();
 	virtual void finally();
@@ -107,6 +220,17 @@ public:
 	glm::mat4 get_view_matrix() const;
 	[[nodiscard]] glm::mat4 compute_projection_matrix() const;
 
+	/**
+	  * the camera matrices of the current frame, without recomputing them
+	  */
+	camera_uniforms const& get_camera_uniforms() const;
+
+	/**
+	  * recomputes the camera matrices and uploads them to the camera
+	  * uniform buffer; `run` calls it after the update of every frame
+	  */
+	void update_camera_uniforms();
+
 	/**
 	 * zoom
 	 * @param	proportion proportion of the zoom,
@@ -120,8 +244,34 @@ public:
 	bool ui_want_capture_mouse() const;
 	bool ui_want_capture_keyboard() const;
 
+	/**
+	  * reads the viewport and waits for the GPU; `start_capture` reads
+	  * the frames without waiting
+	  */
 	gil::rgb8_image_t get_current_frame_image() const;
 
+	/**
+	  * captures the viewport of every frame drawn by `run` after
+	  * `draw_all`, so without the ui, and hands the frames to `writer` on
+	  * a background thread; see `frame_capture`
+	  */
+	void start_capture(
+		frame_capture::writer_function writer,
+		uint64_t queue_capacity = frame_capture::default_queue_capacity,
+		frame_capture::overflow_policy overflow =
+			frame_capture::overflow_policy::DROP);
+
+	/**
+	  * waits for the frames still pending to be written
+	  * @return the statistics of the capture
+	  */
+	frame_capture_stats stop_capture();
+
+	/**
+	  * the statistics of the current capture, if there is one
+	  */
+	std::optional<frame_capture_stats> capture_stats() const;
+
 	struct ui_window_view_t{
 	private:
 
@@ -181,18 +331,23 @@ protected:
 	void update_time();
 	void update_cached_data();
 
-	struct heterogeneous_string_hash {
-		using is_transparent = void;
-		[[nodiscard]] size_t operator()(char const* txt) const {
-			return std::hash<std::string_view>{}(txt);
-		}
-		[[nodiscard]] size_t operator()(std::string_view txt) const {
-			return std::hash<std::string_view>{}(txt);
-		}
-		[[nodiscard]] size_t operator()(std::string const& txt) const {
-			return std::hash<std::string>{}(txt);
-		}
-	};
+	/**
+	  * updates the time and the accumulator of the fixed step
+	  * @return the number of updates of the frame
+	  */
+	uint64_t advance_time();
+
+	/**
+	  * runs `n_steps` times `update` and the updates of the components
+	  * that are not parallel-safe, then launches the updates of the
+	  * parallel-safe ones on the update pipeline
+	  */
+	void begin_updates(uint64_t n_steps);
+
+	/**
+	  * waits for the updates launched by `begin_updates`
+	  */
+	void end_updates();
 
 	using enabled_views_t = std::unordered_map<
 		std::string,
@@ -204,9 +359,22 @@ protected:
 	component_manager m_component_manager;
 	enabled_views_t m_enabled_views;
 	ug::graphics::camera m_camera;
+	camera_uniforms m_camera_uniforms{};
+	std::optional<ubo> m_camera_ubo;
+	std::optional<frame_capture> m_frame_capture;
+	std::optional<framebuffer> m_offscreen;
 	rect2d m_viewport{ {0, 0}, 0, 0 };
 	double m_last_time{ get_time() };
 	double m_delta{ 0.0 };
+	double m_fixed_step{ 0.0 };
+	double m_accumulator{ 0.0 };
+	double m_interpolation{ 0.0 };
+	uint64_t m_update_threads =
+		std::max(1U, std::thread::hardware_concurrency()) - 1;
+	std::optional<update_pipeline> m_update_pipeline;
+	std::vector<std::shared_ptr<component>> m_serial_components;
+	std::vector<std::shared_ptr<component>> m_parallel_components;
+	bool m_updates_launched = false;
 	GLbitfield m_clear_flags = GL_COLOR_BUFFER_BIT;
 	float m_zoom{ 1.0 };
 	bool m_enable_menu_bar = true;
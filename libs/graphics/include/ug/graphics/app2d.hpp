@@ -17,7 +17,11 @@ public:
 		GLFW_KEY_ESCAPE
 	};
 
-	app2d(int width, int height, char const* title);
+	app2d(
+		int width,
+		int height,
+		char const* title,
+		window_visibility visibility = window_visibility::SHOWN);
 	app2d(char const* title);
 
 	virtual ~app2d() = default;
@@ -14,7 +14,8 @@ public:
 		int32_t width,
 		int32_t height,
 		char const* window_title,
-		projection_type proj_type = projection_type::PERSPECTIVE
+		projection_type proj_type = projection_type::PERSPECTIVE,
+		window_visibility visibility = window_visibility::SHOWN
 	);
 
 	virtual ~app3d() = default;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <string_view>
 
 #include "ug/graphics/misc.hpp"
@@ -17,6 +18,11 @@ struct ball2d {
 	float r = 0.f;
 };
 
+static_assert(
+	sizeof(ball2d) == 3*sizeof(float),
+	"ball2d is uploaded as the instance attributes of ball2d_render"
+);
+
 class ball2d_render : public render{
 public:
 
@@ -28,10 +34,19 @@ public:
 	  */
 	void operator()(ball2d const& b);
 
+	/**
+	  * renders all the `balls` with one instanced draw call
+	  */
+	void operator()(std::span<ball2d const> balls);
+
 	void set_boundary_color(graphics::color4 const& c);
 	void set_fill_color(graphics::color4 const& c);
 	void set_draw_boundary(bool b);
 	void set_draw_fill(bool b);
+
+	/**
+	  * the thickness of the boundary, in pixels
+	  */
 	void set_thick(float t);
 protected:
 
@@ -40,9 +55,16 @@ protected:
 
 	program m_program;
 
-	vao m_vscr_vao;
-	vbo m_vscr_vbo;
-	ebo m_vscr_ebo;
+	struct{
+		uniform<color4> color;
+		uniform<color4> boundary_color;
+		uniform<bool> draw_boundary;
+		uniform<bool> draw_fill;
+		uniform<float> boundary_thick;
+	} m_uniforms;
+
+	vao m_vao;
+	dynamic_buffer m_instances{ GL_ARRAY_BUFFER };
 
 	color4 m_fill_color = { 1.0, 1.0, 1.0, 1.0 };
 
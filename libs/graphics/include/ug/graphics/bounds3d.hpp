@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ug/graphics/misc.hpp"
+
+namespace ug::graphics{
+
+/**
+  * the largest length of the axes of `m`, how much `m` scales distances
+  * at most when its axes are orthogonal
+  */
+float max_axis_scale(glm::mat4 const& m);
+
+/**
+  * axis aligned bounding box
+  */
+struct aabb3d{
+	glm::vec3 min;
+	glm::vec3 max;
+
+	glm::vec3 center() const;
+
+	/**
+	  * the half of the size along each axis
+	  */
+	glm::vec3 extent() const;
+
+	/**
+	  * the box of the points of `points`, which must not be empty
+	  */
+	static aabb3d from_points(std::span<glm::vec3 const> points);
+
+	/**
+	  * the smallest box that holds the box transformed by `m`
+	  */
+	aabb3d transformed(glm::mat4 const& m) const;
+};
+
+struct sphere3d{
+	glm::vec3 center;
+	float radius;
+
+	/**
+	  * a sphere that holds the sphere transformed by `m`, its radius is
+	  * scaled by the largest scale of `m`
+	  */
+	sphere3d transformed(glm::mat4 const& m) const;
+};
+
+/**
+  * boxes stored as arrays of their components, as read by the culling
+  * kernel
+  */
+struct aabb3d_array{
+	std::vector<float> center_x, center_y, center_z;
+	std::vector<float> extent_x, extent_y, extent_z;
+
+	uint64_t size() const noexcept
+	{
+		return center_x.size();
+	}
+
+	void push_back(aabb3d const& b);
+};
+
+/**
+  * the 6 planes of the clipping volume of a matrix, a point `p` is inside
+  * if `dot(plane, vec4(p, 1)) >= 0` for every plane
+  *
+  * built from `projection*view`, the planes are in world space, and
+  * from `projection*view*model`, in the space of the model
+  */
+struct frustum3d{
+	explicit frustum3d(glm::mat4 const& clip);
+
+	bool intersects(aabb3d const& b) const;
+	bool intersects(sphere3d const& s) const;
+
+	/**
+	  * left, right, bottom, top, near and far, normalized
+	  */
+	std::array<glm::vec4, 6> planes;
+};
+
+/**
+  * sets `visible[i]` to 1 if the box `i` intersects `f` and to 0
+  * otherwise, with a lane loop over the boxes that the compiler
+  * vectorizes
+  *
+  * boxes near the corners of the frustum can be kept even though they
+  * are outside, as with every plane by plane test
+  *
+  * @return the number of visible boxes
+  */
+uint64_t cull(
+	frustum3d const& f,
+	aabb3d_array const& boxes,
+	std::span<uint8_t> visible);
+
+} // end of namespace ug::graphics
@@ -1,7 +1,11 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include "ug/graphics/opengl-error.hpp"
 
@@ -51,6 +55,25 @@ public:
 		set_data(rgs::cdata(r), rgs::size(r), usage);
 	}
 
+	/**
+	  * overwrites part of the buffer data, without reallocating it
+	  *
+	  * @param offset	the offset in bytes of the first byte to write
+	  * @param ptr	the pointer to `size` elements of `T`
+	  * @param size	is the number of `T`-elements pointed by `ptr`
+	  */
+	template<class T>
+	void set_sub_data(int64_t offset, T const* ptr, size_t size) const
+	{
+		bind();
+		GL(glBufferSubData(
+			m_target,
+			offset,
+			static_cast<int64_t>(size*sizeof(T)),
+			ptr
+		));
+	}
+
 	uint32_t id() const;
 
 protected:
@@ -71,10 +94,125 @@ public:
 	{} 
 };
 
+/**
+  * uniform buffer object, read by the uniform blocks of the programs
+  * bound to the same binding point
+  */
+class ubo : public buffer {
+public:
+	ubo() : buffer(GL_UNIFORM_BUFFER)
+	{}
+
+	/**
+	  * binds the whole buffer to the uniform buffer binding point
+	  * `binding`
+	  */
+	void bind_base(uint32_t binding) const
+	{
+		GL(glBindBufferBase(m_target, binding, m_id));
+	}
+};
+
 class tdb : public buffer {
 public:
 	tdb() : buffer(GL_TEXTURE_BUFFER)
 	{} 
 };
 
+/**
+  * pixel buffer object, the destination of the reads of the framebuffer
+  * with `glReadPixels` that return without waiting for the GPU
+  */
+class pbo : public buffer {
+public:
+	pbo() : buffer(GL_PIXEL_PACK_BUFFER)
+	{}
+};
+
+/**
+  * a buffer for data that is written every frame, such as instance
+  * attributes, allocated once and used as a ring
+  *
+  * each write gets a window in the next free range of the ring, so the
+  * storage is never reallocated while the GPU reads the previous writes
+  *
+  * with OpenGL 4.4 the storage is mapped once with `glBufferStorage` and
+  * the windows point to it; the ring is then split in `n_sections` and,
+  * before a section is reused, the writer waits for the fence placed
+  * after the draws that read it
+  *
+  * otherwise the windows point to a staging copy that `commit` sends
+  * with `glBufferSubData`, which the driver orders with the draws, so no
+  * fence is placed
+  */
+class dynamic_buffer : public buffer {
+public:
+	static constexpr uint32_t n_sections = 4;
+
+	/**
+	  * @param target	the target of the buffer, e.g. `GL_ARRAY_BUFFER`
+	  * @param capacity	the initial capacity in bytes; the buffer grows
+	  *			when a write does not fit in a section
+	  */
+	explicit dynamic_buffer(uint32_t target, uint64_t capacity = 1 << 20);
+	virtual ~dynamic_buffer();
+
+	dynamic_buffer(dynamic_buffer&&) = delete;
+	dynamic_buffer& operator=(dynamic_buffer&&) = delete;
+
+	/**
+	  * a window for `n` elements of `T`, valid until `commit`; the
+	  * buffer may be replaced by a larger one, so the vertex layouts
+	  * must be set after the commit
+	  */
+	template<class T>
+	std::span<T> write(std::size_t n)
+	{
+		auto const window = reserve(n*sizeof(T), alignof(T));
+		return { reinterpret_cast<T*>(window), n };
+	}
+
+	/**
+	  * writes a copy of `values`
+	  * @return the offset in bytes of the copy in the buffer
+	  */
+	template<rgs::contiguous_range R>
+	uint64_t write_and_commit(R const& values)
+	{
+		using value_type = rgs::range_value_t<R>;
+		rgs::copy(values, write<value_type>(rgs::size(values)).begin());
+		return commit();
+	}
+
+	/**
+	  * makes the last window visible to the draws issued after it
+	  * @return the offset in bytes of the window in the buffer
+	  */
+	uint64_t commit();
+
+	uint64_t capacity() const;
+
+	/**
+	  * whether the windows are mapped to the buffer storage
+	  */
+	bool is_persistent() const;
+
+protected:
+	std::byte* reserve(uint64_t size, uint64_t alignment);
+
+	void allocate(uint64_t capacity);
+	void release();
+	void enter_section(uint64_t section);
+
+	uint64_t m_capacity = 0;
+	uint64_t m_head = 0;
+	uint64_t m_section = 0;
+	uint64_t m_window_offset = 0;
+	uint64_t m_window_size = 0;
+	bool m_persistent;
+	std::byte* m_mapped = nullptr;
+	std::vector<std::byte> m_staging;
+	std::array<GLsync, n_sections> m_fences{};
+};
+
 } // end of namespace ug::graphics
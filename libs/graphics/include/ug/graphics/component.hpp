@@ -19,6 +19,18 @@ public:
 	virtual app const* get_app() const;
 
 	virtual void update();
+
+	/**
+	  * whether `update` can run on a worker thread while the previous
+	  * frame is drawn, `false` by default
+	  *
+	  * then `update` must not call OpenGL nor change what `draw` and
+	  * `draw_ui` read, of this or of another component; it can publish
+	  * its results in `finally`, called on the thread of the OpenGL
+	  * context once the update is done
+	  */
+	virtual bool is_parallel_safe() const;
+
 	virtual void draw();
 	virtual void draw_ui();
 	virtual void finally();
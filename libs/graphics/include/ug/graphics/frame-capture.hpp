@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <boost/gil.hpp>
+
+#include "ug/graphics/buffers.hpp"
+#include "ug/graphics/misc.hpp"
+
+namespace ug::graphics{
+
+namespace gil = boost::gil;
+
+/**
+  * a frame read from the framebuffer, with its first row at the top
+  */
+struct captured_frame{
+	gil::rgb8_image_t image;
+
+	/**
+	  * the number of the capture, the dropped frames are counted too
+	  */
+	uint64_t number;
+
+	std::chrono::steady_clock::time_point capture_time;
+};
+
+struct frame_capture_stats{
+	/**
+	  * the calls to `capture`, the dropped frames included
+	  */
+	uint64_t captured = 0;
+	uint64_t written = 0;
+
+	/**
+	  * frames dropped because every pixel buffer was still read by the
+	  * GPU or because the queue to the writer was full
+	  */
+	uint64_t dropped = 0;
+
+	/**
+	  * frames handed over to the writer function that threw, they are
+	  * not counted as written
+	  */
+	uint64_t failed = 0;
+
+	/**
+	  * the time from the capture of a frame to its hand over to the
+	  * writer, in seconds, over the written and the failed frames
+	  */
+	double mean_latency = 0.;
+	double max_latency = 0.;
+};
+
+/**
+  * captures frames without stalling the pipeline
+  *
+  * `capture` starts reading the framebuffer into the next pixel buffer of
+  * a ring and places a fence after the read; once the GPU passes the
+  * fence, the pixel buffer is mapped and copied, flipped, to an image
+  * that is queued to a writer thread
+  *
+  * with `overflow_policy::DROP` nothing waits: a frame is dropped if
+  * every pixel buffer is still read by the GPU or if the queue to the
+  * writer is full; with `overflow_policy::WAIT` the capture waits
+  * instead, so no frame is lost
+  *
+  * the methods must be called from the thread of the OpenGL context,
+  * `writer` is called from the writer thread; the first exception it
+  * throws is rethrown by `flush`
+  *
+  * the constructor throws `std::invalid_argument` if `queue_capacity` is 0,
+  * as no frame could ever be queued
+  */
+class frame_capture{
+public:
+	using writer_function = std::function<void(captured_frame&&)>;
+
+	enum class overflow_policy : int8_t {
+		DROP,
+		WAIT
+	};
+
+	static constexpr uint32_t n_pixel_buffers = 3;
+	static constexpr uint64_t default_queue_capacity = 8;
+
+	explicit frame_capture(
+		writer_function writer,
+		uint64_t queue_capacity = default_queue_capacity,
+		overflow_policy overflow = overflow_policy::DROP);
+
+	frame_capture(frame_capture const&) = delete;
+	frame_capture& operator=(frame_capture const&) = delete;
+
+	/**
+	  * the reads still pending on the GPU are lost, the queued frames are
+	  * written before it returns
+	  */
+	~frame_capture();
+
+	/**
+	  * starts reading `viewport` of the read framebuffer, after queueing
+	  * the frames whose reads are finished
+	  */
+	void capture(rect2d const& viewport);
+
+	/**
+	  * queues the frames whose reads are finished, without waiting
+	  */
+	void poll();
+
+	/**
+	  * waits for the pending reads and until the writer has written every
+	  * queued frame, then rethrows the exception of the writer, if any
+	  */
+	void flush();
+
+	frame_capture_stats stats() const;
+
+private:
+	struct pixel_read{
+		pbo buffer;
+		GLsync fence = nullptr;
+		uint64_t capacity = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint64_t number = 0;
+		std::chrono::steady_clock::time_point capture_time;
+	};
+
+	void wait_and_collect_oldest();
+	void collect(pixel_read& read);
+	void queue(captured_frame&& frame);
+	void write_frames(std::stop_token stop);
+
+	std::array<pixel_read, n_pixel_buffers> m_reads;
+	uint64_t m_oldest_read = 0;
+	uint64_t m_n_pending_reads = 0;
+	uint64_t m_next_number = 0;
+
+	writer_function m_writer_function;
+	uint64_t m_queue_capacity;
+	overflow_policy m_overflow;
+	std::deque<captured_frame> m_queue;
+	bool m_writing = false;
+	double m_total_latency = 0.;
+	std::exception_ptr m_writer_error;
+	frame_capture_stats m_stats;
+	mutable std::mutex m_mutex;
+	std::condition_variable_any m_changed;
+
+	// the last member, so the thread stops before the queue is destroyed
+	std::jthread m_writer;
+};
+
+/**
+  * writes `image` as a binary PPM, a format that needs no library;
+  * throws `std::runtime_error` if the file cannot be written
+  */
+void write_ppm(
+	std::filesystem::path const& path,
+	gil::rgb8_image_t const& image);
+
+} // end of namespace ug::graphics
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ug/graphics/misc.hpp"
+
+namespace ug::graphics{
+
+/**
+  * framebuffer object with a color and a depth-stencil renderbuffer of a
+  * fixed size, the target of the offscreen rendering
+  */
+class framebuffer{
+public:
+	/**
+	  * throws `std::runtime_error` if the framebuffer is not complete
+	  */
+	framebuffer(int32_t width, int32_t height);
+	~framebuffer();
+
+	framebuffer(framebuffer const&) = delete;
+	framebuffer& operator=(framebuffer const&) = delete;
+
+	/**
+	  * binds it as the draw and the read framebuffer
+	  */
+	void bind() const;
+
+	uint32_t id() const;
+	int32_t width() const;
+	int32_t height() const;
+
+private:
+	uint32_t m_id;
+	uint32_t m_color;
+	uint32_t m_depth_stencil;
+	int32_t m_width;
+	int32_t m_height;
+};
+
+} // end of namespace ug::graphics
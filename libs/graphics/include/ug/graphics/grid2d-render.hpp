@@ -32,7 +32,7 @@ protected:
 	program m_program;
 
 	vao m_vscr_vao;
-	vbo m_vscr_vbo;
+	dynamic_buffer m_vscr_vbo{ GL_ARRAY_BUFFER };
 	ebo m_vscr_ebo;
 
 	color4 m_grid_color = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "ug/graphics/mesh3d.hpp"
+
+/**
+  * @file mesh3d-lod.hpp levels of detail of a `mesh3d`
+  *
+  * the levels are built by collapsing edges to one of their vertices in
+  * the order of the quadric error metric of Garland and Heckbert, so
+  * every level indexes the vertices of the complete mesh
+  *
+  * each level is split in clusters that are simplified in parallel; the
+  * vertices on the boundary of a cluster are not moved, so the clusters
+  * stay connected, and since the clusters of the next level are built
+  * again the boundaries are simplified by the next levels
+  */
+
+namespace ug::graphics{
+
+struct mesh3d_lod_options{
+	/**
+	  * the fraction of the triangles of a level kept by the next one, in
+	  * (0, 1)
+	  */
+	float reduction = .5f;
+
+	/**
+	  * no level is built from a level with less triangles
+	  */
+	uint64_t min_triangles = 1024;
+
+	/**
+	  * the number of levels, the complete mesh included
+	  */
+	uint64_t max_levels = 8;
+
+	/**
+	  * the number of triangles of the clusters simplified in parallel
+	  */
+	uint32_t cluster_triangles = 4096;
+
+	/**
+	  * the number of threads that simplify the clusters, at least 1, the
+	  * calling thread included
+	  */
+	uint64_t threads = std::max(1U, std::thread::hardware_concurrency());
+};
+
+/**
+  * collapses edges of the triangles of `indices` until at most
+  * `target_triangles` are left or no edge can be collapsed; the vertices
+  * of the edges used by one triangle, the border of `indices`, are not
+  * moved
+  *
+  * @return the triangles left and the largest error of a collapse, which
+  *         bounds the distance from the moved vertex to the planes of its
+  *         triangles
+  */
+mesh3d_lod_level simplify(
+	std::span<mesh3d_attributes_layout const> vertices,
+	std::span<uint32_t const> indices,
+	uint64_t target_triangles);
+
+/**
+  * welds the triangle soup `attributes`, 3 vertices per triangle, and
+  * builds its levels of detail
+  *
+  * throws `std::invalid_argument` if the reduction or the number of
+  * threads of `options` is out of range; an exception thrown while a
+  * cluster is simplified is rethrown on the calling thread
+  */
+mesh3d_lod_chain make_lod_chain(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options = {});
+
+/**
+  * as `make_lod_chain` but reads the chain from `cache` if it was written
+  * for the same attributes and options, otherwise the chain is built and
+  * written to `cache`, so it can be built offline
+  *
+  * the number of threads does not change the key of the cache
+  */
+mesh3d_lod_chain make_lod_chain(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options,
+	std::filesystem::path const& cache);
+
+/**
+  * the key under which the chain of `attributes` and `options` is cached
+  */
+uint64_t lod_chain_key(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options);
+
+/**
+  * writes `chain` and `key` to `path` in a binary format of the native
+  * byte order; throws `std::runtime_error` if the file cannot be written
+  */
+void save_lod_chain(
+	std::filesystem::path const& path,
+	mesh3d_lod_chain const& chain,
+	uint64_t key);
+
+/**
+  * the chain written to `path` with `key`, or `std::nullopt` if there is
+  * no such file, it has another key or it is not a chain, as when it is
+  * truncated or an index is out of range
+  */
+std::optional<mesh3d_lod_chain> load_lod_chain(
+	std::filesystem::path const& path,
+	uint64_t key);
+
+} // end of namespace ug::graphics
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <span>
+#include <vector>
 
 #include "ug/graphics/mesh3d.hpp"
 #include "ug/graphics/light3d.hpp"
@@ -24,6 +25,19 @@ public:
 	float specular_strength = 0.5f;
 	bool diffuse_lighting = true;
 
+	/**
+	  * skips the meshes and the clusters of triangles that are outside
+	  * the view frustum
+	  */
+	bool frustum_culling = true;
+
+	/**
+	  * draws the coarsest level of detail of the mesh whose error, in
+	  * pixels on the screen, is at most `lod_pixel_error`
+	  */
+	bool lod_selection = true;
+	float lod_pixel_error = 1.f;
+
 	struct{
 		bool draw = false;
 		bool use_attr_color = false;
@@ -44,7 +58,30 @@ private:
 		std::span<light3d const> lights,
 		mesh3d const& mesh);
 
+	uint64_t select_level(
+		camera const& cam,
+		glm::mat4 const& projection,
+		mesh3d const& mesh) const;
+
 	ug::graphics::program m_program;
+	std::vector<uint8_t> m_visible_clusters;
+
+	struct{
+		uniform<glm::mat4> model;
+		uniform<glm::mat4> view;
+		uniform<glm::vec3> position_scale;
+		uniform<glm::vec3> position_offset;
+		uniform<bool> octahedral_normals;
+		uniform<glm::vec3> view_pos;
+		uniform<glm::vec3> light_pos;
+		uniform<color3> light_color;
+		uniform<color4> color;
+		uniform<float> ambient_light_strength;
+		uniform<float> specular_strength;
+		uniform<bool> specular_lighting;
+		uniform<bool> diffuse_lighting;
+		uniform<bool> use_attr_color;
+	} m_uniforms;
 };
 
 } // end of namespace ug::graphics
@@ -1,8 +1,13 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include "ug/graphics/misc.hpp"
+#include "ug/graphics/bounds3d.hpp"
 #include "ug/graphics/buffers.hpp"
 #include "ug/graphics/vao.hpp"
+#include "ug/graphics/vertex-format.hpp"
 
 namespace ug::graphics{
 
@@ -12,10 +17,133 @@ struct mesh3d_attributes_layout{
 	ug::graphics::color4 color;
 };
 
+/**
+  * the unique vertices of a mesh and 3 indices per triangle
+  */
+struct mesh3d_indexed_data{
+	std::vector<mesh3d_attributes_layout> vertices;
+	std::vector<uint32_t> indices;
+};
+
+/**
+  * a level of detail, the indices of its triangles and the largest
+  * distance, in the space of the model, between its surface and the
+  * surface of the complete mesh
+  */
+struct mesh3d_lod_level{
+	std::vector<uint32_t> indices;
+	float error = 0.f;
+};
+
+/**
+  * levels of detail that share their vertices, the level 0 is the
+  * complete mesh and the next ones have less triangles and larger errors
+  */
+struct mesh3d_lod_chain{
+	std::vector<mesh3d_attributes_layout> vertices;
+	std::vector<mesh3d_lod_level> levels;
+};
+
+/**
+  * a range of triangles of a mesh close to each other, culled and drawn
+  * together, and the range of their edges in the line indices
+  */
+struct mesh3d_cluster{
+	uint32_t first_index;
+	uint32_t n_indices;
+	uint32_t first_line_index;
+	uint32_t n_line_indices;
+};
+
+/**
+  * merges the vertices of the triangle soup `attributes`, 3 vertices per
+  * triangle, with the same position, normal and color
+  */
+mesh3d_indexed_data weld_vertices(
+	std::span<mesh3d_attributes_layout const> attributes);
+
+/**
+  * reorders the triangles of `indices` to reuse the post-transform vertex
+  * cache, with the greedy scoring of Forsyth's "Linear-Speed Vertex Cache
+  * Optimisation"; `n_vertices` is greater than any index
+  */
+void optimize_vertex_cache(std::span<uint32_t> indices, uint64_t n_vertices);
+
+/**
+  * sorts the triangles of `indices` along the Morton curve of their
+  * centroids and splits them in clusters of `cluster_triangles`
+  * triangles, the last one may have less; then each cluster is
+  * reordered with `optimize_vertex_cache`
+  *
+  * the line indices of the clusters are left empty
+  */
+std::vector<mesh3d_cluster> make_clusters(
+	std::span<mesh3d_attributes_layout const> vertices,
+	std::span<uint32_t> indices,
+	uint32_t cluster_triangles);
+
+/**
+  * reorders `vertices` by their first use in `indices`, which are
+  * remapped, so the vertex fetches move forward in memory; the vertices
+  * that no triangle uses are removed
+  */
+void optimize_vertex_fetch(
+	std::vector<mesh3d_attributes_layout>& vertices,
+	std::span<uint32_t> indices);
+
+/**
+  * the edges of the triangles in `indices`, 2 indices per edge, each edge
+  * once even if it is shared by several triangles
+  */
+std::vector<uint32_t> make_line_indices(std::span<uint32_t const> indices);
+
+/**
+  * the decoding of the positions encoded with `format`, which centers
+  * them in their bounds and, for `snorm16`, scales the bounds to [-1, 1]
+  */
+position_decode make_position_decode(
+	std::span<mesh3d_attributes_layout const> attributes,
+	position_format format);
+
+/**
+  * the interleaved vertices of `attributes` encoded with `format`, the
+  * positions are encoded as `(p - decode.offset)/decode.scale`
+  */
+std::vector<std::byte> encode_vertices(
+	std::span<mesh3d_attributes_layout const> attributes,
+	vertex_format format,
+	position_decode const& decode);
+
 class mesh3d{
 public:
 
-	explicit mesh3d(std::vector<mesh3d_attributes_layout>&& attributes);
+	/**
+	  * the number of triangles of the clusters culled by `mesh3d_render`
+	  */
+	static constexpr uint32_t cluster_triangles = 256;
+
+	/**
+	  * the triangle soup `attributes`, 3 vertices per triangle, is welded
+	  * into an indexed mesh
+	  */
+	explicit mesh3d(
+		std::vector<mesh3d_attributes_layout>&& attributes,
+		vertex_format format = {});
+
+	/**
+	  * the triangles are reordered for the vertex cache and the vertices
+	  * for the fetches, then the vertices are uploaded encoded with
+	  * `format`; throws `std::runtime_error` if the number of indices is
+	  * not a multiple of 3 or an index is out of range
+	  */
+	explicit mesh3d(mesh3d_indexed_data&& data, vertex_format format = {});
+
+	/**
+	  * each level is split in its own clusters, the vertices and the
+	  * indices of every level are uploaded once
+	  */
+	explicit mesh3d(mesh3d_lod_chain&& chain, vertex_format format = {});
+
 	mesh3d(mesh3d const&) = delete;
 	mesh3d(mesh3d&&) = default;
 
@@ -24,24 +152,94 @@ public:
 
 	void bind() const;
 
-	void draw_triangles() const;
+	void draw_triangles(uint64_t level = 0) const;
+
+	void draw_lines(uint64_t level = 0) const;
 
-	void draw_lines() const;
+	/**
+	  * draws the clusters `i` of `level` with `visible_clusters[i] != 0`,
+	  * with one draw call for each run of consecutive visible clusters
+	  */
+	void draw_triangles(
+		uint64_t level,
+		std::span<uint8_t const> visible_clusters) const;
+
+	void draw_lines(
+		uint64_t level,
+		std::span<uint8_t const> visible_clusters) const;
 
 	glm::mat4 const& model_matrix() const;
 
+	/**
+	  * the unique vertices, indexed by `indices`
+	  */
 	std::vector<mesh3d_attributes_layout> const& attributes() const;
 
+	/**
+	  * the indices of every level, one after the other
+	  */
+	std::vector<uint32_t> const& indices() const;
+
+	/**
+	  * `GL_UNSIGNED_SHORT` if the mesh has up to 65536 vertices, otherwise
+	  * `GL_UNSIGNED_INT`
+	  */
+	uint32_t index_type() const;
+
+	vertex_format const& format() const;
+
+	/**
+	  * how the shaders decode the positions of the vertex buffer
+	  */
+	position_decode const& position_decoding() const;
+
+	uint64_t n_levels() const;
+
+	/**
+	  * the error of the level, in the space of the model
+	  */
+	float level_error(uint64_t level) const;
+
+	std::vector<mesh3d_cluster> const& clusters(uint64_t level = 0) const;
+
+	/**
+	  * the boxes of the clusters in the space of the model
+	  */
+	aabb3d_array const& cluster_boxes(uint64_t level = 0) const;
+
+	/**
+	  * the bounds of the mesh in world space, updated by `transform`
+	  */
+	aabb3d const& bounding_box() const;
+	sphere3d const& bounding_sphere() const;
+
 	void transform(glm::mat4 const&);
 
 private:
 	ug::graphics::vao vao;
 	ug::graphics::vbo vbo;
+	ug::graphics::ebo ebo_triangles;
 	ug::graphics::ebo ebo_lines;
 
+	struct level{
+		std::vector<mesh3d_cluster> clusters;
+		aabb3d_array cluster_boxes;
+		float error;
+	};
+
+	void initialize_bounds();
 	void initialize_ebos();
 
 	std::vector<mesh3d_attributes_layout>	m_attributes;
+	std::vector<uint32_t> m_indices;
+	uint32_t m_index_type = GL_UNSIGNED_INT;
+	vertex_format m_format;
+	position_decode m_position_decode;
+	std::vector<level> m_levels;
+	aabb3d m_local_box{};
+	sphere3d m_local_sphere{};
+	aabb3d m_box{};
+	sphere3d m_sphere{};
 	glm::mat4 model = glm::mat4(1.f);
 };
 
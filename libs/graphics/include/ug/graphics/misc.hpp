@@ -1,6 +1,9 @@
 #pragma once
 
 #include <concepts>
+#include <functional>
+#include <string>
+#include <string_view>
 
 #include "glm/vec2.hpp"
 #include "glm/ext/scalar_constants.hpp"
@@ -32,21 +35,47 @@ enum class color_type : uint32_t {
 	BGRA = GL_BGRA
 };
 
+/**
+  * the bits of an IEEE 754 half precision float, as read by OpenGL for
+  * `GL_HALF_FLOAT` attributes
+  */
+struct half_float{
+	uint16_t bits;
+};
+
 template<class T>
 struct type_code;
 
+template<>
+struct type_code<int8_t>
+{
+	static constexpr uint32_t value = GL_BYTE;
+};
+
 template<>
 struct type_code<uint8_t>
 {
 	static constexpr uint32_t value = GL_UNSIGNED_BYTE;
 };
 
+template<>
+struct type_code<int16_t>
+{
+	static constexpr uint32_t value = GL_SHORT;
+};
+
 template<>
 struct type_code<uint16_t>
 {
 	static constexpr uint32_t value = GL_UNSIGNED_SHORT;
 };
 
+template<>
+struct type_code<half_float>
+{
+	static constexpr uint32_t value = GL_HALF_FLOAT;
+};
+
 template<>
 struct type_code<uint32_t>
 {
@@ -79,6 +108,23 @@ struct rect2d{
 	float top() const;
 };
 
+/**
+  * a hash for maps keyed by `std::string` that can be searched with a
+  * `char const*` or a `std::string_view` without a temporary string
+  */
+struct heterogeneous_string_hash {
+	using is_transparent = void;
+	[[nodiscard]] size_t operator()(char const* txt) const {
+		return std::hash<std::string_view>{}(txt);
+	}
+	[[nodiscard]] size_t operator()(std::string_view txt) const {
+		return std::hash<std::string_view>{}(txt);
+	}
+	[[nodiscard]] size_t operator()(std::string const& txt) const {
+		return std::hash<std::string>{}(txt);
+	}
+};
+
 template<class IntegerType>
 constexpr auto to_closest_integer(scalar t)
 {
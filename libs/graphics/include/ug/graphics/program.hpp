@@ -1,6 +1,11 @@
 #pragma once
 
 #include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include "ug/graphics/misc.hpp"
 #include "ug/graphics/shader.hpp"
 
@@ -8,6 +13,63 @@ namespace ug::graphics{
 
 namespace rgs = std::ranges;
 
+/**
+  * the OpenGL type of the uniforms that can be set with a `T`, or 0 if
+  * it is not checked
+  */
+template<class T>
+inline constexpr uint32_t uniform_type_code_v = 0;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<float> = GL_FLOAT;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<glm::vec2> = GL_FLOAT_VEC2;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<glm::vec3> = GL_FLOAT_VEC3;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<glm::vec4> = GL_FLOAT_VEC4;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<glm::mat4> = GL_FLOAT_MAT4;
+
+template<>
+inline constexpr uint32_t uniform_type_code_v<bool> = GL_BOOL;
+
+/**
+  * the location of a uniform of type `T`, resolved once with
+  * `program::get_uniform` and then set without looking up its name
+  *
+  * a default constructed handle refers to no uniform and setting it
+  * does nothing, like the uniforms that are not active in the program
+  */
+template<class T>
+class uniform{
+public:
+	using value_type = T;
+
+	constexpr uniform() = default;
+
+	constexpr explicit uniform(int32_t location) noexcept
+		: m_location(location)
+	{}
+
+	constexpr int32_t location() const noexcept
+	{
+		return m_location;
+	}
+
+	constexpr bool is_active() const noexcept
+	{
+		return m_location != -1;
+	}
+
+private:
+	int32_t m_location = -1;
+};
+
 class program{
 public:
 	program();
@@ -17,8 +79,55 @@ public:
 
 	void attach_shader(shader const& s) const;
 	void use() const;
-	void link() const;
-	uint32_t id() const; 
+
+	/**
+	  * links the program and caches the location of its active uniforms;
+	  * throws `std::runtime_error` with the info log if it fails
+	  */
+	void link();
+	uint32_t id() const;
+
+	/**
+	  * the location of the uniform `name` or -1 if it is not active,
+	  * looked up in the cache filled by `link`; the elements of an array
+	  * are found as `name[i]`
+	  */
+	int32_t uniform_location(std::string_view name) const;
+
+	/**
+	  * resolves the uniform `name`; throws `std::runtime_error` if it is
+	  * active with a type that cannot be set with a `T`
+	  */
+	template<class T>
+	uniform<T> get_uniform(std::string_view name) const
+	{
+		auto const it = m_uniforms.find(name);
+		if(it == m_uniforms.end())
+			return uniform<T>{};
+
+		if constexpr(uniform_type_code_v<T> != 0){
+			if(it->second.type != uniform_type_code_v<T>){
+				throw std::runtime_error(
+					"uniform " + std::string{ name }
+					+ " has a different type in the program"
+				);
+			}
+		}
+
+		return uniform<T>{ it->second.location };
+	}
+
+	/**
+	  * binds the uniform block `name` to the uniform buffer binding
+	  * point `binding`; a block that is not active is ignored
+	  */
+	void set_uniform_block_binding(char const* name, uint32_t binding) const;
+
+	template<class T>
+	void set_uniform(uniform<T> u, std::type_identity_t<T> const& value) const
+	{
+		set_uniform_at(u.location(), value);
+	}
 
 	void set_uniform(char const* name, float f1) const;
 	void set_uniform(char const* name, float f1, float f2) const;
@@ -42,10 +151,8 @@ public:
 		requires (std::is_same_v<rgs::range_value_t<R>, float>)
 	void set_uniform(char const* name, R const& r) const
 	{
-		int32_t id;
-		GL(id = glGetUniformLocation(m_id, name));
 		GL(glUniform1fv(
-			id,
+			uniform_location(name),
 			static_cast<int32_t>(rgs::size(r)),
 			rgs::cdata(r))
 		);
@@ -55,17 +162,36 @@ public:
 		requires (std::is_same_v<rgs::range_value_t<R>, int32_t>)
 	void set_uniform(char const* name, R const& r) const
 	{
-		int32_t id;
-		GL(id = glGetUniformLocation(m_id, name));
 		GL(glUniform1iv(
-			id,
+			uniform_location(name),
 			static_cast<int32_t>(rgs::size(r)),
 			rgs::cdata(r))
 		);
 	}
 
 protected:
+	void set_uniform_at(int32_t location, float f) const;
+	void set_uniform_at(int32_t location, glm::mat4 const& m) const;
+	void set_uniform_at(int32_t location, glm::vec2 const& v) const;
+	void set_uniform_at(int32_t location, glm::vec3 const& v) const;
+	void set_uniform_at(int32_t location, glm::vec4 const& v) const;
+	void set_uniform_at(int32_t location, bool b) const;
+	void set_uniform_at(int32_t location, int32_t n) const;
+
+	struct uniform_info{
+		int32_t location;
+		uint32_t type;
+	};
+
+	using uniform_cache_t = std::unordered_map<
+		std::string,
+		uniform_info,
+		heterogeneous_string_hash,
+		std::equal_to<>
+	>;
+
 	uint32_t m_id = 0;
+	uniform_cache_t m_uniforms;
 
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <string_view>
 
 #include "ug/graphics/misc.hpp"
@@ -17,6 +18,11 @@ struct segment2d {
 	glm::vec2 to{ 0.f, 0.f };
 };
 
+static_assert(
+	sizeof(segment2d) == 4*sizeof(float),
+	"segment2d is uploaded as the instance attributes of segment2d_render"
+);
+
 class segment2d_render : public render{
 public:
 
@@ -28,6 +34,11 @@ public:
 	  */
 	void operator()(segment2d const& b);
 
+	/**
+	  * renders all the `segments` with one instanced draw call
+	  */
+	void operator()(std::span<segment2d const> segments);
+
 	void set_color(graphics::color4 const& c);
 protected:
 
@@ -35,9 +46,10 @@ protected:
 	fragment_shader m_fragment_shader;
 
 	program m_program;
+	uniform<color4> m_color_uniform;
 
-	vao m_vscr_vao;
-	vbo m_vscr_vbo;
+	vao m_vao;
+	dynamic_buffer m_instances{ GL_ARRAY_BUFFER };
 
 	color4 m_color = { 1.0, 1.0, 1.0, 1.0 };
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ug/graphics/component.hpp"
+
+namespace ug::graphics{
+
+/**
+  * worker threads that update components while the thread of the OpenGL
+  * context draws
+  *
+  * `launch` hands the components to the workers, which take them one by
+  * one from a shared counter and call `update` `n_steps` times on each;
+  * `wait` returns once every component is updated
+  */
+class update_pipeline{
+public:
+	explicit update_pipeline(uint64_t n_threads);
+
+	update_pipeline(update_pipeline const&) = delete;
+	update_pipeline& operator=(update_pipeline const&) = delete;
+
+	/**
+	  * the previous launch must have been waited for
+	  */
+	void launch(
+		std::vector<std::shared_ptr<component>> const& components,
+		uint64_t n_steps);
+
+	/**
+	  * waits for the updates of the last launch and rethrows the first
+	  * exception of an update, if any
+	  */
+	void wait();
+
+	uint64_t n_threads() const;
+
+private:
+	void work(std::stop_token stop);
+
+	std::vector<std::shared_ptr<component>> m_components;
+	uint64_t m_n_steps = 0;
+	std::atomic<uint64_t> m_next_component{ 0 };
+	uint64_t m_n_pending = 0;
+	uint64_t m_n_active = 0;
+	uint64_t m_generation = 0;
+	std::exception_ptr m_error;
+	std::mutex m_mutex;
+	std::condition_variable_any m_changed;
+
+	// the last member, so the threads stop before the rest is destroyed
+	std::vector<std::jthread> m_workers;
+};
+
+} // end of namespace ug::graphics
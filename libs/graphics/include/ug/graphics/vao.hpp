@@ -4,6 +4,8 @@
 #include <vector>
 #include <initializer_list>
 
+#include "ug/graphics/misc.hpp"
+
 namespace ug::graphics{
 
 class vao{
@@ -99,7 +101,19 @@ public:
 
 	uint32_t id() const;
 
-	void set_attribute_layout(const attribute_layout& attributes) const;
+	/**
+	  * sets the layout of the attributes read from the bound array buffer
+	  *
+	  * @param attributes	the attributes, numbered from 0
+	  * @param divisor	0 if the attributes advance per vertex, otherwise
+	  *			the number of instances that share each value
+	  * @param offset	the offset in bytes of the first element in the
+	  *			buffer
+	  */
+	void set_attribute_layout(
+		const attribute_layout& attributes,
+		uint32_t divisor = 0,
+		uint64_t offset = 0) const;
 
 protected:
 	uint32_t m_id;
@@ -115,4 +129,33 @@ struct vao::attr<double> : public vao::attribute {
 	attr(std::uint32_t n_member, bool normalized = false);
 };
 
+/*
+ * the integer attributes are read as floats by the shaders, divided by
+ * the largest value of the type if `normalized`
+ */
+template<>
+struct vao::attr<int8_t> : public vao::attribute{
+	attr(uint32_t n_member, bool normalized = false);
+};
+
+template<>
+struct vao::attr<uint8_t> : public vao::attribute{
+	attr(uint32_t n_member, bool normalized = false);
+};
+
+template<>
+struct vao::attr<int16_t> : public vao::attribute{
+	attr(uint32_t n_member, bool normalized = false);
+};
+
+template<>
+struct vao::attr<uint16_t> : public vao::attribute{
+	attr(uint32_t n_member, bool normalized = false);
+};
+
+template<>
+struct vao::attr<half_float> : public vao::attribute{
+	attr(uint32_t n_member);
+};
+
 } // end of namespace ug::graphics
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "ug/graphics/misc.hpp"
+#include "ug/graphics/vao.hpp"
+
+namespace ug::graphics{
+
+enum class position_format : uint8_t {
+	float32,
+	/**
+	  * 4 half floats, the last one is padding
+	  */
+	float16,
+	/**
+	  * 4 16 bits normalized integers relative to the bounds of the mesh,
+	  * the last one is padding
+	  */
+	snorm16
+};
+
+enum class normal_format : uint8_t {
+	float32,
+	/**
+	  * the octahedral projection of the normal, as 2 16 bits normalized
+	  * integers
+	  */
+	octahedral
+};
+
+enum class color_format : uint8_t {
+	float32,
+	/**
+	  * 4 8 bits normalized unsigned integers
+	  */
+	unorm8
+};
+
+/**
+  * the formats of the attributes of the vertices in a vertex buffer,
+  * interleaved in the order position, normal, color
+  */
+struct vertex_format{
+	position_format position = position_format::float32;
+	normal_format normal = normal_format::float32;
+	color_format color = color_format::float32;
+
+	/**
+	  * 16 bytes per vertex instead of 40
+	  */
+	static constexpr vertex_format compact() noexcept
+	{
+		return {
+			position_format::snorm16,
+			normal_format::octahedral,
+			color_format::unorm8
+		};
+	}
+
+	uint32_t position_size() const noexcept;
+	uint32_t normal_size() const noexcept;
+	uint32_t color_size() const noexcept;
+
+	uint32_t stride() const noexcept
+	{
+		return position_size() + normal_size() + color_size();
+	}
+
+	/**
+	  * the layout read by the locations 0, 1 and 2, a shader reads the
+	  * position and the normal as `vec3` for every format but it has
+	  * to decode the octahedral normals from their `xy`
+	  */
+	vao::attribute_layout attribute_layout() const;
+
+	friend bool operator==(vertex_format, vertex_format) = default;
+};
+
+/**
+  * the encoded positions are decoded as `p*scale + offset`
+  */
+struct position_decode{
+	glm::vec3 scale = glm::vec3(1.f);
+	glm::vec3 offset = glm::vec3(0.f);
+};
+
+/*
+ * bulk encode kernels
+ * ===================
+ *
+ * they write `out[i]` from `in[i]` and are written as lane loops that the
+ * compiler vectorizes; the half floats use the F16C instructions when
+ * they are enabled
+ */
+
+/**
+  * rounds to the nearest even half float, the values too large become
+  * infinities
+  */
+void encode_float16(std::span<float const> in, std::span<half_float> out);
+
+/**
+  * clamps to [-1, 1] and rounds to the nearest of the 65535 steps
+  */
+void encode_snorm16(std::span<float const> in, std::span<int16_t> out);
+
+/**
+  * clamps to [0, 1] and rounds to the nearest of the 256 steps
+  */
+void encode_unorm8(std::span<float const> in, std::span<uint8_t> out);
+
+/**
+  * encodes the normals given by their components as 2 `snorm16` per
+  * normal, `out` holds `2*x.size()` values; the normals do not need to
+  * be normalized but they must not be zero
+  */
+void encode_octahedral(
+	std::span<float const> x,
+	std::span<float const> y,
+	std::span<float const> z,
+	std::span<int16_t> out);
+
+} // end of namespace ug::graphics
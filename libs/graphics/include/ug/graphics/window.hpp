@@ -19,11 +19,20 @@ namespace ug::graphics{
 using window_type = GLFWwindow;
 using window_ptr = std::unique_ptr<window_type, decltype(&glfwDestroyWindow)>;
 
+/**
+  * a `HIDDEN` window is never shown, it only holds the OpenGL context
+  */
+enum class window_visibility : int8_t {
+	SHOWN,
+	HIDDEN
+};
+
 class window {
 public:
 	explicit window(
 		int32_t width, int32_t height,
-		char const* window_title
+		char const* window_title,
+		window_visibility visibility = window_visibility::SHOWN
 	);
 
 	virtual ~window() = default;
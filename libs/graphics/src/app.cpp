@@ -1,11 +1,15 @@
+#include <algorithm>
 #include <boost/gil/algorithm.hpp>
 #include <boost/gil/image_view_factory.hpp>
 #include <boost/gil/typedefs.hpp>
+#include <chrono>
 #include <cstddef>
+#include <iomanip>
 #include <sstream>
 #include <stdexcept>
 
 #include "ug/graphics/app.hpp"
+#include "util/instrumentation.hpp"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
@@ -28,9 +32,10 @@ static void framebuffer_size_callback(GLFWwindow* w, int width, int height)
 app::app(
 	int32_t width, int32_t height,
 	char const* window_title,
-	enum ug::graphics::app::projection_type proj_type)
+	enum ug::graphics::app::projection_type proj_type,
+	window_visibility visibility)
 
-	: window(width, height, window_title),
+	: window(width, height, window_title, visibility),
 	  m_viewport{
 			{0.0, 0.0},
 			static_cast<float>(width),
@@ -53,6 +58,21 @@ app::app(
 	GL(glEnable(GL_LINE_SMOOTH));
 	GL(glHint(GL_LINE_SMOOTH_HINT, GL_NICEST));
 
+	/*
+	 * the buffer is created here because the OpenGL functions are
+	 * loaded only now
+	 */
+	m_camera_ubo.emplace();
+	m_camera_ubo->set_data<camera_uniforms>(nullptr, 1, GL_DYNAMIC_DRAW);
+
+	// a hidden window may have no usable default framebuffer
+	if(visibility == window_visibility::HIDDEN){
+		m_offscreen.emplace(width, height);
+		m_offscreen->bind();
+	}
+
+	update_camera_uniforms();
+
 	/*
 	 * imgui context
 	 * =============
@@ -155,6 +175,103 @@ double app::get_delta() const
 	return m_delta;
 }
 
+void app::set_fixed_step(double step)
+{
+	if(step < 0.)
+		throw std::runtime_error("the fixed step cannot be negative");
+
+	m_fixed_step = step;
+	m_accumulator = 0.;
+	m_interpolation = 0.;
+}
+
+double app::get_fixed_step() const
+{
+	return m_fixed_step;
+}
+
+double app::get_interpolation() const
+{
+	return m_interpolation;
+}
+
+void app::set_update_threads(uint64_t n_threads)
+{
+	m_update_threads = n_threads;
+	m_update_pipeline.reset();
+}
+
+uint64_t app::get_update_threads() const
+{
+	return m_update_threads;
+}
+
+uint64_t app::advance_time()
+{
+	update_time();
+
+	if(m_fixed_step == 0.)
+		return 1;
+
+	/*
+	 * the time of a slow frame is bounded, otherwise the updates that
+	 * catch up would make the next frame slower
+	 */
+	auto const max_time =
+		static_cast<double>(max_steps_per_frame)*m_fixed_step;
+	m_accumulator += std::min(m_delta, max_time);
+
+	auto const n_steps = static_cast<uint64_t>(m_accumulator/m_fixed_step);
+	m_accumulator -= static_cast<double>(n_steps)*m_fixed_step;
+	m_interpolation = m_accumulator/m_fixed_step;
+	m_delta = m_fixed_step;
+
+	return n_steps;
+}
+
+void app::begin_updates(uint64_t n_steps)
+{
+	m_serial_components.clear();
+	m_parallel_components.clear();
+
+	for(auto&& [ id, ptr ] : m_component_manager){
+		if(auto c = ptr.lock()){
+			if(m_update_threads > 0 && c->is_parallel_safe())
+				m_parallel_components.push_back(std::move(c));
+			else
+				m_serial_components.push_back(std::move(c));
+		}
+	}
+
+	for(uint64_t i=0; i<n_steps; ++i){
+		update();
+		for(auto&& c : m_serial_components)
+			c->update();
+	}
+
+	if(m_parallel_components.empty() || n_steps == 0)
+		return;
+
+	// the threads are started by the first parallel-safe component
+	if(!m_update_pipeline)
+		m_update_pipeline.emplace(m_update_threads);
+
+	m_update_pipeline->launch(m_parallel_components, n_steps);
+	m_updates_launched = true;
+}
+
+void app::end_updates()
+{
+	m_serial_components.clear();
+	m_parallel_components.clear();
+
+	if(!m_updates_launched)
+		return;
+
+	m_updates_launched = false;
+	m_update_pipeline->wait();
+}
+
 bool app::is_key_pressed(int32_t key) const
 {
 	return !ui_want_capture_keyboard() &&
@@ -331,18 +448,52 @@ void app::draw_all_ui()
 
 int app::run()
 {
+	/*
+	 * the parallel-safe components are updated for the next frame while
+	 * this one is drawn, so what they update is drawn one frame later
+	 */
 	while(!should_close()){
-		update_time();
-		update_all();
+		UTIL_INSTRUMENT_SCOPE("app::run frame");
+
+		auto const n_steps = advance_time();
+
+		{
+			UTIL_INSTRUMENT_SCOPE("app::run update");
+			begin_updates(n_steps);
+		}
 
+		if(m_offscreen)
+			m_offscreen->bind();
+
+		update_camera_uniforms();
 		set_viewport();
 		clear();
 
-		draw_all();
+		{
+			UTIL_INSTRUMENT_SCOPE("app::run draw");
+			draw_all();
+		}
+
+		if(m_frame_capture){
+			UTIL_INSTRUMENT_SCOPE("app::run capture");
+			m_frame_capture->capture(m_viewport);
+		}
 
-		draw_all_ui();
+		{
+			UTIL_INSTRUMENT_SCOPE("app::run ui");
+			draw_all_ui();
+		}
+
+		{
+			UTIL_INSTRUMENT_SCOPE("app::run swap");
+			swap_buffers();
+		}
+
+		{
+			UTIL_INSTRUMENT_SCOPE("app::run parallel update");
+			end_updates();
+		}
 
-		swap_buffers();
 		poll_events();
 
 		finally_all();
@@ -351,9 +502,100 @@ int app::run()
 	return EXIT_SUCCESS;
 }
 
+static std::string frame_file_name(uint64_t number)
+{
+	std::ostringstream ss;
+	ss << "frame-" << std::setw(6) << std::setfill('0') << number << ".ppm";
+	return ss.str();
+}
+
+app::frame_timings app::run_frames(frame_run_options const& options)
+{
+	using clock_type = std::chrono::steady_clock;
+	using seconds = std::chrono::duration<double>;
+
+	auto const write_images = !options.image_directory.empty();
+	if(write_images){
+		std::filesystem::create_directories(options.image_directory);
+		start_capture(
+			[directory = options.image_directory](captured_frame&& frame)
+			{
+				write_ppm(directory/frame_file_name(frame.number), frame.image);
+			},
+			frame_capture::default_queue_capacity,
+			frame_capture::overflow_policy::WAIT
+		);
+	}
+
+	frame_timings timings;
+	timings.update.reserve(options.n_frames);
+	timings.draw.reserve(options.n_frames);
+	timings.frame.reserve(options.n_frames);
+
+	for(uint64_t i=0; i<options.n_frames; ++i){
+		UTIL_INSTRUMENT_SCOPE("app::run_frames frame");
+
+		auto const start = clock_type::now();
+
+		m_delta = options.delta;
+		begin_updates(1);
+
+		auto const updated = clock_type::now();
+
+		if(m_offscreen)
+			m_offscreen->bind();
+
+		update_camera_uniforms();
+		set_viewport();
+		clear();
+		draw_all();
+		GL(glFinish());
+
+		auto const drawn = clock_type::now();
+
+		if(m_frame_capture)
+			m_frame_capture->capture(m_viewport);
+
+		if(!m_offscreen)
+			swap_buffers();
+
+		end_updates();
+		finally_all();
+
+		auto const end = clock_type::now();
+
+		timings.update.push_back(seconds(updated - start).count());
+		timings.draw.push_back(seconds(drawn - updated).count());
+		timings.frame.push_back(seconds(end - start).count());
+	}
+
+	if(write_images)
+		stop_capture();
+
+	return timings;
+}
+
+bool app::is_offscreen() const
+{
+	return m_offscreen.has_value();
+}
+
+void app::frame_timings::write_csv(std::ostream& out) const
+{
+	out << "frame,update,draw,total\n";
+	for(uint64_t i=0; i<frame.size(); ++i){
+		out << i << ','
+			<< update[i] << ','
+			<< draw[i] << ','
+			<< frame[i] << '\n';
+	}
+}
+
 [[nodiscard]] glm::mat4 app::compute_projection_matrix() const
 {
-	auto const [ sw, sh ] = this->get_framebuffer_size();
+	auto const [ sw, sh ] = m_offscreen
+		? std::tuple{ m_offscreen->width(), m_offscreen->height() }
+		: this->get_framebuffer_size();
 	auto const screen_width = static_cast<float>(sw);
 	auto const screen_height = static_cast<float>(sh);
 
@@ -438,6 +680,22 @@ glm::mat4 app::get_view_matrix() const
 	return m_camera.view();
 }
 
+app::camera_uniforms const& app::get_camera_uniforms() const
+{
+	return m_camera_uniforms;
+}
+
+void app::update_camera_uniforms()
+{
+	m_camera_uniforms = camera_uniforms{
+		get_view_matrix(),
+		compute_projection_matrix()
+	};
+
+	m_camera_ubo->set_sub_data(0, &m_camera_uniforms, 1);
+	m_camera_ubo->bind_base(camera_uniform_binding);
+}
+
 bool app::ui_want_capture_mouse() const
 {
 	return ImGui::GetIO().WantCaptureMouse;
@@ -454,30 +712,62 @@ gil::rgb8_image_t app::get_current_frame_image() const
 	auto const w = static_cast<size_t>(vp.width);
 	auto const h = static_cast<size_t>(vp.height);
 
-	using raw_value_t = gil::rgb8_pixel_t;
-	std::vector<raw_value_t> raw_data(w*h);
+	/*
+	 * the rows of the image are aligned as the default
+	 * `GL_PACK_ALIGNMENT`, so the pixels are read in place and flipped by
+	 * swapping the rows
+	 */
+	gil::rgb8_image_t img(w, h, 4);
+	auto const view = gil::view(img);
 
 	GL(glReadPixels(
 		0, 0,
 		static_cast<int>(w), static_cast<int>(h),
 		GL_RGB,
 		GL_UNSIGNED_BYTE,
-		raw_data.data()
+		&*view.begin()
 	));
 
-	auto img_view = gil::interleaved_view(
-		w, h,
-		raw_data.data(),
-		static_cast<std::ptrdiff_t>(w * sizeof(raw_value_t))
-	);
+	for(size_t y=0; y<h/2; ++y){
+		std::swap_ranges(
+			view.row_begin(static_cast<std::ptrdiff_t>(y)),
+			view.row_end(static_cast<std::ptrdiff_t>(y)),
+			view.row_begin(static_cast<std::ptrdiff_t>(h - 1 - y))
+		);
+	}
 
-	gil::rgb8_image_t img(img_view.width(), img_view.height());
-	gil::copy_and_convert_pixels(
-		gil::flipped_up_down_view(img_view), gil::view(img)
-	);
 	return img;
 }
 
+void app::start_capture(
+	frame_capture::writer_function writer,
+	uint64_t queue_capacity,
+	frame_capture::overflow_policy overflow)
+{
+	m_frame_capture.reset();
+	m_frame_capture.emplace(std::move(writer), queue_capacity, overflow);
+}
+
+frame_capture_stats app::stop_capture()
+{
+	if(!m_frame_capture)
+		return {};
+
+	m_frame_capture->flush();
+	auto const stats = m_frame_capture->stats();
+	m_frame_capture.reset();
+
+	return stats;
+}
+
+std::optional<frame_capture_stats> app::capture_stats() const
+{
+	if(!m_frame_capture)
+		return std::nullopt;
+
+	return m_frame_capture->stats();
+}
+
 auto app::ui_window_view(
 	std::string_view str,
 	ImGuiWindowFlags flags)
@@ -3,8 +3,17 @@
 
 namespace ug::graphics{
 
-app2d::app2d(int width, int height, char const* title)
-	: app(width, height, title),
+app2d::app2d(
+	int width,
+	int height,
+	char const* title,
+	window_visibility visibility)
+	: app(
+		width,
+		height,
+		title,
+		app::projection_type::ORTHOGRAPHIC,
+		visibility),
 	  m_grid(this)
 {
 	add_component(m_camera_controller);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iterator>
 
 #include "ug/graphics/ball2d-render.hpp"
@@ -10,20 +11,31 @@ namespace ug::graphics{
  */
 
 static constexpr auto m_vertex_shaders = std::array{
+"#version 330 core\n",
+app::camera_uniform_block,
 R"__(
-#version 330 core
-
-uniform mat4 u_view;
-uniform mat4 u_projection;
+layout (location = 0) in vec2 l_center;
+layout (location = 1) in float l_radius;
 
-layout (location = 0) in vec3 vscr;
+uniform float u_boundary_thick;
 
 out vec2 p;
+flat out vec2 v_center;
+flat out float v_radius;
 
 void main()
 {
-	gl_Position = u_projection*u_view*vec4(vscr, 1.f);
-	p = vscr.xy;
+	/*
+	 * the corners of the square around the ball, as a triangle strip,
+	 * with the boundary thickness added to the radius because the
+	 * antialiased boundary extends outside of the ball
+	 */
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1)*2.0 - 1.0;
+	p = l_center + corner*(l_radius + u_boundary_thick);
+
+	v_center = l_center;
+	v_radius = l_radius;
+	gl_Position = camera.projection*camera.view*vec4(p, 0.0, 1.0);
 }
 )__"};
 
@@ -31,50 +43,42 @@ static constexpr auto m_fragment_shaders = std::array{
 R"__(
 #version 330 core
 
-uniform vec2  u_center;
-uniform float u_radius;
 uniform vec4 u_color;
 
 uniform bool u_draw_fill;
 uniform bool u_draw_boundary;
 uniform vec4 u_boundary_color;
-uniform float u_thick;
 
-uniform vec2 u_proj_size;
-uniform vec2 u_resolution;
+// in world units
+uniform float u_boundary_thick;
 
 out vec4 fragment_color;
 
 in vec2 p;
+flat in vec2 v_center;
+flat in float v_radius;
 
 void main()
 {
 
 	fragment_color = vec4(0., 0., 0., 0.);
 
-	vec2 v = p - u_center;
+	vec2 v = p - v_center;
 	float dist = sqrt(dot(v, v));
 
 	if(u_draw_fill){
-		if(dist <= u_radius)
+		if(dist <= v_radius)
 			fragment_color = u_color;
 	}
 
 	if(u_draw_boundary && u_boundary_color.a > 0.0){
-		vec2 thick2 = u_proj_size/u_resolution;
-		float thick = max(0.0, max(thick2.x, thick2.y))*u_thick;
-
-		float b = abs(dist - u_radius);
-		b = smoothstep(0.0, thick, b);
+		float b = abs(dist - v_radius);
+		b = smoothstep(0.0, u_boundary_thick, b);
 		fragment_color = mix(u_boundary_color, fragment_color, b);
 	}
 }
 )__"};
 
-static constexpr auto m_vscreen_indices = std::array{
-	0u, 1u, 2u, 0u, 2u, 3u
-};
-
 /*
  * methods implementation
  * ======================
@@ -94,58 +98,69 @@ ball2d_render::ball2d_render(app* app_ptr)
 	m_program.attach_shader(m_vertex_shader);
 	m_program.attach_shader(m_fragment_shader);
 	m_program.link();
-
-	m_vscr_vao.bind();
-
-	m_vscr_ebo.set_data(m_vscreen_indices.data(), m_vscreen_indices.size());
+	m_program.set_uniform_block_binding(
+		"ug_camera",
+		app::camera_uniform_binding
+	);
+
+	m_uniforms.color = m_program.get_uniform<color4>("u_color");
+	m_uniforms.boundary_color =
+		m_program.get_uniform<color4>("u_boundary_color");
+	m_uniforms.draw_boundary =
+		m_program.get_uniform<bool>("u_draw_boundary");
+	m_uniforms.draw_fill = m_program.get_uniform<bool>("u_draw_fill");
+	m_uniforms.boundary_thick =
+		m_program.get_uniform<float>("u_boundary_thick");
 }
 
 
 void ball2d_render::operator()(ball2d const& b)
 {
-	/*
-	 * arbitrarily add 2 to the radius because of
-	 * the ball boundary antialiasing
-	 */
-	auto left	= b.c.x - (b.r + 2);
-	auto right	= b.c.x + (b.r + 2);
-	auto top	= b.c.y + (b.r + 2);
-	auto bottom	= b.c.y - (b.r + 2);
-	auto vscreen = std::array{
-		right, bottom, .0f,
-		right, top, .0f,
-		left,  top, .0f,
-		left, bottom, .0f
-	};
-
-	// bind buffers and program
-	m_program.use();
-	m_vscr_vao.bind();
-	m_vscr_ebo.bind();
-	m_vscr_vbo.set_data(vscreen.data(), vscreen.size());
+	(*this)(std::span{ &b, 1 });
+}
+
+void ball2d_render::operator()(std::span<ball2d const> balls)
+{
+	if(balls.empty())
+		return;
 
-	m_vscr_vao.set_attribute_layout({ graphics::vao::attr<float>(3) });
+	auto const offset = m_instances.write_and_commit(balls);
 
-	auto const projection = get_app()->compute_projection_matrix();
-	auto const view = get_app()->get_view_matrix();
-	auto const pv = get_app()->compute_projected_viewport(projection, view);
+	// every ball is an instance with its center and radius
+	m_instances.bind();
+	m_vao.set_attribute_layout(
+		{ graphics::vao::attr<float>(2), graphics::vao::attr<float>(1) },
+		1,
+		offset
+	);
+
+	m_program.use();
+
+	auto const& camera = get_app()->get_camera_uniforms();
+	auto const pv = get_app()->compute_projected_viewport(
+		camera.projection,
+		camera.view
+	);
 	auto [ w, h ] = get_app()->get_framebuffer_size();
 
+	// the size of a pixel in world units, times the thickness in pixels
+	auto const pixel = pv.size()/glm::vec<2, float>{ w, h };
+	auto const boundary_thick = std::max({ 0.f, pixel.x, pixel.y })*m_thick;
+
 	// set uniforms
-	m_program.set_uniform("u_center", b.c.x, b.c.y);
-	m_program.set_uniform("u_radius", b.r);
-	m_program.set_uniform("u_projection", projection);
-	m_program.set_uniform("u_view", view);
-	m_program.set_uniform("u_color", m_fill_color);
-	m_program.set_uniform("u_proj_size", pv.width, pv.height);
-	m_program.set_uniform("u_resolution", glm::vec<2, float>{ w, h });
-	m_program.set_uniform("u_boundary_color", m_boundary_color);
-	m_program.set_uniform("u_draw_boundary", m_draw_boundary);
-	m_program.set_uniform("u_draw_fill", m_draw_fill);
-	m_program.set_uniform("u_thick", m_thick);
+	m_program.set_uniform(m_uniforms.color, m_fill_color);
+	m_program.set_uniform(m_uniforms.boundary_color, m_boundary_color);
+	m_program.set_uniform(m_uniforms.draw_boundary, m_draw_boundary);
+	m_program.set_uniform(m_uniforms.draw_fill, m_draw_fill);
+	m_program.set_uniform(m_uniforms.boundary_thick, boundary_thick);
 
 	// draw
-	GL(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
+	GL(glDrawArraysInstanced(
+		GL_TRIANGLE_STRIP,
+		0,
+		4,
+		static_cast<int32_t>(balls.size())
+	));
 }
 
 void ball2d_render::set_fill_color(graphics::color4 const& c)
@@ -0,0 +1,178 @@
+#include "ug/graphics/bounds3d.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ug::graphics{
+
+float max_axis_scale(glm::mat4 const& m)
+{
+	auto scale = 0.f;
+	for(int j=0; j<3; ++j){
+		auto const l = std::sqrt(
+			m[j][0]*m[j][0] + m[j][1]*m[j][1] + m[j][2]*m[j][2]);
+		scale = std::max(scale, l);
+	}
+
+	return scale;
+}
+
+glm::vec3 aabb3d::center() const
+{
+	return (min + max)*.5f;
+}
+
+glm::vec3 aabb3d::extent() const
+{
+	return (max - min)*.5f;
+}
+
+aabb3d aabb3d::from_points(std::span<glm::vec3 const> points)
+{
+	aabb3d b{ points.front(), points.front() };
+	for(auto&& p : points){
+		for(int k=0; k<3; ++k){
+			b.min[k] = std::min(b.min[k], p[k]);
+			b.max[k] = std::max(b.max[k], p[k]);
+		}
+	}
+
+	return b;
+}
+
+aabb3d aabb3d::transformed(glm::mat4 const& m) const
+{
+	/*
+	 * Arvo's method, the extent along an axis is the sum of the absolute
+	 * projections of the extents on it
+	 */
+	auto const c = glm::vec3(m*glm::vec4(center(), 1.f));
+	auto const e = extent();
+
+	glm::vec3 new_extent{ 0.f };
+	for(int i=0; i<3; ++i){
+		for(int j=0; j<3; ++j)
+			new_extent[i] += std::abs(m[j][i])*e[j];
+	}
+
+	return { c - new_extent, c + new_extent };
+}
+
+sphere3d sphere3d::transformed(glm::mat4 const& m) const
+{
+	return {
+		glm::vec3(m*glm::vec4(center, 1.f)),
+		radius*max_axis_scale(m)
+	};
+}
+
+void aabb3d_array::push_back(aabb3d const& b)
+{
+	auto const c = b.center();
+	auto const e = b.extent();
+
+	center_x.push_back(c.x);
+	center_y.push_back(c.y);
+	center_z.push_back(c.z);
+	extent_x.push_back(e.x);
+	extent_y.push_back(e.y);
+	extent_z.push_back(e.z);
+}
+
+frustum3d::frustum3d(glm::mat4 const& clip)
+{
+	// Gribb and Hartmann, the planes are sums of the rows of the matrix
+	auto row = [&](int i)
+	{
+		return glm::vec4(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+	};
+
+	auto const r0 = row(0);
+	auto const r1 = row(1);
+	auto const r2 = row(2);
+	auto const r3 = row(3);
+
+	planes = {
+		r3 + r0,
+		r3 - r0,
+		r3 + r1,
+		r3 - r1,
+		r3 + r2,
+		r3 - r2
+	};
+
+	for(auto& p : planes){
+		auto const l = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+		if(l > 0.f)
+			p = p*(1.f/l);
+	}
+}
+
+bool frustum3d::intersects(aabb3d const& b) const
+{
+	auto const c = b.center();
+	auto const e = b.extent();
+
+	return std::ranges::all_of(planes, [&](glm::vec4 const& p)
+	{
+		auto const d = p.x*c.x + p.y*c.y + p.z*c.z + p.w;
+		auto const r = std::abs(p.x)*e.x + std::abs(p.y)*e.y
+			+ std::abs(p.z)*e.z;
+		return d + r >= 0.f;
+	});
+}
+
+bool frustum3d::intersects(sphere3d const& s) const
+{
+	return std::ranges::all_of(planes, [&](glm::vec4 const& p)
+	{
+		auto const d = p.x*s.center.x + p.y*s.center.y + p.z*s.center.z
+			+ p.w;
+		return d + s.radius >= 0.f;
+	});
+}
+
+uint64_t cull(
+	frustum3d const& f,
+	aabb3d_array const& boxes,
+	std::span<uint8_t> visible)
+{
+	/*
+	 * the planes are copied to locals, so the compiler knows they are
+	 * not changed by the stores to `visible`
+	 */
+	std::array<float, 6> a, b, c, d;
+	for(uint64_t p=0; p<6; ++p){
+		a[p] = f.planes[p].x;
+		b[p] = f.planes[p].y;
+		c[p] = f.planes[p].z;
+		d[p] = f.planes[p].w;
+	}
+
+	auto const n = boxes.size();
+	auto const cx = boxes.center_x.data();
+	auto const cy = boxes.center_y.data();
+	auto const cz = boxes.center_z.data();
+	auto const ex = boxes.extent_x.data();
+	auto const ey = boxes.extent_y.data();
+	auto const ez = boxes.extent_z.data();
+	auto const out = visible.data();
+
+	uint64_t n_visible = 0;
+	for(uint64_t i=0; i<n; ++i){
+		auto inside = true;
+		for(uint64_t p=0; p<6; ++p){
+			auto const distance = a[p]*cx[i] + b[p]*cy[i] + c[p]*cz[i] + d[p];
+			auto const radius = std::abs(a[p])*ex[i] + std::abs(b[p])*ey[i]
+				+ std::abs(c[p])*ez[i];
+			inside &= distance + radius >= 0.f;
+		}
+
+		out[i] = static_cast<uint8_t>(inside);
+		n_visible += inside;
+	}
+
+	return n_visible;
+}
+
+} // end of namespace ug::graphics
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
 
 #include "ug/graphics/buffers.hpp"
@@ -44,4 +46,192 @@ uint32_t buffer::id() const
 	return m_id;
 }
 
+/*
+ * dynamic buffer
+ * ==============
+ */
+
+static constexpr uint32_t persistent_map_flags =
+	GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+/*
+ * the sections start at multiples of it, which is at least the offset
+ * alignment of every buffer target
+ */
+static constexpr uint64_t section_alignment = 256;
+
+static uint64_t align_up(uint64_t n, uint64_t alignment)
+{
+	return (n + alignment - 1)/alignment*alignment;
+}
+
+static uint64_t ring_capacity(uint64_t n)
+{
+	auto const step = section_alignment*dynamic_buffer::n_sections;
+	return align_up(std::max<uint64_t>(n, 1), step);
+}
+
+/*
+ * waits until the GPU passes the fence and deletes it
+ */
+static void wait_and_delete(GLsync& fence)
+{
+	if(fence == nullptr)
+		return;
+
+	auto flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	for(;;){
+		uint32_t status;
+		GL(status = glClientWaitSync(fence, flags, 1'000'000));
+
+		if(status == GL_WAIT_FAILED)
+			throw std::runtime_error("could not wait for a buffer fence");
+
+		if(status != GL_TIMEOUT_EXPIRED)
+			break;
+
+		flags = 0;
+	}
+
+	GL(glDeleteSync(fence));
+	fence = nullptr;
+}
+
+dynamic_buffer::dynamic_buffer(uint32_t a_target, uint64_t a_capacity)
+	: buffer(a_target),
+	  m_persistent(GLAD_GL_VERSION_4_4 && glBufferStorage != nullptr)
+{
+	allocate(ring_capacity(a_capacity));
+}
+
+dynamic_buffer::~dynamic_buffer()
+{
+	release();
+}
+
+void dynamic_buffer::allocate(uint64_t a_capacity)
+{
+	m_capacity = a_capacity;
+	m_head = 0;
+	m_section = 0;
+
+	bind();
+
+	if(m_persistent){
+		GL(glBufferStorage(
+			m_target,
+			static_cast<int64_t>(m_capacity),
+			nullptr,
+			persistent_map_flags
+		));
+
+		void* mapped;
+		GL(mapped = glMapBufferRange(
+			m_target,
+			0,
+			static_cast<int64_t>(m_capacity),
+			persistent_map_flags
+		));
+		m_mapped = static_cast<std::byte*>(mapped);
+	}else{
+		GL(glBufferData(
+			m_target,
+			static_cast<int64_t>(m_capacity),
+			nullptr,
+			GL_STREAM_DRAW
+		));
+	}
+}
+
+void dynamic_buffer::release()
+{
+	for(auto& fence : m_fences){
+		if(fence != nullptr)
+			GL(glDeleteSync(fence));
+		fence = nullptr;
+	}
+
+	if(m_mapped != nullptr){
+		bind();
+		GL(glUnmapBuffer(m_target));
+		m_mapped = nullptr;
+	}
+}
+
+void dynamic_buffer::enter_section(uint64_t section)
+{
+	/*
+	 * `glBufferSubData` is ordered with the draws by the driver, only the
+	 * writes through the mapping need the fences
+	 */
+	if(!m_persistent){
+		m_section = section;
+		return;
+	}
+
+	GL(m_fences[m_section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	m_section = section;
+	wait_and_delete(m_fences[m_section]);
+}
+
+std::byte* dynamic_buffer::reserve(uint64_t size, uint64_t alignment)
+{
+	auto const section_size = m_capacity/n_sections;
+
+	/*
+	 * the storage of a persistent buffer is immutable, so a larger one
+	 * replaces it; the draws that still read the old one keep it alive
+	 */
+	if(size > section_size){
+		release();
+		GL(glDeleteBuffers(1, &m_id));
+		GL(glGenBuffers(1, &m_id));
+		allocate(ring_capacity(std::max(2*m_capacity, size*n_sections)));
+		return reserve(size, alignment);
+	}
+
+	auto offset = align_up(m_head, alignment);
+
+	if(offset + size > (m_section + 1)*section_size){
+		offset = (m_section + 1)%n_sections*section_size;
+		enter_section(offset/section_size);
+	}
+
+	m_window_offset = offset;
+	m_window_size = size;
+	m_head = offset + size;
+
+	if(m_persistent)
+		return m_mapped + offset;
+
+	m_staging.resize(size);
+	return m_staging.data();
+}
+
+uint64_t dynamic_buffer::commit()
+{
+	if(!m_persistent && m_window_size > 0){
+		bind();
+		GL(glBufferSubData(
+			m_target,
+			static_cast<int64_t>(m_window_offset),
+			static_cast<int64_t>(m_window_size),
+			m_staging.data()
+		));
+	}
+
+	m_window_size = 0;
+	return m_window_offset;
+}
+
+uint64_t dynamic_buffer::capacity() const
+{
+	return m_capacity;
+}
+
+bool dynamic_buffer::is_persistent() const
+{
+	return m_persistent;
+}
+
 } // end of namespace ug::graphics
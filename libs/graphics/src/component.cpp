@@ -20,6 +20,11 @@ app const* component::get_app() const
 void component::update()
 {}
 
+bool component::is_parallel_safe() const
+{
+	return false;
+}
+
 void component::draw()
 {}
 
@@ -0,0 +1,295 @@
+#include "ug/graphics/frame-capture.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace ug::graphics{
+
+/*
+ * the rows read by `glReadPixels` start at multiples of
+ * `GL_PACK_ALIGNMENT`, which is set to this value for the read
+ */
+static constexpr uint64_t pack_alignment = 4;
+
+static uint64_t row_stride(uint32_t width)
+{
+	auto const row = uint64_t{ width }*3;
+	return (row + pack_alignment - 1)/pack_alignment*pack_alignment;
+}
+
+static uint64_t check_queue_capacity(uint64_t capacity)
+{
+	if(capacity == 0)
+		throw std::invalid_argument("the capture queue cannot be empty");
+	return capacity;
+}
+
+frame_capture::frame_capture(
+	writer_function writer,
+	uint64_t queue_capacity,
+	overflow_policy overflow)
+	: m_writer_function(std::move(writer)),
+	  m_queue_capacity(check_queue_capacity(queue_capacity)),
+	  m_overflow(overflow),
+	  m_writer([this](std::stop_token stop){ write_frames(stop); })
+{}
+
+frame_capture::~frame_capture()
+{
+	for(auto& read : m_reads){
+		if(read.fence != nullptr)
+			GL(glDeleteSync(read.fence));
+		read.fence = nullptr;
+	}
+}
+
+void frame_capture::capture(rect2d const& viewport)
+{
+	poll();
+
+	auto const number = m_next_number++;
+
+	{
+		std::scoped_lock lock(m_mutex);
+		++m_stats.captured;
+	}
+
+	if(m_n_pending_reads == n_pixel_buffers){
+		if(m_overflow == overflow_policy::WAIT){
+			wait_and_collect_oldest();
+		}else{
+			std::scoped_lock lock(m_mutex);
+			++m_stats.dropped;
+			return;
+		}
+	}
+
+	auto const slot = (m_oldest_read + m_n_pending_reads)%n_pixel_buffers;
+	auto& read = m_reads[slot];
+	read.width = static_cast<uint32_t>(viewport.width);
+	read.height = static_cast<uint32_t>(viewport.height);
+	read.number = number;
+	read.capture_time = std::chrono::steady_clock::now();
+
+	auto const size = row_stride(read.width)*read.height;
+	if(size > read.capacity){
+		read.buffer.set_data<std::byte>(nullptr, size, GL_STREAM_READ);
+		read.capacity = size;
+	}
+
+	// the alignment of the caller is restored after the read
+	int alignment;
+	GL(glGetIntegerv(GL_PACK_ALIGNMENT, &alignment));
+	GL(glPixelStorei(GL_PACK_ALIGNMENT, static_cast<int>(pack_alignment)));
+
+	read.buffer.bind();
+	GL(glReadPixels(
+		static_cast<int>(viewport.position.x),
+		static_cast<int>(viewport.position.y),
+		static_cast<int>(read.width),
+		static_cast<int>(read.height),
+		GL_RGB,
+		GL_UNSIGNED_BYTE,
+		nullptr
+	));
+	GL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+	GL(glPixelStorei(GL_PACK_ALIGNMENT, alignment));
+	GL(read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+	++m_n_pending_reads;
+}
+
+void frame_capture::poll()
+{
+	while(m_n_pending_reads > 0){
+		auto& read = m_reads[m_oldest_read];
+
+		uint32_t status;
+		GL(status = glClientWaitSync(read.fence, 0, 0));
+		if(status == GL_WAIT_FAILED)
+			throw std::runtime_error("could not wait for a capture fence");
+		if(status == GL_TIMEOUT_EXPIRED)
+			break;
+
+		collect(read);
+	}
+}
+
+void frame_capture::flush()
+{
+	while(m_n_pending_reads > 0)
+		wait_and_collect_oldest();
+
+	std::unique_lock lock(m_mutex);
+	m_changed.wait(lock, [&]{ return m_queue.empty() && !m_writing; });
+
+	if(m_writer_error)
+		std::rethrow_exception(std::exchange(m_writer_error, nullptr));
+}
+
+frame_capture_stats frame_capture::stats() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_stats;
+}
+
+void frame_capture::wait_and_collect_oldest()
+{
+	auto& read = m_reads[m_oldest_read];
+
+	auto flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	for(;;){
+		uint32_t status;
+		GL(status = glClientWaitSync(read.fence, flags, 1'000'000));
+
+		if(status == GL_WAIT_FAILED)
+			throw std::runtime_error("could not wait for a capture fence");
+
+		if(status != GL_TIMEOUT_EXPIRED)
+			break;
+
+		flags = 0;
+	}
+
+	collect(read);
+}
+
+void frame_capture::collect(pixel_read& read)
+{
+	GL(glDeleteSync(read.fence));
+	read.fence = nullptr;
+	m_oldest_read = (m_oldest_read + 1)%n_pixel_buffers;
+	--m_n_pending_reads;
+
+	auto const stride = row_stride(read.width);
+	auto const row_size = uint64_t{ read.width }*3;
+
+	captured_frame frame{
+		gil::rgb8_image_t(read.width, read.height),
+		read.number,
+		read.capture_time
+	};
+
+	read.buffer.bind();
+	void const* mapped;
+	GL(mapped = glMapBufferRange(
+		GL_PIXEL_PACK_BUFFER,
+		0,
+		static_cast<int64_t>(stride*read.height),
+		GL_MAP_READ_BIT
+	));
+
+	/*
+	 * the framebuffer rows start at the bottom, so the flip is done by
+	 * copying each row to its mirror in the image
+	 */
+	auto const pixels = static_cast<std::byte const*>(mapped);
+	auto const view = gil::view(frame.image);
+	for(uint32_t y=0; y<read.height; ++y){
+		std::memcpy(
+			gil::interleaved_view_get_raw_data(view)
+				+ (read.height - 1 - y)*view.pixels().row_size(),
+			pixels + y*stride,
+			row_size
+		);
+	}
+
+	GL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+	GL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+	queue(std::move(frame));
+}
+
+void frame_capture::queue(captured_frame&& frame)
+{
+	{
+		std::unique_lock lock(m_mutex);
+		if(m_overflow == overflow_policy::WAIT){
+			m_changed.wait(lock, [&]
+			{
+				return m_queue.size() < m_queue_capacity;
+			});
+		}else if(m_queue.size() >= m_queue_capacity){
+			++m_stats.dropped;
+			return;
+		}
+
+		m_queue.push_back(std::move(frame));
+	}
+
+	m_changed.notify_all();
+}
+
+void frame_capture::write_frames(std::stop_token stop)
+{
+	std::unique_lock lock(m_mutex);
+
+	// once the stop is requested, the frames left are still written
+	while(m_changed.wait(lock, stop, [&]{ return !m_queue.empty(); })
+		|| !m_queue.empty())
+	{
+		auto frame = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_writing = true;
+
+		std::chrono::duration<double> const latency =
+			std::chrono::steady_clock::now() - frame.capture_time;
+
+		lock.unlock();
+		std::exception_ptr error;
+		try{
+			m_writer_function(std::move(frame));
+		}catch(...){
+			error = std::current_exception();
+		}
+		lock.lock();
+
+		if(error && !m_writer_error)
+			m_writer_error = error;
+
+		m_writing = false;
+		if(error)
+			++m_stats.failed;
+		else
+			++m_stats.written;
+
+		m_total_latency += latency.count();
+		m_stats.mean_latency = m_total_latency/static_cast<double>(
+			m_stats.written + m_stats.failed);
+		m_stats.max_latency =
+			std::max(m_stats.max_latency, latency.count());
+
+		m_changed.notify_all();
+	}
+}
+
+void write_ppm(
+	std::filesystem::path const& path,
+	gil::rgb8_image_t const& image)
+{
+	auto const view = gil::const_view(image);
+	auto const width = static_cast<uint64_t>(view.width());
+	auto const height = static_cast<uint64_t>(view.height());
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out << "P6\n" << width << ' ' << height << "\n255\n";
+
+	// the rows of the image can be padded, so they are written one by one
+	auto const data = gil::interleaved_view_get_raw_data(view);
+	for(uint64_t y=0; y<height; ++y){
+		out.write(
+			reinterpret_cast<char const*>(data)
+				+ static_cast<std::ptrdiff_t>(y)*view.pixels().row_size(),
+			static_cast<std::streamsize>(width*3)
+		);
+	}
+
+	if(!out)
+		throw std::runtime_error("cannot write the image " + path.string());
+}
+
+} // end of namespace ug::graphics
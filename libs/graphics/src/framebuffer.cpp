@@ -0,0 +1,83 @@
+#include "ug/graphics/framebuffer.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace ug::graphics{
+
+static uint32_t make_renderbuffer(
+	uint32_t format,
+	int32_t width,
+	int32_t height)
+{
+	uint32_t id;
+	GL(glGenRenderbuffers(1, &id));
+	GL(glBindRenderbuffer(GL_RENDERBUFFER, id));
+	GL(glRenderbufferStorage(GL_RENDERBUFFER, format, width, height));
+	return id;
+}
+
+framebuffer::framebuffer(int32_t a_width, int32_t a_height)
+	: m_color(make_renderbuffer(GL_RGBA8, a_width, a_height)),
+	  m_depth_stencil(
+		make_renderbuffer(GL_DEPTH24_STENCIL8, a_width, a_height)),
+	  m_width(a_width),
+	  m_height(a_height)
+{
+	GL(glGenFramebuffers(1, &m_id));
+	bind();
+
+	GL(glFramebufferRenderbuffer(
+		GL_FRAMEBUFFER,
+		GL_COLOR_ATTACHMENT0,
+		GL_RENDERBUFFER,
+		m_color
+	));
+	GL(glFramebufferRenderbuffer(
+		GL_FRAMEBUFFER,
+		GL_DEPTH_STENCIL_ATTACHMENT,
+		GL_RENDERBUFFER,
+		m_depth_stencil
+	));
+
+	uint32_t status;
+	GL(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+	if(status != GL_FRAMEBUFFER_COMPLETE){
+		GL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		GL(glDeleteFramebuffers(1, &m_id));
+		GL(glDeleteRenderbuffers(1, &m_color));
+		GL(glDeleteRenderbuffers(1, &m_depth_stencil));
+		throw std::runtime_error(
+			"the framebuffer is not complete, status "
+			+ std::to_string(status));
+	}
+}
+
+framebuffer::~framebuffer()
+{
+	GL(glDeleteFramebuffers(1, &m_id));
+	GL(glDeleteRenderbuffers(1, &m_color));
+	GL(glDeleteRenderbuffers(1, &m_depth_stencil));
+}
+
+void framebuffer::bind() const
+{
+	GL(glBindFramebuffer(GL_FRAMEBUFFER, m_id));
+}
+
+uint32_t framebuffer::id() const
+{
+	return m_id;
+}
+
+int32_t framebuffer::width() const
+{
+	return m_width;
+}
+
+int32_t framebuffer::height() const
+{
+	return m_height;
+}
+
+} // end of namespace ug::graphics
@@ -10,19 +10,16 @@ namespace ug::graphics{
  */
 
 static constexpr auto m_vertex_shaders = std::array{
+"#version 330 core\n",
+app::camera_uniform_block,
 R"__(
-#version 330 core
-
-uniform mat4 u_view;
-uniform mat4 u_projection;
-
 layout (location = 0) in vec3 vscr;
 
 out vec2 p;
 
 void main()
 {
-	gl_Position = u_projection*u_view*vec4(vscr, 1.f);
+	gl_Position = camera.projection*camera.view*vec4(vscr, 1.f);
 	p = vscr.xy;
 }
 )__"};
@@ -99,6 +96,10 @@ grid2d_render::grid2d_render(app* app_ptr)
 	m_program.attach_shader(m_vertex_shader);
 	m_program.attach_shader(m_fragment_shader);
 	m_program.link();
+	m_program.set_uniform_block_binding(
+		"ug_camera",
+		app::camera_uniform_binding
+	);
 
 	m_vscr_vao.bind();
 
@@ -107,9 +108,11 @@ grid2d_render::grid2d_render(app* app_ptr)
 
 void grid2d_render::operator()()
 {
-	auto const projection = get_app()->compute_projection_matrix();
-	auto const view = get_app()->get_view_matrix();
-	auto const pv = get_app()->compute_projected_viewport(projection, view);
+	auto const& camera = get_app()->get_camera_uniforms();
+	auto const pv = get_app()->compute_projected_viewport(
+		camera.projection,
+		camera.view
+	);
 	auto left	= pv.left();
 	auto right	= pv.right();
 	auto top	= pv.top();
@@ -124,17 +127,19 @@ void grid2d_render::operator()()
 
 	// bind buffers and program
 	m_program.use();
-	m_vscr_vao.bind();
+	auto const offset = m_vscr_vbo.write_and_commit(vscreen);
+
+	m_vscr_vbo.bind();
+	m_vscr_vao.set_attribute_layout(
+		{ graphics::vao::attr<float>(3) },
+		0,
+		offset
+	);
 	m_vscr_ebo.bind();
-	m_vscr_vbo.set_data(vscreen.data(), vscreen.size());
-
-	m_vscr_vao.set_attribute_layout({ graphics::vao::attr<float>(3) });
 
 	auto [ w, h ] = get_app()->get_framebuffer_size();
 
 	// set uniforms
-	m_program.set_uniform("u_projection", projection);
-	m_program.set_uniform("u_view", view);
 	m_program.set_uniform("u_color", m_grid_color);
 	m_program.set_uniform("u_proj_size", pv.width, pv.height);
 	m_program.set_uniform("u_resolution", glm::vec<2, float>{ w, h });
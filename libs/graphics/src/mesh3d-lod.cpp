@@ -0,0 +1,583 @@
+#include "ug/graphics/mesh3d-lod.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace ug::graphics{
+
+namespace{
+
+/**
+  * the sum of the squared distances to planes, a symmetric 4x4 matrix
+  * stored as its upper triangle
+  */
+struct quadric{
+	std::array<double, 10> q{};
+
+	static quadric from_plane(double a, double b, double c, double d)
+	{
+		return { {
+			a*a, a*b, a*c, a*d,
+			     b*b, b*c, b*d,
+			          c*c, c*d,
+			               d*d
+		} };
+	}
+
+	quadric& operator+=(quadric const& other)
+	{
+		for(int i=0; i<10; ++i)
+			q[i] += other.q[i];
+		return *this;
+	}
+
+	double error(glm::vec3 const& p) const
+	{
+		double const x = p.x, y = p.y, z = p.z;
+		return q[0]*x*x + 2.*q[1]*x*y + 2.*q[2]*x*z + 2.*q[3]*x
+			+ q[4]*y*y + 2.*q[5]*y*z + 2.*q[6]*y
+			+ q[7]*z*z + 2.*q[8]*z
+			+ q[9];
+	}
+};
+
+struct collapse{
+	uint32_t from;
+	uint32_t to;
+	double cost;
+};
+
+/**
+  * the edges of the triangles, 2 vertices per edge with the smallest
+  * first, once for each triangle that uses them, sorted
+  */
+std::vector<std::array<uint32_t, 2>> sorted_edges(
+	std::span<uint32_t const> triangles)
+{
+	std::vector<std::array<uint32_t, 2>> edges;
+	edges.reserve(triangles.size());
+	for(uint64_t t=0; t<triangles.size(); t+=3){
+		for(uint64_t k=0; k<3; ++k){
+			auto const a = triangles[t + k];
+			auto const b = triangles[t + (k + 1)%3];
+			edges.push_back({ std::min(a, b), std::max(a, b) });
+		}
+	}
+	std::ranges::sort(edges);
+
+	return edges;
+}
+
+glm::vec3 triangle_normal(
+	glm::vec3 const& a,
+	glm::vec3 const& b,
+	glm::vec3 const& c)
+{
+	return glm::cross(b - a, c - a);
+}
+
+/**
+  * whether moving `from` to `to` turns a triangle of `from` by more than
+  * about 75 degrees, folding the surface
+  */
+bool flips(
+	std::span<uint32_t const> triangles,
+	std::span<uint32_t const> adjacent,
+	std::span<glm::vec3 const> positions,
+	uint32_t from,
+	uint32_t to)
+{
+	for(auto t : adjacent){
+		auto const tri = triangles.subspan(3*t, 3);
+		if(tri[0] == to || tri[1] == to || tri[2] == to)
+			continue;	// removed by the collapse
+
+		std::array<glm::vec3, 3> p{
+			positions[tri[0]],
+			positions[tri[1]],
+			positions[tri[2]]
+		};
+		auto const before = triangle_normal(p[0], p[1], p[2]);
+		for(int k=0; k<3; ++k){
+			if(tri[k] == from)
+				p[k] = positions[to];
+		}
+		auto const after = triangle_normal(p[0], p[1], p[2]);
+
+		auto const d = glm::dot(before, after);
+		auto const lengths =
+			glm::dot(before, before)*glm::dot(after, after);
+		if(d <= 0.f || d*d < .0625f*lengths)
+			return true;
+	}
+
+	return false;
+}
+
+uint64_t fnv1a(uint64_t h, void const* data, uint64_t size)
+{
+	auto const bytes = static_cast<unsigned char const*>(data);
+	for(uint64_t i=0; i<size; ++i)
+		h = (h ^ bytes[i])*0x100000001b3;
+	return h;
+}
+
+constexpr std::array<char, 8> lod_chain_magic{
+	'U', 'G', 'L', 'O', 'D', 0, 0, 1
+};
+
+template<typename T>
+void write_value(std::ofstream& out, T const& value)
+{
+	out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template<typename T>
+void write_values(std::ofstream& out, std::vector<T> const& values)
+{
+	write_value(out, static_cast<uint64_t>(values.size()));
+	out.write(
+		reinterpret_cast<char const*>(values.data()),
+		static_cast<std::streamsize>(values.size()*sizeof(T))
+	);
+}
+
+template<typename T>
+bool read_value(std::ifstream& in, T& value)
+{
+	return static_cast<bool>(
+		in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+  * reads a size and as many values, refusing sizes larger than what is
+  * left in the file
+  */
+template<typename T>
+bool read_values(
+	std::ifstream& in,
+	uint64_t bytes_left,
+	std::vector<T>& values)
+{
+	uint64_t size;
+	if(!read_value(in, size) || size > bytes_left/sizeof(T))
+		return false;
+
+	values.resize(size);
+	return static_cast<bool>(in.read(
+		reinterpret_cast<char*>(values.data()),
+		static_cast<std::streamsize>(size*sizeof(T))
+	));
+}
+
+void check_options(mesh3d_lod_options const& options)
+{
+	if(!(options.reduction > 0.f && options.reduction < 1.f)){
+		throw std::invalid_argument(
+			"the lod reduction must be in (0, 1), it is "
+			+ std::to_string(options.reduction));
+	}
+
+	if(options.threads == 0)
+		throw std::invalid_argument("the lod chain needs at least one thread");
+}
+
+} // end of anonymous namespace
+
+mesh3d_lod_level simplify(
+	std::span<mesh3d_attributes_layout const> vertices,
+	std::span<uint32_t const> indices,
+	uint64_t target_triangles)
+{
+	/*
+	 * the vertices of the triangles are numbered from 0, so the arrays
+	 * indexed by vertex have the size of the triangles, not of the mesh
+	 */
+	std::vector<uint32_t> global{ indices.begin(), indices.end() };
+	std::ranges::sort(global);
+	global.erase(std::ranges::unique(global).begin(), global.end());
+
+	std::vector<uint32_t> triangles(indices.size());
+	for(uint64_t i=0; i<indices.size(); ++i){
+		triangles[i] = static_cast<uint32_t>(
+			std::ranges::lower_bound(global, indices[i]) - global.begin());
+	}
+
+	auto const n_vertices = global.size();
+	std::vector<glm::vec3> positions(n_vertices);
+	for(uint64_t v=0; v<n_vertices; ++v)
+		positions[v] = vertices[global[v]].vertex;
+
+	std::vector<quadric> quadrics(n_vertices);
+	for(uint64_t t=0; t<triangles.size(); t+=3){
+		auto const& p0 = positions[triangles[t]];
+		auto n = triangle_normal(
+			p0,
+			positions[triangles[t + 1]],
+			positions[triangles[t + 2]]
+		);
+		auto const length = std::sqrt(glm::dot(n, n));
+		if(length == 0.f)
+			continue;
+
+		n = n*(1.f/length);
+		auto const q =
+			quadric::from_plane(n.x, n.y, n.z, -glm::dot(n, p0));
+		for(uint64_t k=0; k<3; ++k)
+			quadrics[triangles[t + k]] += q;
+	}
+
+	// the edges of one triangle are the border, those of more are not manifold
+	std::vector<uint8_t> locked(n_vertices, 0);
+	{
+		auto const edges = sorted_edges(triangles);
+		for(uint64_t i=0; i<edges.size();){
+			auto j = i + 1;
+			while(j < edges.size() && edges[j] == edges[i])
+				++j;
+			if(j - i != 2){
+				locked[edges[i][0]] = 1;
+				locked[edges[i][1]] = 1;
+			}
+			i = j;
+		}
+	}
+
+	/*
+	 * each pass collapses the cheapest edges that do not share a triangle,
+	 * so the costs and the adjacency computed at its start stay valid
+	 */
+	constexpr auto infinity = std::numeric_limits<double>::infinity();
+	double max_cost = 0.;
+	std::vector<uint32_t> adjacency_offsets, adjacency;
+	std::vector<collapse> collapses;
+	std::vector<uint8_t> touched;
+
+	while(triangles.size()/3 > target_triangles){
+		adjacency_offsets.assign(n_vertices + 1, 0);
+		for(auto v : triangles)
+			++adjacency_offsets[v + 1];
+		for(uint64_t v=0; v<n_vertices; ++v)
+			adjacency_offsets[v + 1] += adjacency_offsets[v];
+
+		adjacency.resize(triangles.size());
+		{
+			auto next = adjacency_offsets;
+			for(uint64_t i=0; i<triangles.size(); ++i)
+				adjacency[next[triangles[i]]++] = static_cast<uint32_t>(i/3);
+		}
+
+		auto edges = sorted_edges(triangles);
+		edges.erase(std::ranges::unique(edges).begin(), edges.end());
+
+		collapses.clear();
+		for(auto [a, b] : edges){
+			if(locked[a] && locked[b])
+				continue;
+
+			auto q = quadrics[a];
+			q += quadrics[b];
+
+			auto const to_b = locked[a] ? infinity : q.error(positions[b]);
+			auto const to_a = locked[b] ? infinity : q.error(positions[a]);
+			if(to_b <= to_a)
+				collapses.push_back({ a, b, std::max(to_b, 0.) });
+			else
+				collapses.push_back({ b, a, std::max(to_a, 0.) });
+		}
+
+		std::ranges::sort(collapses, {}, &collapse::cost);
+
+		touched.assign(n_vertices, 0);
+		auto n_triangles = triangles.size()/3;
+		auto const n_triangles_before = n_triangles;
+
+		for(auto const& c : collapses){
+			if(n_triangles <= target_triangles)
+				break;
+			if(touched[c.from] || touched[c.to])
+				continue;
+
+			std::span<uint32_t const> const adjacent{
+				adjacency.begin() + adjacency_offsets[c.from],
+				adjacency.begin() + adjacency_offsets[c.from + 1]
+			};
+			if(flips(triangles, adjacent, positions, c.from, c.to))
+				continue;
+
+			for(auto t : adjacent){
+				auto const tri = std::span{ triangles }.subspan(3*t, 3);
+				auto const removed = tri[0] == c.to || tri[1] == c.to
+					|| tri[2] == c.to;
+				for(auto& v : tri){
+					if(v == c.from)
+						v = c.to;
+					touched[v] = 1;
+				}
+				n_triangles -= removed;
+			}
+
+			touched[c.from] = 1;
+			quadrics[c.to] += quadrics[c.from];
+			max_cost = std::max(max_cost, c.cost);
+		}
+
+		if(n_triangles == n_triangles_before)
+			break;
+
+		// removes the triangles with a repeated vertex
+		uint64_t kept = 0;
+		for(uint64_t t=0; t<triangles.size(); t+=3){
+			auto const a = triangles[t];
+			auto const b = triangles[t + 1];
+			auto const c = triangles[t + 2];
+			if(a == b || b == c || c == a)
+				continue;
+
+			triangles[kept++] = a;
+			triangles[kept++] = b;
+			triangles[kept++] = c;
+		}
+		triangles.resize(kept);
+	}
+
+	mesh3d_lod_level level;
+	level.indices.resize(triangles.size());
+	for(uint64_t i=0; i<triangles.size(); ++i)
+		level.indices[i] = global[triangles[i]];
+	level.error = static_cast<float>(std::sqrt(max_cost));
+
+	return level;
+}
+
+mesh3d_lod_chain make_lod_chain(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options)
+{
+	check_options(options);
+
+	auto welded = weld_vertices(attributes);
+
+	mesh3d_lod_chain chain;
+	chain.vertices = std::move(welded.vertices);
+	chain.levels.push_back({ std::move(welded.indices), 0.f });
+
+	while(chain.levels.size() < options.max_levels){
+		auto const& previous = chain.levels.back();
+		auto const n_triangles = previous.indices.size()/3;
+		if(n_triangles < options.min_triangles)
+			break;
+
+		auto indices = previous.indices;
+		auto const clusters = make_clusters(
+			chain.vertices,
+			indices,
+			options.cluster_triangles
+		);
+
+		/*
+		 * the clusters are simplified by a pool of threads that take the
+		 * next cluster from a shared counter; the first exception skips
+		 * the clusters left and is rethrown once the threads are joined
+		 */
+		std::vector<mesh3d_lod_level> simplified(clusters.size());
+		std::atomic<uint64_t> next_cluster = 0;
+		std::exception_ptr error;
+		std::mutex error_mutex;
+
+		auto simplify_clusters = [&]
+		{
+			for(uint64_t i; (i = next_cluster++) < clusters.size();){
+				auto const& c = clusters[i];
+				auto const cluster_indices =
+					std::span<uint32_t const>{ indices }
+						.subspan(c.first_index, c.n_indices);
+				auto const target = static_cast<uint64_t>(std::ceil(
+					static_cast<double>(c.n_indices/3)*options.reduction));
+
+				simplified[i] = simplify(
+					chain.vertices,
+					cluster_indices,
+					target
+				);
+			}
+		};
+
+		auto worker = [&]
+		{
+			try{
+				simplify_clusters();
+			}catch(...){
+				std::scoped_lock lock(error_mutex);
+				if(!error)
+					error = std::current_exception();
+				next_cluster = clusters.size();
+			}
+		};
+
+		{
+			std::vector<std::jthread> pool;
+			auto const n_threads = std::min<uint64_t>(
+				options.threads, clusters.size());
+			for(uint64_t i=1; i<n_threads; ++i)
+				pool.emplace_back(worker);
+			worker();
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+
+		mesh3d_lod_level level;
+		level.error = previous.error;
+		auto max_cluster_error = 0.f;
+		for(auto const& s : simplified){
+			level.indices.insert(
+				level.indices.end(),
+				s.indices.begin(),
+				s.indices.end()
+			);
+			max_cluster_error = std::max(max_cluster_error, s.error);
+		}
+		level.error += max_cluster_error;
+
+		// stops when the locked boundaries are most of what is left
+		if(level.indices.size()/3 > n_triangles*9/10)
+			break;
+
+		chain.levels.push_back(std::move(level));
+	}
+
+	return chain;
+}
+
+mesh3d_lod_chain make_lod_chain(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options,
+	std::filesystem::path const& cache)
+{
+	check_options(options);
+
+	auto const key = lod_chain_key(attributes, options);
+	if(auto chain = load_lod_chain(cache, key))
+		return std::move(*chain);
+
+	auto chain = make_lod_chain(attributes, options);
+	save_lod_chain(cache, chain, key);
+
+	return chain;
+}
+
+uint64_t lod_chain_key(
+	std::span<mesh3d_attributes_layout const> attributes,
+	mesh3d_lod_options const& options)
+{
+	uint64_t h = 0xcbf29ce484222325;
+	h = fnv1a(h, attributes.data(), attributes.size_bytes());
+	h = fnv1a(h, &options.reduction, sizeof(options.reduction));
+	h = fnv1a(h, &options.min_triangles, sizeof(options.min_triangles));
+	h = fnv1a(h, &options.max_levels, sizeof(options.max_levels));
+	h = fnv1a(
+		h,
+		&options.cluster_triangles,
+		sizeof(options.cluster_triangles)
+	);
+
+	return h;
+}
+
+void save_lod_chain(
+	std::filesystem::path const& path,
+	mesh3d_lod_chain const& chain,
+	uint64_t key)
+{
+	// written next to `path` and renamed, so a reader never sees half a file
+	auto tmp = path;
+	tmp += ".tmp";
+
+	{
+		std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+		out.write(lod_chain_magic.data(), lod_chain_magic.size());
+		write_value(out, key);
+		write_values(out, chain.vertices);
+		write_value(out, static_cast<uint64_t>(chain.levels.size()));
+		for(auto const& level : chain.levels){
+			write_value(out, level.error);
+			write_values(out, level.indices);
+		}
+
+		if(!out){
+			throw std::runtime_error(
+				"cannot write the lod chain to " + tmp.string());
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmp, path, ec);
+	if(ec){
+		throw std::runtime_error(
+			"cannot write the lod chain to " + path.string()
+			+ ": " + ec.message());
+	}
+}
+
+std::optional<mesh3d_lod_chain> load_lod_chain(
+	std::filesystem::path const& path,
+	uint64_t key)
+{
+	std::error_code ec;
+	auto const file_size = std::filesystem::file_size(path, ec);
+	if(ec)
+		return std::nullopt;
+
+	std::ifstream in(path, std::ios::binary);
+	std::array<char, 8> magic;
+	uint64_t file_key;
+	if(!in.read(magic.data(), magic.size())
+		|| magic != lod_chain_magic
+		|| !read_value(in, file_key)
+		|| file_key != key)
+	{
+		return std::nullopt;
+	}
+
+	mesh3d_lod_chain chain;
+	uint64_t n_levels;
+	if(!read_values(in, file_size, chain.vertices)
+		|| !read_value(in, n_levels)
+		|| n_levels > file_size)
+	{
+		return std::nullopt;
+	}
+
+	auto const is_vertex = [&](uint32_t i)
+	{
+		return i < chain.vertices.size();
+	};
+
+	chain.levels.resize(n_levels);
+	for(auto& level : chain.levels){
+		if(!read_value(in, level.error)
+			|| !read_values(in, file_size, level.indices)
+			|| level.indices.size() % 3 != 0
+			|| !std::ranges::all_of(level.indices, is_vertex))
+		{
+			return std::nullopt;
+		}
+	}
+
+	// a chain followed by something else is not a chain either
+	if(in.peek() != std::ifstream::traits_type::eof())
+		return std::nullopt;
+
+	return chain;
+}
+
+} // end of namespace ug::graphics
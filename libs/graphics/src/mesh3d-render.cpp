@@ -1,14 +1,16 @@
 #include <exception>
 
 #include "ug/graphics/mesh3d-render.hpp"
+#include "ug/graphics/bounds3d.hpp"
 #include "ug/graphics/program.hpp"
 #include "ug/graphics/shader.hpp"
 
 namespace ug::graphics{
 
-static constexpr auto phong_simple_vs = std::array{R"__(
-#version 330 core
-
+static constexpr auto phong_simple_vs = std::array{
+"#version 330 core\n",
+app::camera_uniform_block,
+R"__(
 layout (location = 0) in vec3 l_pos;
 layout (location = 1) in vec3 l_normal;
 layout (location = 2) in vec4 l_color;
@@ -18,15 +20,31 @@ out vec3 frag_pos;
 
 uniform mat4 u_model;
 uniform mat4 u_view;
-uniform mat4 u_projection;
+
+// the decoding of the vertex formats of the mesh
+uniform vec3 u_position_scale;
+uniform vec3 u_position_offset;
+uniform bool u_octahedral_normals;
 
 out vec4 v_color;
 
+vec3 octahedral_decode(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
+
 void main()
 {
-	normal = mat3(transpose(inverse(u_model))) * l_normal;
-	frag_pos = vec3(u_model * vec4(l_pos, 1.0));
-	gl_Position = u_projection * u_view * u_model * vec4(l_pos, 1.f);
+	vec3 pos = l_pos * u_position_scale + u_position_offset;
+	vec3 n = u_octahedral_normals ? octahedral_decode(l_normal.xy) : l_normal;
+
+	normal = mat3(transpose(inverse(u_model))) * n;
+	frag_pos = vec3(u_model * vec4(pos, 1.0));
+	gl_Position = camera.projection * u_view * u_model * vec4(pos, 1.f);
 	v_color = l_color;
 }
 )__"};
@@ -83,10 +101,10 @@ void main()
 } 
 )__"};
 
-template<uint64_t N>
+template<uint64_t N, uint64_t M>
 static auto make_program(
 	static_shader_source<N> const& vertex_shaders,
-	static_shader_source<N> const& fragment_shaders)
+	static_shader_source<M> const& fragment_shaders)
 {
 	vertex_shader vs;
 	fragment_shader fs;
@@ -101,6 +119,7 @@ static auto make_program(
 	p.attach_shader(vs);
 	p.attach_shader(fs);
 	p.link();
+	p.set_uniform_block_binding("ug_camera", app::camera_uniform_binding);
 
 	return p;
 }
@@ -108,7 +127,31 @@ static auto make_program(
 mesh3d_render::mesh3d_render(app* app_ptr)
 	: render(app_ptr),
 	  m_program(make_program(phong_simple_vs, phong_simple_fs))
-{}
+{
+	m_uniforms.model = m_program.get_uniform<glm::mat4>("u_model");
+	m_uniforms.view = m_program.get_uniform<glm::mat4>("u_view");
+	m_uniforms.position_scale =
+		m_program.get_uniform<glm::vec3>("u_position_scale");
+	m_uniforms.position_offset =
+		m_program.get_uniform<glm::vec3>("u_position_offset");
+	m_uniforms.octahedral_normals =
+		m_program.get_uniform<bool>("u_octahedral_normals");
+	m_uniforms.view_pos = m_program.get_uniform<glm::vec3>("u_view_pos");
+	m_uniforms.light_pos = m_program.get_uniform<glm::vec3>("u_light_pos");
+	m_uniforms.light_color =
+		m_program.get_uniform<color3>("u_light_color");
+	m_uniforms.color = m_program.get_uniform<color4>("u_color");
+	m_uniforms.ambient_light_strength =
+		m_program.get_uniform<float>("u_ambient_light_strength");
+	m_uniforms.specular_strength =
+		m_program.get_uniform<float>("u_specular_strength");
+	m_uniforms.specular_lighting =
+		m_program.get_uniform<bool>("u_specular_lighting");
+	m_uniforms.diffuse_lighting =
+		m_program.get_uniform<bool>("u_diffuse_lighting");
+	m_uniforms.use_attr_color =
+		m_program.get_uniform<bool>("u_use_attr_color");
+}
 
 void mesh3d_render::common_program_setup(
 	camera const& cam,
@@ -125,22 +168,65 @@ void mesh3d_render::common_program_setup(
 	m_program.use();
 	mesh.bind();
 
-	auto const view = cam.view();
-	auto const projection = get_app()->compute_projection_matrix();
 	auto const& light = lights.front();
 
-	m_program.set_uniform("u_model", mesh.model_matrix() );
-	m_program.set_uniform("u_view", view);
-	m_program.set_uniform("u_projection", projection);
-	m_program.set_uniform("u_view_pos", cam.position);
+	m_program.set_uniform(m_uniforms.model, mesh.model_matrix());
+	m_program.set_uniform(m_uniforms.view, cam.view());
+	m_program.set_uniform(m_uniforms.view_pos, cam.position);
+
+	auto const& decode = mesh.position_decoding();
+	m_program.set_uniform(m_uniforms.position_scale, decode.scale);
+	m_program.set_uniform(m_uniforms.position_offset, decode.offset);
+	m_program.set_uniform(
+		m_uniforms.octahedral_normals,
+		mesh.format().normal == normal_format::octahedral
+	);
+
+	m_program.set_uniform(m_uniforms.light_pos, light.position);
+	m_program.set_uniform(m_uniforms.light_color, light.color);
+
+	m_program.set_uniform(
+		m_uniforms.ambient_light_strength,
+		ambient_light_strength
+	);
+	m_program.set_uniform(m_uniforms.diffuse_lighting, diffuse_lighting);
+	m_program.set_uniform(m_uniforms.specular_lighting, specular_lighting);
+	m_program.set_uniform(m_uniforms.specular_strength, specular_strength);
+}
 
-	m_program.set_uniform("u_light_pos", light.position);
-	m_program.set_uniform("u_light_color", light.color);
+uint64_t mesh3d_render::select_level(
+	camera const& cam,
+	glm::mat4 const& projection,
+	mesh3d const& mesh) const
+{
+	/*
+	 * the error of a level is projected at the point of the bounding
+	 * sphere closest to the camera, a perspective projection scales it by
+	 * the inverse of the distance and an orthographic one does not
+	 */
+	auto pixels_per_unit =
+		projection[1][1]*m_app->get_viewport().height*.5f;
+
+	if(projection[2][3] != 0.f){
+		auto const& sphere = mesh.bounding_sphere();
+		auto const distance =
+			glm::length(sphere.center - cam.position) - sphere.radius;
+		if(distance <= 0.f)
+			return 0;
+
+		pixels_per_unit /= distance;
+	}
+
+	auto const scale = max_axis_scale(mesh.model_matrix())*pixels_per_unit;
+
+	uint64_t level = 0;
+	for(uint64_t l=1; l<mesh.n_levels(); ++l){
+		if(mesh.level_error(l)*scale > lod_pixel_error)
+			break;
+		level = l;
+	}
 
-	m_program.set_uniform("u_ambient_light_strength", ambient_light_strength);
-	m_program.set_uniform("u_diffuse_lighting", diffuse_lighting);
-	m_program.set_uniform("u_specular_lighting", specular_lighting);
-	m_program.set_uniform("u_specular_strength", specular_strength);
+	return level;
 }
 
 void mesh3d_render::operator()(
@@ -148,27 +234,67 @@ void mesh3d_render::operator()(
 	std::span<light3d const> lights,
 	mesh3d const& mesh)
 {
+	/*
+	 * the mesh is tested in world space and its clusters in the space of
+	 * the model, with the projection the shaders read from the camera
+	 * block
+	 */
+	auto const& projection = m_app->get_camera_uniforms().projection;
+	auto const level = lod_selection
+		? select_level(cam, projection, mesh)
+		: 0;
+
+	std::span<uint8_t const> visible;
+	if(frustum_culling){
+		auto const view_projection = projection*cam.view();
+
+		frustum3d const world{ view_projection };
+		if(!world.intersects(mesh.bounding_sphere())
+			|| !world.intersects(mesh.bounding_box()))
+		{
+			return;
+		}
+
+		m_visible_clusters.resize(mesh.clusters(level).size());
+		auto const n_visible = cull(
+			frustum3d{ view_projection*mesh.model_matrix() },
+			mesh.cluster_boxes(level),
+			m_visible_clusters
+		);
+
+		if(n_visible == 0)
+			return;
+
+		visible = m_visible_clusters;
+	}
+
 	common_program_setup(cam, lights, mesh);
 
 	if(triangles.draw){
-		m_program.set_uniform("u_color", triangles.color);
+		m_program.set_uniform(m_uniforms.color, triangles.color);
 		m_program.set_uniform(
-			"u_use_attr_color",
+			m_uniforms.use_attr_color,
 			triangles.use_attr_color
 		);
-		mesh.draw_triangles();
+		if(frustum_culling)
+			mesh.draw_triangles(level, visible);
+		else
+			mesh.draw_triangles(level);
 	}
 
 	if(lines.draw){
 		float saved_line_width;
 		GL(glGetFloatv(GL_LINE_WIDTH, &saved_line_width));
 		GL(glLineWidth(lines.line_width));
-		m_program.set_uniform("u_color", lines.color);
+		m_program.set_uniform(m_uniforms.color, lines.color);
 		m_program.set_uniform(
-			"u_use_attr_color",
+			m_uniforms.use_attr_color,
 			lines.use_attr_color
 		);
-		mesh.draw_lines();
+		if(frustum_culling)
+			mesh.draw_lines(level, visible);
+		else
+			mesh.draw_lines(level);
 
 		GL(glLineWidth(saved_line_width));
 	}
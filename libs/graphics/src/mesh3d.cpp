@@ -1,39 +1,796 @@
 #include "ug/graphics/mesh3d.hpp"
 
-#include <numeric>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 
 namespace ug::graphics{
 
+namespace{
+
+/**
+  * the finalizer of splitmix64
+  */
+uint64_t mix64(uint64_t h)
+{
+	h ^= h >> 30;
+	h *= 0xbf58476d1ce4e5b9;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111eb;
+	h ^= h >> 31;
+	return h;
+}
+
+/**
+  * hashes the bits of the components, with -0 hashed as 0 since they
+  * compare equal
+  */
+uint64_t hash_vertex(mesh3d_attributes_layout const& a)
+{
+	uint64_t h = 0xcbf29ce484222325;
+	auto add = [&](float f)
+	{
+		h = (h ^ std::bit_cast<uint32_t>(f + 0.f))*0x100000001b3;
+	};
+
+	add(a.vertex.x);
+	add(a.vertex.y);
+	add(a.vertex.z);
+	add(a.normal.x);
+	add(a.normal.y);
+	add(a.normal.z);
+	add(a.color.r);
+	add(a.color.g);
+	add(a.color.b);
+	add(a.color.a);
+
+	return mix64(h);
+}
+
+bool same_vertex(
+	mesh3d_attributes_layout const& a,
+	mesh3d_attributes_layout const& b)
+{
+	return a.vertex == b.vertex && a.normal == b.normal && a.color == b.color;
+}
+
+/*
+ * the scores of the vertex cache optimization, with the constants of
+ * Forsyth's article
+ */
+constexpr uint64_t vertex_cache_size = 32;
+constexpr uint32_t max_scored_valence = 32;
+
+struct vertex_scores{
+	std::array<float, vertex_cache_size> cache;
+	std::array<float, max_scored_valence + 1> valence;
+};
+
+vertex_scores make_vertex_scores()
+{
+	vertex_scores s{};
+
+	/*
+	 * the vertices of the last triangle have the same score, so its
+	 * winding does not favor any of them
+	 */
+	for(uint64_t i=0; i<vertex_cache_size; ++i){
+		if(i < 3){
+			s.cache[i] = 0.75f;
+		}else{
+			auto const x = 1.f - static_cast<float>(i - 3)
+				/static_cast<float>(vertex_cache_size - 3);
+			s.cache[i] = std::pow(x, 1.5f);
+		}
+	}
+
+	// vertices with few triangles left are finished first
+	for(uint32_t v=1; v<=max_scored_valence; ++v)
+		s.valence[v] = 2.f/std::sqrt(static_cast<float>(v));
+
+	return s;
+}
+
+float vertex_score(
+	vertex_scores const& s,
+	int32_t cache_position,
+	uint32_t remaining)
+{
+	if(remaining == 0)
+		return -1.f;
+
+	auto score = s.valence[std::min(remaining, max_scored_valence)];
+	if(cache_position >= 0)
+		score += s.cache[static_cast<uint64_t>(cache_position)];
+
+	return score;
+}
+
+void check_indices(std::span<uint32_t const> indices, uint64_t n_vertices)
+{
+	if(indices.size() % 3 != 0){
+		throw std::runtime_error(
+			"mesh3d needs 3 indices per triangle"
+		);
+	}
+
+	auto const out_of_range = rgs::any_of(indices, [&](uint32_t i)
+	{
+		return i >= n_vertices;
+	});
+
+	if(out_of_range){
+		throw std::runtime_error(
+			"mesh3d index out of range of the vertices"
+		);
+	}
+}
+
+/**
+  * the low 10 bits of `x` moved to every third bit
+  */
+uint32_t spread_bits(uint32_t x)
+{
+	x &= 0x3ff;
+	x = (x | (x << 16)) & 0x030000ff;
+	x = (x | (x << 8)) & 0x0300f00f;
+	x = (x | (x << 4)) & 0x030c30c3;
+	x = (x | (x << 2)) & 0x09249249;
+	return x;
+}
+
+/**
+  * calls `f(first, last)` for every run of consecutive visible clusters,
+  * `last` included
+  */
+template<class F>
+void for_each_visible_run(
+	std::span<mesh3d_cluster const> clusters,
+	std::span<uint8_t const> visible,
+	F&& f)
+{
+	for(uint64_t i=0; i<clusters.size();){
+		if(visible[i] == 0){
+			++i;
+			continue;
+		}
+
+		auto const first = i;
+		while(i < clusters.size() && visible[i] != 0)
+			++i;
+
+		f(clusters[first], clusters[i - 1]);
+	}
+}
+
+void draw_elements(
+	uint32_t mode,
+	uint32_t first,
+	uint32_t count,
+	uint32_t index_type)
+{
+	auto const index_size = index_type == GL_UNSIGNED_SHORT
+		? sizeof(uint16_t)
+		: sizeof(uint32_t);
+
+	GL(glDrawElements(
+		mode,
+		static_cast<int32_t>(count),
+		index_type,
+		reinterpret_cast<void const*>(first*index_size)
+	));
+}
+
+/**
+  * draws the triangles of the clusters from `first` to `last`, which are
+  * consecutive in the index buffer
+  */
+void draw_triangle_run(
+	mesh3d_cluster const& first,
+	mesh3d_cluster const& last,
+	uint32_t index_type)
+{
+	draw_elements(
+		GL_TRIANGLES,
+		first.first_index,
+		last.first_index + last.n_indices - first.first_index,
+		index_type);
+}
+
+void draw_line_run(
+	mesh3d_cluster const& first,
+	mesh3d_cluster const& last,
+	uint32_t index_type)
+{
+	draw_elements(
+		GL_LINES,
+		first.first_line_index,
+		last.first_line_index + last.n_line_indices - first.first_line_index,
+		index_type);
+}
+
+void set_index_data(
+	ebo const& e,
+	std::span<uint32_t const> indices,
+	uint32_t index_type)
+{
+	if(index_type == GL_UNSIGNED_INT){
+		e.set_data(indices.data(), indices.size());
+		return;
+	}
+
+	std::vector<uint16_t> narrow(indices.size());
+	rgs::transform(indices, narrow.begin(), [](uint32_t i)
+	{
+		return static_cast<uint16_t>(i);
+	});
+	e.set_data(narrow.data(), narrow.size());
+}
+
+} // end of anonymous namespace
+
+mesh3d_indexed_data weld_vertices(
+	std::span<mesh3d_attributes_layout const> attributes)
+{
+	mesh3d_indexed_data data;
+	data.indices.reserve(attributes.size());
+
+	/*
+	 * open addressing table, each slot holds the index of a vertex plus
+	 * one, or 0 if it is free
+	 */
+	std::vector<uint32_t> slots(
+		std::bit_ceil(std::max<uint64_t>(2*attributes.size(), 2)), 0);
+	auto const mask = slots.size() - 1;
+
+	for(auto&& a : attributes){
+		auto s = hash_vertex(a) & mask;
+		while(slots[s] != 0 && !same_vertex(data.vertices[slots[s] - 1], a))
+			s = (s + 1) & mask;
+
+		if(slots[s] == 0){
+			data.vertices.push_back(a);
+			slots[s] = static_cast<uint32_t>(data.vertices.size());
+		}
+
+		data.indices.push_back(slots[s] - 1);
+	}
+
+	return data;
+}
+
+void optimize_vertex_cache(std::span<uint32_t> indices, uint64_t n_vertices)
+{
+	auto const n_triangles = indices.size()/3;
+	if(n_triangles == 0)
+		return;
+
+	static auto const scores = make_vertex_scores();
+
+	/*
+	 * the triangles not emitted yet that use each vertex, the ones of
+	 * vertex `v` are the first `remaining[v]` from `adjacency[first[v]]`
+	 */
+	std::vector<uint32_t> remaining(n_vertices, 0);
+	for(auto i : indices)
+		++remaining[i];
+
+	std::vector<uint64_t> first(n_vertices + 1, 0);
+	for(uint64_t v=0; v<n_vertices; ++v)
+		first[v + 1] = first[v] + remaining[v];
+
+	std::vector<uint32_t> adjacency(first.back());
+	{
+		std::vector<uint64_t> next(first.begin(), first.end() - 1);
+		for(uint64_t i=0; i<indices.size(); ++i)
+			adjacency[next[indices[i]]++] = static_cast<uint32_t>(i/3);
+	}
+
+	auto adjacent = [&](uint32_t v)
+	{
+		return std::span{ adjacency.data() + first[v], remaining[v] };
+	};
+
+	std::vector<int32_t> cache_position(n_vertices, -1);
+	std::vector<float> score(n_vertices);
+	for(uint64_t v=0; v<n_vertices; ++v)
+		score[v] = vertex_score(scores, -1, remaining[v]);
+
+	std::vector<float> triangle_score(n_triangles);
+	std::vector<char> emitted(n_triangles, false);
+	for(uint64_t t=0; t<n_triangles; ++t){
+		triangle_score[t] = score[indices[3*t]]
+			+ score[indices[3*t + 1]]
+			+ score[indices[3*t + 2]];
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	std::vector<uint32_t> cache, next_cache;
+	cache.reserve(vertex_cache_size + 3);
+	next_cache.reserve(vertex_cache_size + 3);
+
+	auto best = static_cast<uint64_t>(
+		rgs::max_element(triangle_score) - triangle_score.begin());
+	uint64_t not_emitted = 0;
+
+	while(true){
+		emitted[best] = true;
+		next_cache.clear();
+
+		for(uint64_t k=0; k<3; ++k){
+			auto const v = indices[3*best + k];
+			output.push_back(v);
+
+			auto const triangles = adjacent(v);
+			auto const it = rgs::find(triangles, best);
+			std::iter_swap(it, triangles.end() - 1);
+			--remaining[v];
+
+			if(rgs::find(next_cache, v) == next_cache.end())
+				next_cache.push_back(v);
+		}
+
+		auto const n_triangle_vertices = next_cache.size();
+		for(auto v : cache){
+			auto const triangle_vertices =
+				std::span{ next_cache.data(), n_triangle_vertices };
+			if(rgs::find(triangle_vertices, v) == triangle_vertices.end())
+				next_cache.push_back(v);
+		}
+
+		// the vertices past the cache size are the ones pushed out of it
+		for(uint64_t i=0; i<next_cache.size(); ++i){
+			auto const v = next_cache[i];
+			cache_position[v] = i < vertex_cache_size
+				? static_cast<int32_t>(i)
+				: -1;
+
+			auto const s = vertex_score(
+				scores, cache_position[v], remaining[v]);
+			for(auto t : adjacent(v))
+				triangle_score[t] += s - score[v];
+			score[v] = s;
+		}
+
+		next_cache.resize(std::min(next_cache.size(), vertex_cache_size));
+		std::swap(cache, next_cache);
+
+		if(output.size() == indices.size())
+			break;
+
+		auto best_score = -1.f;
+		for(auto v : cache){
+			for(auto t : adjacent(v)){
+				if(triangle_score[t] > best_score){
+					best = t;
+					best_score = triangle_score[t];
+				}
+			}
+		}
+
+		// no triangle shares a vertex with the cache
+		if(best_score < 0.f){
+			while(emitted[not_emitted])
+				++not_emitted;
+			best = not_emitted;
+		}
+	}
+
+	rgs::copy(output, indices.begin());
+}
+
+std::vector<mesh3d_cluster> make_clusters(
+	std::span<mesh3d_attributes_layout const> vertices,
+	std::span<uint32_t> indices,
+	uint32_t cluster_triangles)
+{
+	auto const n_triangles = indices.size()/3;
+	if(n_triangles == 0)
+		return {};
+
+	std::vector<glm::vec3> centroids(n_triangles);
+	for(uint64_t t=0; t<n_triangles; ++t){
+		centroids[t] = (vertices[indices[3*t]].vertex
+			+ vertices[indices[3*t + 1]].vertex
+			+ vertices[indices[3*t + 2]].vertex)*(1.f/3.f);
+	}
+
+	/*
+	 * the axes are scaled by the same factor, so the cells of the curve
+	 * are cubes and flat meshes are not split in slivers
+	 */
+	auto const bounds = aabb3d::from_points(centroids);
+	auto const size = bounds.max - bounds.min;
+	auto const largest = std::max({ size.x, size.y, size.z });
+	auto const scale = largest > 0.f ? 1023.f/largest : 0.f;
+
+	// the Morton code of each centroid in the high half, the triangle below
+	std::vector<uint64_t> keys(n_triangles);
+	for(uint64_t t=0; t<n_triangles; ++t){
+		uint32_t code = 0;
+		for(int k=0; k<3; ++k){
+			auto const x = (centroids[t][k] - bounds.min[k])*scale;
+			code |= spread_bits(static_cast<uint32_t>(x)) << k;
+		}
+
+		keys[t] = uint64_t{ code } << 32 | t;
+	}
+
+	rgs::sort(keys);
+
+	std::vector<uint32_t> sorted(indices.size());
+	for(uint64_t i=0; i<n_triangles; ++i){
+		auto const t = static_cast<uint32_t>(keys[i]);
+		std::copy_n(&indices[3*t], 3, &sorted[3*i]);
+	}
+	rgs::copy(sorted, indices.begin());
+
+	/*
+	 * each cluster is optimized with its vertices numbered from 0, so the
+	 * work does not depend on the vertices of the whole mesh
+	 */
+	constexpr auto unused = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> local_id(vertices.size(), unused);
+	std::vector<uint32_t> global_id;
+
+	std::vector<mesh3d_cluster> clusters;
+	auto const step = 3*uint64_t{ std::max(cluster_triangles, 1U) };
+
+	for(uint64_t first=0; first<indices.size(); first += step){
+		auto const cluster = indices.subspan(
+			first,
+			std::min(step, indices.size() - first));
+
+		global_id.clear();
+		for(auto& i : cluster){
+			if(local_id[i] == unused){
+				local_id[i] = static_cast<uint32_t>(global_id.size());
+				global_id.push_back(i);
+			}
+			i = local_id[i];
+		}
+
+		optimize_vertex_cache(cluster, global_id.size());
+
+		for(auto& i : cluster)
+			i = global_id[i];
+		for(auto v : global_id)
+			local_id[v] = unused;
+
+		clusters.push_back({
+			static_cast<uint32_t>(first),
+			static_cast<uint32_t>(cluster.size()),
+			0,
+			0
+		});
+	}
+
+	return clusters;
+}
+
+void optimize_vertex_fetch(
+	std::vector<mesh3d_attributes_layout>& vertices,
+	std::span<uint32_t> indices)
+{
+	constexpr auto unused = std::numeric_limits<uint32_t>::max();
+
+	std::vector<uint32_t> remap(vertices.size(), unused);
+	std::vector<mesh3d_attributes_layout> reordered;
+	reordered.reserve(vertices.size());
+
+	for(auto& i : indices){
+		if(remap[i] == unused){
+			remap[i] = static_cast<uint32_t>(reordered.size());
+			reordered.push_back(vertices[i]);
+		}
+
+		i = remap[i];
+	}
+
+	vertices = std::move(reordered);
+}
+
+std::vector<uint32_t> make_line_indices(std::span<uint32_t const> indices)
+{
+	// an edge is the smaller index in the high half and the other below
+	std::vector<uint64_t> edges;
+	edges.reserve(indices.size());
+
+	for(uint64_t t=0; t + 3<=indices.size(); t += 3){
+		for(uint64_t k=0; k<3; ++k){
+			auto const a = indices[t + k];
+			auto const b = indices[t + (k + 1) % 3];
+			if(a == b)
+				continue;
+
+			edges.push_back(
+				uint64_t{ std::min(a, b) } << 32 | std::max(a, b));
+		}
+	}
+
+	rgs::sort(edges);
+	edges.erase(rgs::unique(edges).begin(), edges.end());
+
+	std::vector<uint32_t> lines;
+	lines.reserve(2*edges.size());
+	for(auto e : edges){
+		lines.push_back(static_cast<uint32_t>(e >> 32));
+		lines.push_back(static_cast<uint32_t>(e));
+	}
+
+	return lines;
+}
+
+position_decode make_position_decode(
+	std::span<mesh3d_attributes_layout const> attributes,
+	position_format format)
+{
+	if(format == position_format::float32 || attributes.empty())
+		return {};
+
+	auto lo = attributes.front().vertex;
+	auto hi = lo;
+	for(auto&& a : attributes){
+		for(int k=0; k<3; ++k){
+			lo[k] = std::min(lo[k], a.vertex[k]);
+			hi[k] = std::max(hi[k], a.vertex[k]);
+		}
+	}
+
+	position_decode decode;
+	decode.offset = (lo + hi)*.5f;
+
+	if(format == position_format::snorm16){
+		for(int k=0; k<3; ++k){
+			auto const half_extent = (hi[k] - lo[k])*.5f;
+			decode.scale[k] = half_extent > 0.f ? half_extent : 1.f;
+		}
+	}
+
+	return decode;
+}
+
+std::vector<std::byte> encode_vertices(
+	std::span<mesh3d_attributes_layout const> attributes,
+	vertex_format format,
+	position_decode const& decode)
+{
+	auto const stride = format.stride();
+	auto const position_size = format.position_size();
+	auto const normal_size = format.normal_size();
+	auto const color_size = format.color_size();
+
+	std::vector<std::byte> encoded(attributes.size()*stride);
+
+	/*
+	 * the components of a block of vertices are gathered in arrays for
+	 * the encode kernels and the results are interleaved in `encoded`
+	 */
+	constexpr uint64_t block_size = 256;
+	std::array<float, 4*block_size> positions;
+	std::array<float, block_size> nx, ny, nz;
+	std::array<float, 4*block_size> colors;
+
+	std::array<std::byte, 4*sizeof(uint16_t)*block_size> encoded_positions;
+	std::array<int16_t, 2*block_size> encoded_normals;
+	std::array<uint8_t, 4*block_size> encoded_colors;
+
+	auto const inverse_scale = 1.f/decode.scale;
+
+	for(uint64_t first=0; first<attributes.size(); first += block_size){
+		auto const block = attributes.subspan(
+			first,
+			std::min(block_size, attributes.size() - first));
+		auto const n = block.size();
+		auto out = encoded.data() + first*stride;
+
+		for(uint64_t i=0; i<n; ++i){
+			auto const p = (block[i].vertex - decode.offset)*inverse_scale;
+			positions[4*i] = p.x;
+			positions[4*i + 1] = p.y;
+			positions[4*i + 2] = p.z;
+			positions[4*i + 3] = 0.f;
+		}
+
+		switch(format.position){
+		case position_format::float32:
+			break;
+		case position_format::float16:
+			encode_float16(
+				std::span{ positions.data(), 4*n },
+				std::span{
+					reinterpret_cast<half_float*>(encoded_positions.data()),
+					4*n
+				});
+			break;
+		case position_format::snorm16:
+			encode_snorm16(
+				std::span{ positions.data(), 4*n },
+				std::span{
+					reinterpret_cast<int16_t*>(encoded_positions.data()),
+					4*n
+				});
+			break;
+		}
+
+		if(format.normal == normal_format::octahedral){
+			for(uint64_t i=0; i<n; ++i){
+				nx[i] = block[i].normal.x;
+				ny[i] = block[i].normal.y;
+				nz[i] = block[i].normal.z;
+			}
+
+			encode_octahedral(
+				std::span{ nx.data(), n },
+				std::span{ ny.data(), n },
+				std::span{ nz.data(), n },
+				std::span{ encoded_normals.data(), 2*n });
+		}
+
+		if(format.color == color_format::unorm8){
+			for(uint64_t i=0; i<n; ++i){
+				colors[4*i] = block[i].color.r;
+				colors[4*i + 1] = block[i].color.g;
+				colors[4*i + 2] = block[i].color.b;
+				colors[4*i + 3] = block[i].color.a;
+			}
+
+			encode_unorm8(
+				std::span{ colors.data(), 4*n },
+				std::span{ encoded_colors.data(), 4*n });
+		}
+
+		for(uint64_t i=0; i<n; ++i, out += stride){
+			if(format.position == position_format::float32){
+				std::memcpy(out, &positions[4*i], position_size);
+			}else{
+				std::memcpy(
+					out,
+					&encoded_positions[i*position_size],
+					position_size);
+			}
+
+			auto const normal = out + position_size;
+			if(format.normal == normal_format::float32)
+				std::memcpy(normal, &block[i].normal, normal_size);
+			else
+				std::memcpy(normal, &encoded_normals[2*i], normal_size);
+
+			auto const color = normal + normal_size;
+			if(format.color == color_format::float32)
+				std::memcpy(color, &block[i].color, color_size);
+			else
+				std::memcpy(color, &encoded_colors[4*i], color_size);
+		}
+	}
+
+	return encoded;
+}
+
+void mesh3d::initialize_bounds()
+{
+	if(m_attributes.empty())
+		return;
+
+	std::vector<glm::vec3> points;
+	points.reserve(m_attributes.size());
+	for(auto&& a : m_attributes)
+		points.push_back(a.vertex);
+
+	m_local_box = aabb3d::from_points(points);
+
+	auto radius = 0.f;
+	auto const center = m_local_box.center();
+	for(auto&& p : points){
+		auto const d = p - center;
+		radius = std::max(radius, d.x*d.x + d.y*d.y + d.z*d.z);
+	}
+	m_local_sphere = { center, std::sqrt(radius) };
+
+	for(auto& l : m_levels){
+		for(auto&& c : l.clusters){
+			points.clear();
+			for(uint64_t i=0; i<c.n_indices; ++i){
+				auto const v = m_indices[c.first_index + i];
+				points.push_back(m_attributes[v].vertex);
+			}
+
+			l.cluster_boxes.push_back(aabb3d::from_points(points));
+		}
+	}
+
+	m_box = m_local_box.transformed(model);
+	m_sphere = m_local_sphere.transformed(model);
+}
+
 void mesh3d::initialize_ebos()
 {
-	std::vector<uint32_t> indices;
-	auto const n_lines = 3UL*m_attributes.size();
-	indices.reserve(n_lines);
-	for(auto t = 0UL; t<m_attributes.size(); t += 3UL){
-		auto const a = t, b = t + 1, c = t + 2;
-		indices.emplace_back(a);
-		indices.emplace_back(b);
-		indices.emplace_back(b);
-		indices.emplace_back(c);
-		indices.emplace_back(c);
-		indices.emplace_back(a);
+	set_index_data(ebo_triangles, m_indices, m_index_type);
+
+	/*
+	 * the edges are deduplicated in each cluster, the edges between two
+	 * clusters are kept in both so every cluster can be drawn alone
+	 */
+	std::vector<uint32_t> lines;
+	for(auto& l : m_levels){
+		for(auto& c : l.clusters){
+			auto const cluster_lines = make_line_indices(
+				std::span{ m_indices }.subspan(c.first_index, c.n_indices));
+
+			c.first_line_index = static_cast<uint32_t>(lines.size());
+			c.n_line_indices = static_cast<uint32_t>(cluster_lines.size());
+			lines.insert(
+				lines.end(),
+				cluster_lines.begin(),
+				cluster_lines.end());
+		}
 	}
 
-	ebo_lines.set_data(indices.data(), indices.size());
+	set_index_data(ebo_lines, lines, m_index_type);
 }
 
 mesh3d::mesh3d(
-	std::vector<mesh3d_attributes_layout>&& a_attributes)
-	: m_attributes(a_attributes)
+	std::vector<mesh3d_attributes_layout>&& a_attributes,
+	vertex_format a_format)
+	: mesh3d(weld_vertices(a_attributes), a_format)
+{}
+
+mesh3d::mesh3d(mesh3d_indexed_data&& data, vertex_format a_format)
+	: mesh3d(
+		mesh3d_lod_chain{
+			std::move(data.vertices),
+			{ mesh3d_lod_level{ std::move(data.indices), 0.f } }
+		},
+		a_format)
+{}
+
+mesh3d::mesh3d(mesh3d_lod_chain&& chain, vertex_format a_format)
+	: m_attributes(std::move(chain.vertices)),
+	  m_format(a_format)
 {
+	/*
+	 * the clusters of each level index the concatenation of the levels,
+	 * which is then reordered for the fetches as a whole
+	 */
+	for(auto& l : chain.levels){
+		check_indices(l.indices, m_attributes.size());
+
+		auto clusters = make_clusters(
+			m_attributes, l.indices, cluster_triangles);
+
+		auto const offset = static_cast<uint32_t>(m_indices.size());
+		for(auto& c : clusters)
+			c.first_index += offset;
+
+		m_indices.insert(m_indices.end(), l.indices.begin(), l.indices.end());
+		m_levels.push_back({ std::move(clusters), {}, l.error });
+	}
+
+	optimize_vertex_fetch(m_attributes, m_indices);
+	initialize_bounds();
+
+	m_index_type = m_attributes.size() <= 65536
+		? GL_UNSIGNED_SHORT
+		: GL_UNSIGNED_INT;
+
+	m_position_decode = make_position_decode(m_attributes, m_format.position);
+
 	vao.bind();
-	vbo.set_data(m_attributes.data(), m_attributes.size());
+	if(m_format == vertex_format{}){
+		vbo.set_data(m_attributes.data(), m_attributes.size());
+	}else{
+		auto const encoded = encode_vertices(
+			m_attributes, m_format, m_position_decode);
+		vbo.set_data(encoded.data(), encoded.size());
+	}
 
-	vao.set_attribute_layout({
-		vao::attr<float>{3},
-		vao::attr<float>{3},
-		vao::attr<float>{4}
-	});
+	vao.set_attribute_layout(m_format.attribute_layout());
 
 	initialize_ebos();
 }
@@ -44,19 +801,52 @@ void mesh3d::bind() const
 	vbo.bind();
 }
 
-void mesh3d::draw_triangles() const
+void mesh3d::draw_triangles(uint64_t a_level) const
+{
+	bind();
+	ebo_triangles.bind();
+	auto const& clusters = m_levels.at(a_level).clusters;
+	if(!clusters.empty())
+		draw_triangle_run(clusters.front(), clusters.back(), m_index_type);
+}
+
+void mesh3d::draw_lines(uint64_t a_level) const
+{
+	bind();
+	ebo_lines.bind();
+	auto const& clusters = m_levels.at(a_level).clusters;
+	if(!clusters.empty())
+		draw_line_run(clusters.front(), clusters.back(), m_index_type);
+}
+
+void mesh3d::draw_triangles(
+	uint64_t a_level,
+	std::span<uint8_t const> visible_clusters) const
 {
 	bind();
-	auto const n_vertex = static_cast<int32_t>(m_attributes.size());
-	GL(glDrawArrays(GL_TRIANGLES, 0, n_vertex));
+	ebo_triangles.bind();
+	auto const& clusters = m_levels.at(a_level).clusters;
+	for_each_visible_run(clusters, visible_clusters, [&](
+		mesh3d_cluster const& first,
+		mesh3d_cluster const& last)
+	{
+		draw_triangle_run(first, last, m_index_type);
+	});
 }
 
-void mesh3d::draw_lines() const
+void mesh3d::draw_lines(
+	uint64_t a_level,
+	std::span<uint8_t const> visible_clusters) const
 {
 	bind();
 	ebo_lines.bind();
-	auto const n_lines = static_cast<int32_t>(m_attributes.size() * 3UL);
-	GL(glDrawElements(GL_LINES, n_lines, GL_UNSIGNED_INT, 0));
+	auto const& clusters = m_levels.at(a_level).clusters;
+	for_each_visible_run(clusters, visible_clusters, [&](
+		mesh3d_cluster const& first,
+		mesh3d_cluster const& last)
+	{
+		draw_line_run(first, last, m_index_type);
+	});
 }
 
 glm::mat4 const& mesh3d::model_matrix() const
@@ -69,9 +859,61 @@ std::vector<mesh3d_attributes_layout> const& mesh3d::attributes() const
 	return m_attributes;
 }
 
+std::vector<uint32_t> const& mesh3d::indices() const
+{
+	return m_indices;
+}
+
+uint32_t mesh3d::index_type() const
+{
+	return m_index_type;
+}
+
+vertex_format const& mesh3d::format() const
+{
+	return m_format;
+}
+
+position_decode const& mesh3d::position_decoding() const
+{
+	return m_position_decode;
+}
+
+uint64_t mesh3d::n_levels() const
+{
+	return m_levels.size();
+}
+
+float mesh3d::level_error(uint64_t a_level) const
+{
+	return m_levels.at(a_level).error;
+}
+
+std::vector<mesh3d_cluster> const& mesh3d::clusters(uint64_t a_level) const
+{
+	return m_levels.at(a_level).clusters;
+}
+
+aabb3d_array const& mesh3d::cluster_boxes(uint64_t a_level) const
+{
+	return m_levels.at(a_level).cluster_boxes;
+}
+
+aabb3d const& mesh3d::bounding_box() const
+{
+	return m_box;
+}
+
+sphere3d const& mesh3d::bounding_sphere() const
+{
+	return m_sphere;
+}
+
 void mesh3d::transform(glm::mat4 const& t)
 {
 	model = model*t;
+	m_box = m_local_box.transformed(model);
+	m_sphere = m_local_sphere.transformed(model);
 }
 
 } // end of namespace ug::graphics
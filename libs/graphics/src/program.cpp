@@ -1,3 +1,5 @@
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -37,6 +39,71 @@ static void check_program_linkage(uint32_t id)
 }
 
 
+/*
+ * the location and the type of every active uniform of the linked
+ * program `id`; array uniforms are also found without the `[0]` and
+ * each of their elements by its `name[i]`
+ */
+static auto introspect_uniforms(uint32_t id)
+{
+	int32_t n_uniforms = 0;
+	int32_t max_name_length = 0;
+	GL(glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &n_uniforms));
+	GL(glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length));
+
+	std::vector<char> name_buffer(static_cast<unsigned>(max_name_length) + 1);
+
+	std::vector<std::tuple<std::string, int32_t, uint32_t>> uniforms;
+	uniforms.reserve(static_cast<unsigned>(n_uniforms));
+
+	for(int32_t i=0; i<n_uniforms; ++i){
+		int32_t length = 0;
+		int32_t size = 0;
+		uint32_t type = 0;
+
+		GL(glGetActiveUniform(
+			id,
+			static_cast<uint32_t>(i),
+			static_cast<int32_t>(name_buffer.size()),
+			&length,
+			&size,
+			&type,
+			name_buffer.data()
+		));
+
+		std::string name(name_buffer.data(), static_cast<unsigned>(length));
+
+		int32_t location;
+		GL(location = glGetUniformLocation(id, name.c_str()));
+
+		// uniforms of uniform blocks have no location
+		if(location == -1)
+			continue;
+
+		if(name.ends_with("[0]")){
+			auto const base = name.substr(0, name.size() - 3);
+			uniforms.emplace_back(base, location, type);
+
+			// the elements are not required to have consecutive locations
+			for(int32_t k=1; k<size; ++k){
+				auto element = base + "[" + std::to_string(k) + "]";
+
+				int32_t element_location;
+				GL(element_location =
+					glGetUniformLocation(id, element.c_str()));
+
+				if(element_location != -1)
+					uniforms.emplace_back(
+						std::move(element), element_location, type);
+			}
+		}
+
+		uniforms.emplace_back(std::move(name), location, type);
+	}
+
+	return uniforms;
+}
+
 program::program()
 {
 	GL(m_id = glCreateProgram());
@@ -46,6 +113,7 @@ program::program(program&& other)
 {
 	if(this != &other) {
 		m_id = std::exchange(other.m_id, 0);
+		m_uniforms = std::move(other.m_uniforms);
 	}
 }
 
@@ -60,10 +128,31 @@ void program::attach_shader(shader const& s) const
 	GL(glAttachShader(m_id, s.id()));
 }
 
-void program::link() const
+void program::link()
 {
 	GL(glLinkProgram(m_id));
 	check_program_linkage(m_id);
+
+	m_uniforms.clear();
+	for(auto&& [ name, location, type ] : introspect_uniforms(m_id))
+		m_uniforms.emplace(std::move(name), uniform_info{ location, type });
+}
+
+int32_t program::uniform_location(std::string_view name) const
+{
+	auto const it = m_uniforms.find(name);
+	return it == m_uniforms.end() ? -1 : it->second.location;
+}
+
+void program::set_uniform_block_binding(
+	char const* name,
+	uint32_t binding) const
+{
+	uint32_t index;
+	GL(index = glGetUniformBlockIndex(m_id, name));
+
+	if(index != GL_INVALID_INDEX)
+		GL(glUniformBlockBinding(m_id, index, binding));
 }
 
 uint32_t program::id() const
@@ -76,25 +165,54 @@ void program::use() const
 	GL(glUseProgram(m_id));
 }
 
+void program::set_uniform_at(int32_t location, float f) const
+{
+	GL(glUniform1f(location, f));
+}
+
+void program::set_uniform_at(int32_t location, glm::mat4 const& m) const
+{
+	GL(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m)));
+}
+
+void program::set_uniform_at(int32_t location, glm::vec2 const& v) const
+{
+	GL(glUniform2fv(location, 1, glm::value_ptr(v)));
+}
+
+void program::set_uniform_at(int32_t location, glm::vec3 const& v) const
+{
+	GL(glUniform3fv(location, 1, glm::value_ptr(v)));
+}
+
+void program::set_uniform_at(int32_t location, glm::vec4 const& v) const
+{
+	GL(glUniform4fv(location, 1, glm::value_ptr(v)));
+}
+
+void program::set_uniform_at(int32_t location, bool b) const
+{
+	GL(glUniform1i(location, b));
+}
+
+void program::set_uniform_at(int32_t location, int32_t n) const
+{
+	GL(glUniform1i(location, n));
+}
+
 void program::set_uniform(char const* name, float f1) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform1f(id, f1));
+	set_uniform_at(uniform_location(name), f1);
 }
 
 void program::set_uniform(char const* name, float f1, float f2) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform2f(id, f1, f2));
+	set_uniform_at(uniform_location(name), glm::vec2{ f1, f2 });
 }
 
 void program::set_uniform(char const* name, float f1, float f2, float f3) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform3f(id, f1, f2, f3));
+	set_uniform_at(uniform_location(name), glm::vec3{ f1, f2, f3 });
 }
 
 void program::set_uniform(
@@ -104,53 +222,37 @@ void program::set_uniform(
 	float f3,
 	float f4) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform4f(id, f1, f2, f3, f4));
+	set_uniform_at(uniform_location(name), glm::vec4{ f1, f2, f3, f4 });
 }
 
 void program::set_uniform(char const* name, glm::mat4 const& m) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniformMatrix4fv(id, 1, GL_FALSE, glm::value_ptr(m)));
+	set_uniform_at(uniform_location(name), m);
 }
 
 void program::set_uniform(char const* name, glm::vec2 const& v) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform2fv(id, 1, glm::value_ptr(v)));
+	set_uniform_at(uniform_location(name), v);
 }
 
 void program::set_uniform(char const* name, glm::vec3 const& v) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform3fv(id, 1, glm::value_ptr(v)));
+	set_uniform_at(uniform_location(name), v);
 }
 
 void program::set_uniform(char const* name, glm::vec4 const& v) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform4fv(id, 1, glm::value_ptr(v)));
+	set_uniform_at(uniform_location(name), v);
 }
 
 void program::set_uniform(char const* name, bool b) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform1i(id, b));
+	set_uniform_at(uniform_location(name), b);
 }
 
 void program::set_uniform(char const* name, int32_t n) const
 {
-	int32_t id;
-	GL(id = glGetUniformLocation(m_id, name));
-	GL(glUniform1i(id, n));
+	set_uniform_at(uniform_location(name), n);
 }
 
-
-
 } // end of namespace ug::graphics
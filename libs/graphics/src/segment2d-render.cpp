@@ -10,17 +10,16 @@ namespace ug::graphics{
  */
 
 static constexpr auto m_vertex_shaders = std::array{
+"#version 330 core\n",
+app::camera_uniform_block,
 R"__(
-#version 330 core
-
-uniform mat4 u_view;
-uniform mat4 u_projection;
-
-layout (location = 0) in vec2 vscr;
+layout (location = 0) in vec2 l_from;
+layout (location = 1) in vec2 l_to;
 
 void main()
 {
-	gl_Position = u_projection*u_view*vec4(vscr, 0.0f, 1.f);
+	vec2 p = gl_VertexID == 0 ? l_from : l_to;
+	gl_Position = camera.projection*camera.view*vec4(p, 0.0f, 1.f);
 }
 )__"};
 
@@ -58,36 +57,44 @@ segment2d_render::segment2d_render(app* app_ptr)
 	m_program.attach_shader(m_vertex_shader);
 	m_program.attach_shader(m_fragment_shader);
 	m_program.link();
+	m_program.set_uniform_block_binding(
+		"ug_camera",
+		app::camera_uniform_binding
+	);
+
+	m_color_uniform = m_program.get_uniform<color4>("u_color");
 }
 
 
 void segment2d_render::operator()(segment2d const& s)
 {
-	/*
-	 * arbitrarily add 2 to the radius because of
-	 * the ball boundary antialiasing
-	 */
-	auto line = std::array{s.from.x, s.from.y, s.to.x, s.to.y};
-
-	// bind buffers and program
-	m_program.use();
-	m_vscr_vao.bind();
-	m_vscr_vbo.set_data(line.data(), line.size());
+	(*this)(std::span{ &s, 1 });
+}
 
-	m_vscr_vao.set_attribute_layout({ graphics::vao::attr<float>(2) });
+void segment2d_render::operator()(std::span<segment2d const> segments)
+{
+	if(segments.empty())
+		return;
 
-	// set uniforms
-	m_program.set_uniform("u_projection", get_app()->compute_projection_matrix());
-	m_program.set_uniform("u_view", get_app()->get_view_matrix());
-	m_program.set_uniform("u_color", m_color);
+	auto const offset = m_instances.write_and_commit(segments);
 
-	/* auto const& pv = get_app()->get_projected_viewport(); */
-	/* auto [ w, h ] = get_app()->get_framebuffer_size(); */
-	/* m_program.set_uniform("u_proj_size", pv.width, pv.height); */
-	/* m_program.set_uniform("u_resolution", glm::vec<2, float>{ w, h }); */
+	// every segment is an instance with its two end points
+	m_instances.bind();
+	m_vao.set_attribute_layout(
+		{ graphics::vao::attr<float>(2), graphics::vao::attr<float>(2) },
+		1,
+		offset
+	);
 
-	// draw
-	GL(glDrawArrays(GL_LINES, 0, 2));
+	m_program.use();
+	m_program.set_uniform(m_color_uniform, m_color);
+
+	GL(glDrawArraysInstanced(
+		GL_LINES,
+		0,
+		2,
+		static_cast<int32_t>(segments.size())
+	));
 }
 
 void segment2d_render::set_color(graphics::color4 const& c)
@@ -0,0 +1,92 @@
+#include "ug/graphics/update-pipeline.hpp"
+
+#include <utility>
+
+namespace ug::graphics{
+
+update_pipeline::update_pipeline(uint64_t n_threads)
+{
+	m_workers.reserve(n_threads);
+	for(uint64_t i=0; i<n_threads; ++i)
+		m_workers.emplace_back([this](std::stop_token stop){ work(stop); });
+}
+
+void update_pipeline::launch(
+	std::vector<std::shared_ptr<component>> const& components,
+	uint64_t n_steps)
+{
+	{
+		std::unique_lock lock(m_mutex);
+		m_changed.wait(lock, [&]{ return m_n_active == 0; });
+
+		m_components = components;
+		m_n_steps = n_steps;
+		m_next_component = 0;
+		m_n_pending = components.size();
+		++m_generation;
+	}
+
+	m_changed.notify_all();
+}
+
+void update_pipeline::wait()
+{
+	std::unique_lock lock(m_mutex);
+	m_changed.wait(lock, [&]
+	{
+		return m_n_pending == 0 && m_n_active == 0;
+	});
+
+	// the components are released on this thread, not on a worker
+	m_components.clear();
+
+	if(m_error)
+		std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+uint64_t update_pipeline::n_threads() const
+{
+	return m_workers.size();
+}
+
+void update_pipeline::work(std::stop_token stop)
+{
+	uint64_t generation = 0;
+
+	std::unique_lock lock(m_mutex);
+	auto launched = [&]{ return m_generation != generation; };
+
+	while(m_changed.wait(lock, stop, launched)){
+		generation = m_generation;
+		++m_n_active;
+		lock.unlock();
+
+		/*
+		 * the components are read without the lock, so `launch` and
+		 * `wait` do not change them while a worker is active
+		 */
+		uint64_t n_updated = 0;
+		std::exception_ptr error;
+		for(uint64_t i; (i = m_next_component++) < m_components.size();){
+			try{
+				for(uint64_t step=0; step<m_n_steps; ++step)
+					m_components[i]->update();
+			}catch(...){
+				if(!error)
+					error = std::current_exception();
+			}
+			++n_updated;
+		}
+
+		lock.lock();
+		if(error && !m_error)
+			m_error = error;
+
+		m_n_pending -= n_updated;
+		--m_n_active;
+		if(m_n_active == 0)
+			m_changed.notify_all();
+	}
+}
+
+} // end of namespace ug::graphics
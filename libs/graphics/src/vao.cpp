@@ -29,7 +29,10 @@ uint32_t vao::id() const
 	return m_id;
 }
 
-void vao::set_attribute_layout(const vao::attribute_layout& attributes) const
+void vao::set_attribute_layout(
+	const vao::attribute_layout& attributes,
+	uint32_t divisor,
+	uint64_t offset) const
 {
 	bind();
 	for(auto&& atribute : attributes){
@@ -39,9 +42,10 @@ void vao::set_attribute_layout(const vao::attribute_layout& attributes) const
 			atribute.type,
 			atribute.normalized?GL_TRUE:GL_FALSE,
 			static_cast<int32_t>(attributes.stride()),
-			reinterpret_cast<void*>(atribute.offset)
+			reinterpret_cast<void*>(offset + atribute.offset)
 		));
 		GL(glEnableVertexAttribArray(atribute.index));
+		GL(glVertexAttribDivisor(atribute.index, divisor));
 	}
 }
 
@@ -65,4 +69,54 @@ vao::attr<double>::attr(std::uint32_t a_n_member, bool a_normalized)
 		a_normalized)
 {}
 
+vao::attr<int8_t>::attr(uint32_t a_n_member, bool a_normalized)
+	: vao::attribute(
+		0,
+		sizeof(int8_t),
+		a_n_member,
+		GL_BYTE,
+		0,
+		a_normalized)
+{}
+
+vao::attr<uint8_t>::attr(uint32_t a_n_member, bool a_normalized)
+	: vao::attribute(
+		0,
+		sizeof(uint8_t),
+		a_n_member,
+		GL_UNSIGNED_BYTE,
+		0,
+		a_normalized)
+{}
+
+vao::attr<int16_t>::attr(uint32_t a_n_member, bool a_normalized)
+	: vao::attribute(
+		0,
+		sizeof(int16_t),
+		a_n_member,
+		GL_SHORT,
+		0,
+		a_normalized)
+{}
+
+vao::attr<uint16_t>::attr(uint32_t a_n_member, bool a_normalized)
+	: vao::attribute(
+		0,
+		sizeof(uint16_t),
+		a_n_member,
+		GL_UNSIGNED_SHORT,
+		0,
+		a_normalized)
+{}
+
+vao::attr<half_float>::attr(uint32_t a_n_member)
+	: vao::attribute(
+		0,
+		sizeof(half_float),
+		a_n_member,
+		GL_HALF_FLOAT,
+		0,
+		false)
+{}
+
 } // end of namespace ug::graphics
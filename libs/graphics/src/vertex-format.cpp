@@ -0,0 +1,155 @@
+#include "ug/graphics/vertex-format.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace ug::graphics{
+
+namespace{
+
+/**
+  * rounds to the nearest even half float, from "float->half variants"
+  * by F. Giesen
+  */
+uint16_t to_half_bits(float f)
+{
+	auto x = std::bit_cast<uint32_t>(f);
+	auto const sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+	x &= 0x7fffffff;
+
+	// infinities and NaNs, the NaNs stay quiet NaNs
+	if(x >= 0x7f800000)
+		return sign | (x > 0x7f800000 ? 0x7e00 : 0x7c00);
+
+	// too large for a half float
+	if(x >= 0x47800000)
+		return sign | 0x7c00;
+
+	// subnormal half floats, the addition of 0.5 rounds the mantissa
+	if(x < 0x38800000){
+		auto const r = std::bit_cast<float>(x) + 0.5f;
+		return sign | static_cast<uint16_t>(
+			std::bit_cast<uint32_t>(r) - 0x3f000000);
+	}
+
+	// rebias the exponent and round the mantissa to the nearest even
+	auto const odd = (x >> 13) & 1;
+	x += 0xc8000fff + odd;
+	return sign | static_cast<uint16_t>(x >> 13);
+}
+
+int16_t to_snorm16(float f)
+{
+	auto const v = std::min(1.f, std::max(-1.f, f))*32767.f;
+	return static_cast<int16_t>(v + (v < 0.f ? -0.5f : 0.5f));
+}
+
+} // end of anonymous namespace
+
+uint32_t vertex_format::position_size() const noexcept
+{
+	return position == position_format::float32
+		? 3*sizeof(float)
+		: 4*sizeof(uint16_t);
+}
+
+uint32_t vertex_format::normal_size() const noexcept
+{
+	return normal == normal_format::float32
+		? 3*sizeof(float)
+		: 2*sizeof(int16_t);
+}
+
+uint32_t vertex_format::color_size() const noexcept
+{
+	return color == color_format::float32
+		? 4*sizeof(float)
+		: 4*sizeof(uint8_t);
+}
+
+vao::attribute_layout vertex_format::attribute_layout() const
+{
+	auto with_color = [&](auto const& p, auto const& n)
+		-> vao::attribute_layout
+	{
+		if(color == color_format::unorm8)
+			return { p, n, vao::attr<uint8_t>{4, true} };
+		return { p, n, vao::attr<float>{4} };
+	};
+
+	auto with_normal = [&](auto const& p)
+	{
+		if(normal == normal_format::octahedral)
+			return with_color(p, vao::attr<int16_t>{2, true});
+		return with_color(p, vao::attr<float>{3});
+	};
+
+	switch(position){
+	case position_format::float16:
+		return with_normal(vao::attr<half_float>{4});
+	case position_format::snorm16:
+		return with_normal(vao::attr<int16_t>{4, true});
+	case position_format::float32:
+		break;
+	}
+
+	return with_normal(vao::attr<float>{3});
+}
+
+void encode_float16(std::span<float const> in, std::span<half_float> out)
+{
+	uint64_t i = 0;
+
+#if defined(__F16C__)
+	for(; i + 8<=in.size(); i += 8){
+		auto const h = _mm256_cvtps_ph(
+			_mm256_loadu_ps(in.data() + i),
+			_MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), h);
+	}
+#endif
+
+	for(; i<in.size(); ++i)
+		out[i] = half_float{ to_half_bits(in[i]) };
+}
+
+void encode_snorm16(std::span<float const> in, std::span<int16_t> out)
+{
+	for(uint64_t i=0; i<in.size(); ++i)
+		out[i] = to_snorm16(in[i]);
+}
+
+void encode_unorm8(std::span<float const> in, std::span<uint8_t> out)
+{
+	for(uint64_t i=0; i<in.size(); ++i){
+		auto const v = std::min(1.f, std::max(0.f, in[i]))*255.f;
+		out[i] = static_cast<uint8_t>(static_cast<int32_t>(v + 0.5f));
+	}
+}
+
+void encode_octahedral(
+	std::span<float const> x,
+	std::span<float const> y,
+	std::span<float const> z,
+	std::span<int16_t> out)
+{
+	for(uint64_t i=0; i<x.size(); ++i){
+		auto const l1 = std::abs(x[i]) + std::abs(y[i]) + std::abs(z[i]);
+		auto const u = x[i]/l1;
+		auto const v = y[i]/l1;
+
+		// the lower hemisphere is folded over the diagonals
+		auto const folded_u = (1.f - std::abs(v))*(u >= 0.f ? 1.f : -1.f);
+		auto const folded_v = (1.f - std::abs(u))*(v >= 0.f ? 1.f : -1.f);
+
+		out[2*i] = to_snorm16(z[i] < 0.f ? folded_u : u);
+		out[2*i + 1] = to_snorm16(z[i] < 0.f ? folded_v : v);
+	}
+}
+
+} // end of namespace ug::graphics
@@ -81,10 +81,15 @@ static void terminate_and_throw(char const* msg)
 static window_ptr create_window(
 	int32_t width,
 	int32_t height,
-	char const* window_title)
+	char const* window_title,
+	window_visibility visibility)
 {
 
 	glfwSetErrorCallback(error_callback);
+	glfwWindowHint(
+		GLFW_VISIBLE,
+		visibility == window_visibility::SHOWN ? GLFW_TRUE : GLFW_FALSE
+	);
 
 	auto w = window_ptr(
 		glfwCreateWindow(
@@ -130,8 +135,12 @@ window::context::~context()
  * window constructors and destructors
  * ================================
  */
-window::window(int32_t width, int32_t height, char const* window_title)
-	: m_window(create_window(width, height, window_title))
+window::window(
+	int32_t width,
+	int32_t height,
+	char const* window_title,
+	window_visibility visibility)
+	: m_window(create_window(width, height, window_title, visibility))
 {
 	// associate this aplication with the glfw window
 	glfwSetWindowUserPointer(ptr(), this);
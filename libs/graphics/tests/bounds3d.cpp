@@ -0,0 +1,167 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ug/graphics/bounds3d.hpp"
+
+namespace{
+
+enum plane_index{
+	LEFT_PLANE,
+	RIGHT_PLANE,
+	BOTTOM_PLANE,
+	TOP_PLANE,
+	NEAR_PLANE,
+	FAR_PLANE
+};
+
+/**
+  * a box outside of the frustum only through the plane `plane`, and a box
+  * across that plane
+  */
+struct plane_boxes{
+	int plane;
+	ug::graphics::aabb3d outside;
+	ug::graphics::aabb3d across;
+};
+
+ug::graphics::aabb3d make_box(glm::vec3 center, float extent)
+{
+	return { center - glm::vec3(extent), center + glm::vec3(extent) };
+}
+
+float distance(glm::vec4 const& plane, glm::vec3 const& p)
+{
+	return plane.x*p.x + plane.y*p.y + plane.z*p.z + plane.w;
+}
+
+/**
+  * whether `b` is entirely on the outer side of `plane`
+  */
+bool is_outside(glm::vec4 const& plane, ug::graphics::aabb3d const& b)
+{
+	auto const e = b.extent();
+	auto const r = std::abs(plane.x)*e.x + std::abs(plane.y)*e.y
+		+ std::abs(plane.z)*e.z;
+	return distance(plane, b.center()) + r < 0.f;
+}
+
+void check_frustum(
+	ug::graphics::frustum3d const& f,
+	ug::graphics::aabb3d const& inside,
+	std::vector<plane_boxes> const& cases)
+{
+	for(auto&& p : f.planes){
+		auto const l = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+		REQUIRE(std::abs(l - 1.f) <= 1e-6f);
+	}
+
+	ug::graphics::aabb3d_array boxes;
+	std::vector<uint8_t> expected;
+
+	REQUIRE(f.intersects(inside));
+	boxes.push_back(inside);
+	expected.push_back(1);
+
+	for(auto&& c : cases){
+		INFO("plane " << c.plane);
+
+		for(int k=0; k<6; ++k){
+			REQUIRE(is_outside(f.planes[k], c.outside) == (k == c.plane));
+			REQUIRE(!is_outside(f.planes[k], c.across));
+		}
+
+		// the center of the box across is closer than its corners
+		auto const d = distance(f.planes[c.plane], c.across.center());
+		REQUIRE(std::abs(d) < c.across.extent().x);
+
+		REQUIRE(!f.intersects(c.outside));
+		REQUIRE(f.intersects(c.across));
+
+		auto const e = c.outside.extent().x;
+		auto const s = ug::graphics::sphere3d{ c.outside.center(), e };
+		REQUIRE(!f.intersects(s));
+
+		boxes.push_back(c.outside);
+		expected.push_back(0);
+		boxes.push_back(c.across);
+		expected.push_back(1);
+	}
+
+	std::vector<uint8_t> visible(boxes.size(), 2);
+	REQUIRE(ug::graphics::cull(f, boxes, visible) == cases.size() + 1);
+	REQUIRE(visible == expected);
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("frustum3d of a perspective matrix", "[graphics][bounds3d]")
+{
+	// at the depth d the frustum is |x| <= d and |y| <= d, up to 10
+	auto const projection = glm::perspective(
+		glm::radians(90.f), 1.f, 1.f, 10.f);
+
+	ug::graphics::frustum3d const f{ projection };
+
+	// the planes through the eye are at 45 degrees
+	auto const s = std::sqrt(.5f);
+	glm::vec3 const p{ 0.f, 0.f, -5.f };
+	REQUIRE(std::abs(distance(f.planes[LEFT_PLANE], p) - 5.f*s) <= 1e-5f);
+	REQUIRE(std::abs(distance(f.planes[NEAR_PLANE], p) - 4.f) <= 1e-4f);
+	REQUIRE(std::abs(distance(f.planes[FAR_PLANE], p) - 5.f) <= 1e-4f);
+
+	check_frustum(f, make_box({ 0.f, 0.f, -5.f }, .5f), {
+		{ LEFT_PLANE, make_box({ -8.f, 0.f, -5.f }, .5f),
+			make_box({ -5.f, 0.f, -5.f }, .5f) },
+		{ RIGHT_PLANE, make_box({ 8.f, 0.f, -5.f }, .5f),
+			make_box({ 5.f, 0.f, -5.f }, .5f) },
+		{ BOTTOM_PLANE, make_box({ 0.f, -8.f, -5.f }, .5f),
+			make_box({ 0.f, -5.f, -5.f }, .5f) },
+		{ TOP_PLANE, make_box({ 0.f, 8.f, -5.f }, .5f),
+			make_box({ 0.f, 5.f, -5.f }, .5f) },
+		{ NEAR_PLANE, make_box({ 0.f, 0.f, 0.f }, .2f),
+			make_box({ 0.f, 0.f, -1.f }, .2f) },
+		{ FAR_PLANE, make_box({ 0.f, 0.f, -12.f }, .5f),
+			make_box({ 0.f, 0.f, -10.f }, .5f) },
+	});
+
+	SECTION("in the space of a model"){
+		// the model is moved by 100 along x, so the frustum is at -100
+		auto const model = glm::translate(glm::vec3{ 100.f, 0.f, 0.f });
+		ug::graphics::frustum3d const m{ projection*model };
+
+		REQUIRE(m.intersects(make_box({ -100.f, 0.f, -5.f }, .5f)));
+		REQUIRE(!m.intersects(make_box({ 0.f, 0.f, -5.f }, .5f)));
+	}
+}
+
+TEST_CASE("frustum3d of an orthographic matrix", "[graphics][bounds3d]")
+{
+	// the box x in [-2, 2], y in [-1, 1] and z in [-20, -0.5]
+	auto const projection = glm::ortho(-2.f, 2.f, -1.f, 1.f, .5f, 20.f);
+
+	ug::graphics::frustum3d const f{ projection };
+
+	glm::vec3 const p{ 0.f, 0.f, -5.f };
+	REQUIRE(std::abs(distance(f.planes[LEFT_PLANE], p) - 2.f) <= 1e-5f);
+	REQUIRE(std::abs(distance(f.planes[TOP_PLANE], p) - 1.f) <= 1e-5f);
+	REQUIRE(std::abs(distance(f.planes[NEAR_PLANE], p) - 4.5f) <= 1e-5f);
+	REQUIRE(std::abs(distance(f.planes[FAR_PLANE], p) - 15.f) <= 1e-5f);
+
+	check_frustum(f, make_box({ 0.f, 0.f, -5.f }, .5f), {
+		{ LEFT_PLANE, make_box({ -3.f, 0.f, -5.f }, .5f),
+			make_box({ -2.f, 0.f, -5.f }, .5f) },
+		{ RIGHT_PLANE, make_box({ 3.f, 0.f, -5.f }, .5f),
+			make_box({ 2.f, 0.f, -5.f }, .5f) },
+		{ BOTTOM_PLANE, make_box({ 0.f, -2.f, -5.f }, .5f),
+			make_box({ 0.f, -1.f, -5.f }, .5f) },
+		{ TOP_PLANE, make_box({ 0.f, 2.f, -5.f }, .5f),
+			make_box({ 0.f, 1.f, -5.f }, .5f) },
+		{ NEAR_PLANE, make_box({ 0.f, 0.f, 1.f }, .25f),
+			make_box({ 0.f, 0.f, -.5f }, .25f) },
+		{ FAR_PLANE, make_box({ 0.f, 0.f, -21.f }, .5f),
+			make_box({ 0.f, 0.f, -20.f }, .5f) },
+	});
+}
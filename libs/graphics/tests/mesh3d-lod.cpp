@@ -0,0 +1,299 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ug/graphics/mesh3d-lod.hpp"
+
+namespace{
+
+/**
+  * a closed sphere of radius 1 with `n` meridians and `n/2` parallels,
+  * indexed, with a vertex at each pole
+  */
+ug::graphics::mesh3d_indexed_data make_sphere(uint32_t n)
+{
+	ug::graphics::mesh3d_indexed_data sphere;
+	auto const pi = glm::pi<float>();
+	auto const rows = n/2;
+
+	auto add = [&](glm::vec3 p)
+	{
+		sphere.vertices.push_back({ p, p, { 1.f, 1.f, 1.f, 1.f } });
+	};
+
+	add({ 0.f, 0.f, 1.f });
+	for(uint32_t r=1; r<rows; ++r){
+		auto const theta = pi*static_cast<float>(r)/static_cast<float>(rows);
+		for(uint32_t c=0; c<n; ++c){
+			auto const phi =
+				2.f*pi*static_cast<float>(c)/static_cast<float>(n);
+			add({
+				std::sin(theta)*std::cos(phi),
+				std::sin(theta)*std::sin(phi),
+				std::cos(theta)
+			});
+		}
+	}
+	add({ 0.f, 0.f, -1.f });
+
+	auto const south = static_cast<uint32_t>(sphere.vertices.size() - 1);
+	auto ring = [&](uint32_t r, uint32_t c){ return 1 + (r - 1)*n + c%n; };
+
+	for(uint32_t c=0; c<n; ++c){
+		for(auto i : { 0U, ring(1, c), ring(1, c + 1) })
+			sphere.indices.push_back(i);
+
+		for(uint32_t r=1; r + 1<rows; ++r){
+			auto const a = ring(r, c);
+			auto const b = ring(r, c + 1);
+			auto const d = ring(r + 1, c);
+			auto const e = ring(r + 1, c + 1);
+			for(auto i : { a, d, e, a, e, b })
+				sphere.indices.push_back(i);
+		}
+
+		for(auto i : { ring(rows - 1, c), south, ring(rows - 1, c + 1) })
+			sphere.indices.push_back(i);
+	}
+
+	return sphere;
+}
+
+std::vector<ug::graphics::mesh3d_attributes_layout> to_soup(
+	ug::graphics::mesh3d_indexed_data const& data)
+{
+	std::vector<ug::graphics::mesh3d_attributes_layout> soup;
+	for(auto i : data.indices)
+		soup.push_back(data.vertices[i]);
+	return soup;
+}
+
+/**
+  * whether every triangle of `indices` faces away from the center of the
+  * sphere, as the triangles of `make_sphere` do
+  */
+bool faces_outwards(
+	std::vector<ug::graphics::mesh3d_attributes_layout> const& vertices,
+	std::vector<uint32_t> const& indices)
+{
+	for(uint64_t t=0; t + 3<=indices.size(); t += 3){
+		auto const& a = vertices[indices[t]].vertex;
+		auto const& b = vertices[indices[t + 1]].vertex;
+		auto const& c = vertices[indices[t + 2]].vertex;
+
+		auto const n = glm::cross(b - a, c - a);
+		if(glm::dot(n, a + b + c) <= 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+  * a path in the temporary directory that no other test run uses
+  */
+std::filesystem::path unique_temp_path(std::string const& name)
+{
+	auto const suffix = std::random_device{}();
+	return std::filesystem::temp_directory_path()
+		/ (name + "-" + std::to_string(suffix));
+}
+
+bool same_chain(
+	ug::graphics::mesh3d_lod_chain const& a,
+	ug::graphics::mesh3d_lod_chain const& b)
+{
+	if(a.vertices.size() != b.vertices.size()
+		|| a.levels.size() != b.levels.size())
+	{
+		return false;
+	}
+
+	for(uint64_t i=0; i<a.vertices.size(); ++i){
+		auto const& v = a.vertices[i];
+		auto const& w = b.vertices[i];
+		if(v.vertex != w.vertex || v.normal != w.normal || v.color != w.color)
+			return false;
+	}
+
+	for(uint64_t l=0; l<a.levels.size(); ++l){
+		if(a.levels[l].indices != b.levels[l].indices
+			|| a.levels[l].error != b.levels[l].error)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("mesh3d simplification of a sphere", "[graphics][mesh3d-lod]")
+{
+	auto const sphere = make_sphere(64);
+	uint64_t const n_triangles = sphere.indices.size()/3;
+	REQUIRE(faces_outwards(sphere.vertices, sphere.indices));
+
+	for(uint64_t target : {
+		n_triangles, n_triangles/2, uint64_t{ 500 }, uint64_t{ 100 } })
+	{
+		INFO(target);
+
+		auto const level = ug::graphics::simplify(
+			sphere.vertices, sphere.indices, target);
+
+		// the sphere is closed, so no vertex is locked on a border
+		REQUIRE(level.indices.size() % 3 == 0);
+		REQUIRE(level.indices.size()/3 <= target);
+		REQUIRE(level.indices.size()/3 >= target*9/10);
+		REQUIRE(faces_outwards(sphere.vertices, level.indices));
+
+		for(auto i : level.indices)
+			REQUIRE(i < sphere.vertices.size());
+
+		if(target == n_triangles)
+			REQUIRE(level.error == 0.f);
+		else
+			REQUIRE(level.error > 0.f);
+	}
+}
+
+TEST_CASE("mesh3d level of detail chain", "[graphics][mesh3d-lod]")
+{
+	auto const soup = to_soup(make_sphere(96));
+
+	ug::graphics::mesh3d_lod_options options;
+	options.min_triangles = 256;
+	options.cluster_triangles = 1024;
+	options.threads = 4;
+
+	auto const chain = ug::graphics::make_lod_chain(soup, options);
+
+	REQUIRE(chain.levels.size() > 2);
+	REQUIRE(chain.levels.size() <= options.max_levels);
+	REQUIRE(chain.levels.front().indices.size() == soup.size());
+	REQUIRE(chain.levels.front().error == 0.f);
+
+	for(uint64_t l=1; l<chain.levels.size(); ++l){
+		INFO(l);
+		auto const& previous = chain.levels[l - 1];
+		auto const& level = chain.levels[l];
+
+		REQUIRE(level.indices.size() < previous.indices.size());
+		REQUIRE(level.indices.size() >= options.min_triangles/2);
+		REQUIRE(level.error >= previous.error);
+		REQUIRE(faces_outwards(chain.vertices, level.indices));
+	}
+
+	SECTION("the number of threads does not change the chain"){
+		options.threads = 1;
+		auto const serial = ug::graphics::make_lod_chain(soup, options);
+		REQUIRE(same_chain(chain, serial));
+	}
+
+	SECTION("the options out of range"){
+		for(float reduction : { 0.f, 1.f, -0.5f, 1.5f,
+			std::numeric_limits<float>::quiet_NaN() })
+		{
+			auto o = options;
+			o.reduction = reduction;
+			REQUIRE_THROWS_AS(
+				ug::graphics::make_lod_chain(soup, o),
+				std::invalid_argument);
+		}
+
+		auto o = options;
+		o.threads = 0;
+		REQUIRE_THROWS_AS(
+			ug::graphics::make_lod_chain(soup, o),
+			std::invalid_argument);
+	}
+}
+
+TEST_CASE("mesh3d level of detail files", "[graphics][mesh3d-lod]")
+{
+	auto const soup = to_soup(make_sphere(48));
+
+	ug::graphics::mesh3d_lod_options options;
+	options.min_triangles = 256;
+
+	auto const chain = ug::graphics::make_lod_chain(soup, options);
+	auto const key = ug::graphics::lod_chain_key(soup, options);
+	auto const path = unique_temp_path("ug-graphics-lod-test");
+
+	ug::graphics::save_lod_chain(path, chain, key);
+
+	auto const loaded = ug::graphics::load_lod_chain(path, key);
+	REQUIRE(loaded.has_value());
+	REQUIRE(same_chain(chain, *loaded));
+
+	REQUIRE(!ug::graphics::load_lod_chain(path, key + 1));
+	REQUIRE(!ug::graphics::load_lod_chain(path.string() + ".none", key));
+
+	uint64_t const size = std::filesystem::file_size(path);
+	auto const copy = path.string() + ".copy";
+
+	// writes `bytes` at `offset` of a copy of the file
+	auto corrupt = [&](uint64_t offset, std::string const& bytes)
+	{
+		std::filesystem::copy_file(
+			path, copy, std::filesystem::copy_options::overwrite_existing);
+		std::fstream f(copy, std::ios::binary | std::ios::in | std::ios::out);
+		f.seekp(static_cast<std::streamoff>(offset));
+		f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	};
+
+	SECTION("truncated"){
+		for(uint64_t n : {
+			size - 1, size - 4, size/2, uint64_t{ 12 }, uint64_t{ 0 } })
+		{
+			INFO(n);
+			corrupt(0, "");
+			std::filesystem::resize_file(copy, n);
+			REQUIRE(!ug::graphics::load_lod_chain(copy, key));
+		}
+	}
+
+	SECTION("with trailing bytes"){
+		corrupt(size, "x");
+		REQUIRE(!ug::graphics::load_lod_chain(copy, key));
+	}
+
+	SECTION("corrupt"){
+		corrupt(0, "XX");
+		REQUIRE(!ug::graphics::load_lod_chain(copy, key));
+
+		// the last index of the last level, out of range
+		corrupt(size - 4, std::string(4, '\xff'));
+		REQUIRE(!ug::graphics::load_lod_chain(copy, key));
+
+		// the size of the vertices, larger than the file
+		corrupt(16, std::string(8, '\x7f'));
+		REQUIRE(!ug::graphics::load_lod_chain(copy, key));
+	}
+
+	SECTION("as a cache"){
+		auto const cache = unique_temp_path("ug-graphics-lod-cache-test");
+
+		auto const built = ug::graphics::make_lod_chain(soup, options, cache);
+		REQUIRE(std::filesystem::exists(cache));
+		REQUIRE(same_chain(chain, built));
+
+		auto const read = ug::graphics::make_lod_chain(soup, options, cache);
+		REQUIRE(same_chain(chain, read));
+
+		std::filesystem::remove(cache);
+	}
+
+	std::filesystem::remove(copy);
+	std::filesystem::remove(path);
+}
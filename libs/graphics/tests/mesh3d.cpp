@@ -0,0 +1,272 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "ug/graphics/mesh3d.hpp"
+
+namespace{
+
+ug::graphics::mesh3d_attributes_layout make_vertex(float x, float y, float z)
+{
+	return {
+		glm::vec3{ x, y, z },
+		glm::vec3{ 0.f, 0.f, 1.f },
+		ug::graphics::color4{ 1.f, 1.f, 1.f, 1.f }
+	};
+}
+
+/**
+  * a grid of `n`x`n` quads, two triangles each, numbered row by row
+  */
+ug::graphics::mesh3d_indexed_data make_grid(uint32_t n)
+{
+	ug::graphics::mesh3d_indexed_data grid;
+
+	for(uint32_t y=0; y<=n; ++y){
+		for(uint32_t x=0; x<=n; ++x){
+			grid.vertices.push_back(make_vertex(
+				static_cast<float>(x), static_cast<float>(y), 0.f));
+		}
+	}
+
+	for(uint32_t y=0; y<n; ++y){
+		for(uint32_t x=0; x<n; ++x){
+			auto const v = y*(n + 1) + x;
+			for(auto i : { v, v + 1, v + n + 2, v, v + n + 2, v + n + 1 })
+				grid.indices.push_back(i);
+		}
+	}
+
+	return grid;
+}
+
+/**
+  * the average number of vertices transformed per triangle with a FIFO
+  * post-transform cache of `cache_size` vertices
+  */
+double acmr(std::vector<uint32_t> const& indices, uint64_t cache_size)
+{
+	std::deque<uint32_t> cache;
+	uint64_t misses = 0;
+
+	for(auto i : indices){
+		if(std::ranges::find(cache, i) != cache.end())
+			continue;
+
+		++misses;
+		cache.push_back(i);
+		if(cache.size() > cache_size)
+			cache.pop_front();
+	}
+
+	return static_cast<double>(misses)
+		/static_cast<double>(indices.size()/3);
+}
+
+/**
+  * the triangles of `indices` as sorted triples, so they compare equal
+  * whatever vertex comes first
+  */
+std::multiset<std::array<uint32_t, 3>> triangles(
+	std::vector<uint32_t> const& indices)
+{
+	std::multiset<std::array<uint32_t, 3>> r;
+	for(uint64_t t=0; t + 3<=indices.size(); t += 3){
+		std::array<uint32_t, 3> tri{
+			indices[t], indices[t + 1], indices[t + 2] };
+		std::ranges::sort(tri);
+		r.insert(tri);
+	}
+	return r;
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("mesh3d welds the vertices of a triangle soup", "[graphics][mesh3d]")
+{
+	auto const eps = std::numeric_limits<float>::epsilon();
+
+	std::vector const soup{
+		make_vertex(0.f, 0.f, 0.f),
+		make_vertex(1.f, 0.f, 0.f),
+		make_vertex(0.f, 1.f, 0.f),
+
+		// -0 is the same position as 0
+		make_vertex(1.f, 0.f, -0.f),
+		make_vertex(1.f, 1.f, 0.f),
+		make_vertex(0.f, 1.f, 0.f),
+
+		// an epsilon apart is another vertex, the welding is exact
+		make_vertex(1.f + eps, 0.f, 0.f),
+		make_vertex(1.f, 1.f, 0.f),
+		make_vertex(2.f, 0.f, 0.f),
+	};
+
+	auto const data = ug::graphics::weld_vertices(soup);
+
+	REQUIRE(data.indices.size() == soup.size());
+	REQUIRE(data.vertices.size() == 6);
+
+	for(uint64_t i=0; i<soup.size(); ++i)
+		REQUIRE(data.vertices[data.indices[i]].vertex == soup[i].vertex);
+
+	REQUIRE(data.indices[3] == data.indices[1]);
+	REQUIRE(data.indices[5] == data.indices[2]);
+	REQUIRE(data.indices[7] == data.indices[4]);
+	REQUIRE(data.indices[6] != data.indices[1]);
+
+	SECTION("a different normal or color is another vertex"){
+		auto other = soup;
+		other[3].normal = glm::vec3{ 0.f, 1.f, 0.f };
+		other[5].color.a = 0.5f;
+
+		auto const d = ug::graphics::weld_vertices(other);
+		REQUIRE(d.vertices.size() == 8);
+		REQUIRE(d.indices[3] != d.indices[1]);
+		REQUIRE(d.indices[5] != d.indices[2]);
+	}
+
+	SECTION("the vertices of a shuffled grid"){
+		auto const grid = make_grid(20);
+
+		std::vector<ug::graphics::mesh3d_attributes_layout> grid_soup;
+		for(auto i : grid.indices)
+			grid_soup.push_back(grid.vertices[i]);
+		std::ranges::shuffle(grid_soup, std::mt19937{ 42 });
+
+		auto const welded = ug::graphics::weld_vertices(grid_soup);
+		REQUIRE(welded.vertices.size() == 21*21);
+	}
+}
+
+TEST_CASE("mesh3d remaps the vertices in the order of use", "[graphics][mesh3d]")
+{
+	auto grid = make_grid(8);
+
+	// an unused vertex, which the remapping removes
+	grid.vertices.push_back(make_vertex(-1.f, -1.f, -1.f));
+
+	std::vector<uint32_t> tris(grid.indices.size()/3);
+	std::iota(tris.begin(), tris.end(), 0U);
+	std::ranges::shuffle(tris, std::mt19937{ 7 });
+
+	std::vector<uint32_t> indices;
+	for(auto t : tris){
+		for(uint32_t k=0; k<3; ++k)
+			indices.push_back(grid.indices[3*t + k]);
+	}
+
+	auto vertices = grid.vertices;
+	auto remapped = indices;
+	ug::graphics::optimize_vertex_fetch(vertices, remapped);
+
+	REQUIRE(vertices.size() == 9*9);
+	REQUIRE(remapped.size() == indices.size());
+
+	uint32_t next = 0;
+	for(uint64_t i=0; i<indices.size(); ++i){
+		REQUIRE(vertices[remapped[i]].vertex
+			== grid.vertices[indices[i]].vertex);
+
+		// each index is either already seen or the next one
+		REQUIRE(remapped[i] <= next);
+		if(remapped[i] == next)
+			++next;
+	}
+}
+
+TEST_CASE("mesh3d vertex cache optimization", "[graphics][mesh3d]")
+{
+	auto const grid = make_grid(40);
+	auto const n_vertices = grid.vertices.size();
+
+	SECTION("the rows of a grid"){
+		auto indices = grid.indices;
+		ug::graphics::optimize_vertex_cache(indices, n_vertices);
+
+		REQUIRE(triangles(indices) == triangles(grid.indices));
+		REQUIRE(acmr(indices, 16) <= acmr(grid.indices, 16));
+		REQUIRE(acmr(indices, 32) <= acmr(grid.indices, 32));
+	}
+
+	SECTION("a shuffled grid"){
+		std::vector<uint32_t> tris(grid.indices.size()/3);
+		std::iota(tris.begin(), tris.end(), 0U);
+		std::ranges::shuffle(tris, std::mt19937{ 3 });
+
+		std::vector<uint32_t> shuffled;
+		for(auto t : tris){
+			for(uint32_t k=0; k<3; ++k)
+				shuffled.push_back(grid.indices[3*t + k]);
+		}
+
+		auto indices = shuffled;
+		ug::graphics::optimize_vertex_cache(indices, n_vertices);
+
+		REQUIRE(triangles(indices) == triangles(shuffled));
+		REQUIRE(acmr(indices, 16) < 0.5*acmr(shuffled, 16));
+	}
+}
+
+TEST_CASE("mesh3d clusters cover every triangle once", "[graphics][mesh3d]")
+{
+	auto const grid = make_grid(30);
+
+	for(uint32_t cluster_triangles : { 1U, 64U, 256U, 10000U }){
+		INFO(cluster_triangles);
+
+		auto indices = grid.indices;
+		auto const clusters = ug::graphics::make_clusters(
+			grid.vertices, indices, cluster_triangles);
+
+		REQUIRE(triangles(indices) == triangles(grid.indices));
+
+		uint64_t next = 0;
+		for(auto&& c : clusters){
+			REQUIRE(c.first_index == next);
+			REQUIRE(c.n_indices % 3 == 0);
+			REQUIRE(c.n_indices > 0);
+			REQUIRE(c.n_indices <= 3*cluster_triangles);
+			next += c.n_indices;
+		}
+		REQUIRE(next == indices.size());
+
+		auto const n_triangles = grid.indices.size()/3;
+		REQUIRE(clusters.size()
+			== (n_triangles + cluster_triangles - 1)/cluster_triangles);
+	}
+
+	std::vector<uint32_t> none;
+	REQUIRE(ug::graphics::make_clusters(grid.vertices, none, 64).empty());
+}
+
+TEST_CASE("mesh3d line indices hold each edge once", "[graphics][mesh3d]")
+{
+	// two triangles sharing the edge 1-2, and a degenerate one
+	std::vector<uint32_t> const indices{ 0, 1, 2, 2, 1, 3, 4, 4, 5 };
+
+	auto const lines = ug::graphics::make_line_indices(indices);
+
+	std::vector<std::array<uint32_t, 2>> edges;
+	for(uint64_t i=0; i<lines.size(); i += 2)
+		edges.push_back({ lines[i], lines[i + 1] });
+
+	REQUIRE(edges == std::vector<std::array<uint32_t, 2>>{
+		{ 0, 1 }, { 0, 2 }, { 1, 2 }, { 1, 3 }, { 2, 3 }, { 4, 5 } });
+
+	SECTION("a grid has the edges of its quads and their diagonals"){
+		uint32_t const n = 10;
+		auto const grid = make_grid(n);
+		REQUIRE(ug::graphics::make_line_indices(grid.indices).size()
+			== 2*(2*n*(n + 1) + n*n));
+	}
+}
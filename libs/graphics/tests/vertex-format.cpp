@@ -0,0 +1,249 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ug/graphics/vertex-format.hpp"
+
+namespace{
+
+/**
+  * the float read by OpenGL from the bits of a half float
+  */
+float from_half_bits(uint16_t h)
+{
+	auto const sign = (h & 0x8000) ? -1.f : 1.f;
+	auto const exponent = (h >> 10) & 0x1f;
+	auto const mantissa = static_cast<float>(h & 0x3ff);
+
+	if(exponent == 0)
+		return sign*std::ldexp(mantissa, -24);
+
+	if(exponent == 0x1f){
+		return mantissa == 0.f
+			? sign*std::numeric_limits<float>::infinity()
+			: std::numeric_limits<float>::quiet_NaN();
+	}
+
+	return sign*std::ldexp(1024.f + mantissa, exponent - 25);
+}
+
+std::vector<uint16_t> to_half(std::vector<float> const& in)
+{
+	std::vector<ug::graphics::half_float> out(in.size());
+	ug::graphics::encode_float16(in, out);
+
+	std::vector<uint16_t> bits;
+	for(auto h : out)
+		bits.push_back(h.bits);
+	return bits;
+}
+
+uint16_t to_half(float f)
+{
+	return to_half(std::vector{ f }).front();
+}
+
+float from_snorm16(int16_t s)
+{
+	return std::max(static_cast<float>(s)/32767.f, -1.f);
+}
+
+/**
+  * the normal of the octahedral encoding `u`, `v`, normalized
+  */
+glm::vec3 from_octahedral(int16_t a, int16_t b)
+{
+	auto u = from_snorm16(a);
+	auto v = from_snorm16(b);
+	auto const z = 1.f - std::abs(u) - std::abs(v);
+
+	if(z < 0.f){
+		auto const folded_u = (1.f - std::abs(v))*(u >= 0.f ? 1.f : -1.f);
+		auto const folded_v = (1.f - std::abs(u))*(v >= 0.f ? 1.f : -1.f);
+		u = folded_u;
+		v = folded_v;
+	}
+
+	return glm::normalize(glm::vec3{ u, v, z });
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("float16 encoding", "[graphics][vertex-format]")
+{
+	SECTION("every finite half float round-trips"){
+		std::vector<float> in;
+		std::vector<uint16_t> expected;
+		for(uint32_t h=0; h<0x10000; ++h){
+			if((h & 0x7c00) == 0x7c00)
+				continue;
+
+			in.push_back(from_half_bits(static_cast<uint16_t>(h)));
+			expected.push_back(static_cast<uint16_t>(h));
+		}
+
+		REQUIRE(to_half(in) == expected);
+	}
+
+	SECTION("the floats between two half floats round to the nearest even"){
+		std::vector<float> in;
+		std::vector<uint16_t> expected;
+		for(uint16_t h=0; h<0x7bff; ++h){
+			auto const lo = from_half_bits(h);
+			auto const hi = from_half_bits(static_cast<uint16_t>(h + 1));
+			auto const mid = lo + (hi - lo)/2.f;
+
+			in.push_back(mid);
+			expected.push_back(h % 2 == 0 ? h : static_cast<uint16_t>(h + 1));
+
+			in.push_back(std::nextafter(mid, lo));
+			expected.push_back(h);
+
+			in.push_back(std::nextafter(mid, hi));
+			expected.push_back(static_cast<uint16_t>(h + 1));
+		}
+
+		REQUIRE(to_half(in) == expected);
+	}
+
+	SECTION("random floats are within half a step"){
+		std::mt19937 gen{ 11 };
+		std::uniform_real_distribution<float> dist{ -60000.f, 60000.f };
+
+		std::vector<float> in(4099);
+		for(auto& f : in)
+			f = dist(gen);
+
+		auto const out = to_half(in);
+		for(uint64_t i=0; i<in.size(); ++i){
+			auto const error = std::abs(from_half_bits(out[i]) - in[i]);
+			REQUIRE(error <= std::abs(in[i])*0x1p-11f);
+		}
+	}
+
+	SECTION("denormals"){
+		REQUIRE(to_half(0x1p-24f) == 0x0001);
+		REQUIRE(to_half(-0x1p-24f) == 0x8001);
+		REQUIRE(to_half(0x1p-25f) == 0x0000);
+		REQUIRE(to_half(0x1.8p-25f) == 0x0001);
+		REQUIRE(to_half(0x1p-14f - 0x1p-24f) == 0x03ff);
+		REQUIRE(to_half(0x1p-14f) == 0x0400);
+		REQUIRE(to_half(0x1p-30f) == 0x0000);
+		REQUIRE(to_half(-0.f) == 0x8000);
+		REQUIRE(to_half(std::numeric_limits<float>::denorm_min()) == 0);
+	}
+
+	SECTION("infinities, NaNs and overflows"){
+		auto const inf = std::numeric_limits<float>::infinity();
+
+		REQUIRE(to_half(inf) == 0x7c00);
+		REQUIRE(to_half(-inf) == 0xfc00);
+
+		auto const nan = to_half(std::numeric_limits<float>::quiet_NaN());
+		REQUIRE((nan & 0x7c00) == 0x7c00);
+		REQUIRE((nan & 0x03ff) != 0);
+
+		REQUIRE(to_half(65504.f) == 0x7bff);
+		REQUIRE(to_half(65519.f) == 0x7bff);
+		REQUIRE(to_half(65520.f) == 0x7c00);
+		REQUIRE(to_half(65536.f) == 0x7c00);
+		REQUIRE(to_half(1e10f) == 0x7c00);
+		REQUIRE(to_half(-1e10f) == 0xfc00);
+		REQUIRE(to_half(std::numeric_limits<float>::max()) == 0x7c00);
+	}
+}
+
+TEST_CASE("snorm16 and unorm8 encodings", "[graphics][vertex-format]")
+{
+	std::vector<float> in;
+	for(int i=-1100; i<=1100; ++i)
+		in.push_back(static_cast<float>(i)/1000.f);
+
+	std::vector<int16_t> snorm(in.size());
+	ug::graphics::encode_snorm16(in, snorm);
+
+	std::vector<uint8_t> unorm(in.size());
+	ug::graphics::encode_unorm8(in, unorm);
+
+	for(uint64_t i=0; i<in.size(); ++i){
+		auto const s = std::clamp(in[i], -1.f, 1.f);
+		REQUIRE(std::abs(from_snorm16(snorm[i]) - s)
+			<= 0.5f/32767.f + 1e-7f);
+
+		auto const u = std::clamp(in[i], 0.f, 1.f);
+		REQUIRE(std::abs(static_cast<float>(unorm[i])/255.f - u)
+			<= 0.5f/255.f + 1e-7f);
+	}
+
+	REQUIRE(snorm.front() == -32767);
+	REQUIRE(snorm.back() == 32767);
+	REQUIRE(unorm.front() == 0);
+	REQUIRE(unorm.back() == 255);
+}
+
+TEST_CASE("octahedral normal encoding", "[graphics][vertex-format]")
+{
+	// the worst angle between a normal and its decoding, 0.04 degrees
+	auto const min_cos = std::cos(0.04f*glm::pi<float>()/180.f);
+
+	auto check = [&](std::vector<glm::vec3> const& normals)
+	{
+		std::vector<float> x, y, z;
+		for(auto n : normals){
+			x.push_back(n.x);
+			y.push_back(n.y);
+			z.push_back(n.z);
+		}
+
+		std::vector<int16_t> out(2*normals.size());
+		ug::graphics::encode_octahedral(x, y, z, out);
+
+		for(uint64_t i=0; i<normals.size(); ++i){
+			auto const decoded = from_octahedral(out[2*i], out[2*i + 1]);
+			INFO(normals[i].x << " " << normals[i].y << " " << normals[i].z);
+			REQUIRE(glm::dot(decoded, glm::normalize(normals[i])) >= min_cos);
+		}
+
+		return out;
+	};
+
+	SECTION("the axes and the poles"){
+		auto const out = check({
+			{ 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f },
+			{ 0.f, 1.f, 0.f }, { 0.f, -1.f, 0.f },
+			{ 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f },
+			{ 0.f, 0.f, 7.f }, { 0.f, 0.f, -0.5f },
+		});
+
+		REQUIRE(out[0] == 32767);
+		REQUIRE(out[1] == 0);
+		REQUIRE(out[2] == -32767);
+		REQUIRE(out[3] == 0);
+		REQUIRE(out[8] == 0);
+		REQUIRE(out[9] == 0);
+
+		// the south pole is any corner of the square
+		REQUIRE(std::abs(out[10]) == 32767);
+		REQUIRE(std::abs(out[11]) == 32767);
+	}
+
+	SECTION("random normals of any length"){
+		std::mt19937 gen{ 5 };
+		std::normal_distribution<float> dist{ 0.f, 3.f };
+
+		std::vector<glm::vec3> normals(10000);
+		for(auto& n : normals){
+			do{
+				n = glm::vec3{ dist(gen), dist(gen), dist(gen) };
+			}while(glm::length(n) < 1e-3f);
+		}
+
+		check(normals);
+	}
+}
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+#include "util/static-vector.hpp"
+#include "ia/interval.hpp"
+#include "ia/scoped-round-mode.hpp"
+
+/** @file affine.hpp
+  * affine arithmetic: a value is represented by the form
+  *
+  *     x0 + x1*e1 + x2*e2 + ... + xn*en
+  *
+  * where the noise symbols ei are unknowns in [-1, 1] shared by all the
+  * forms derived from the same inputs, so the correlation between the
+  * operands is kept and, for instance, x - x is exactly zero, which
+  * reduces the overestimation of long expressions of intervals.
+  *
+  * every coefficient is computed with downward and upward rounding and the
+  * difference is added to a new noise symbol, as well as the error of the
+  * nonlinear approximations, so the forms are rigorous enclosures.
+  */
+
+namespace ia{
+
+namespace detail{
+
+/// @return a noise symbol never returned before
+inline uint64_t new_noise_symbol()
+{
+	static std::atomic<uint64_t> next = 0;
+	return next++;
+}
+
+} // end of namespace detail
+
+/**
+  * an affine form with at most `MaxSymbols` noise symbols; when an operation
+  * results in more symbols, the ones with the smallest coefficients are
+  * condensed in a single new symbol, so the memory of a form is fixed and
+  * no allocation is done
+  */
+template<std::floating_point T, std::size_t MaxSymbols = 16>
+class affine{
+public:
+
+	static_assert(MaxSymbols >= 2, "affine forms need at least two symbols");
+
+	struct term {
+		uint64_t symbol;
+		T coefficient;
+	};
+
+	static constexpr auto max_symbols = MaxSymbols;
+
+	explicit affine(T scalar = T{0}) noexcept
+		: m_center(scalar)
+	{}
+
+	/**
+	  * form of the interval `x`; its midpoint plus its half width times a new
+	  * noise symbol. `x` must be finite and not empty
+	  */
+	explicit affine(interval<T> const& x)
+		: m_center(x.midpoint())
+	{
+		if(x.is_empty()){
+			throw std::runtime_error(
+				"affine form of an empty interval"
+			);
+		}
+
+		auto const r = x.half_width();
+		if(r != T{0})
+			m_terms.push_back(term{ detail::new_noise_symbol(), r });
+	}
+
+	T center() const noexcept
+	{
+		return m_center;
+	}
+
+	std::span<term const> terms() const noexcept
+	{
+		return { m_terms.begin(), m_terms.size() };
+	}
+
+	/// @return upper bound of the sum of the absolute coefficients
+	T radius() const
+	{
+		return execute_upward([this]{
+			auto r = T{0};
+			for(auto&& t : m_terms)
+				r += std::fabs(t.coefficient);
+			return r;
+		});
+	}
+
+	interval<T> to_interval() const
+	{
+		auto const r = radius();
+
+		return interval<T>{
+			execute_downward([&]{ return m_center - r; }),
+			execute_upward([&]{ return m_center + r; })
+		};
+	}
+
+	/**
+	  * computes `alpha*a + beta*b + gamma` plus `delta` times a new noise
+	  * symbol; the rounding errors are added to `delta`
+	  */
+	static affine combine(
+		T alpha, affine const& a,
+		T beta, affine const& b,
+		T gamma, T delta);
+
+	template<std::floating_point U, std::size_t M>
+	friend affine<U, M> operator*(affine<U, M> const& a, affine<U, M> const& b);
+
+private:
+
+	/// terms of the intermediate results, before the condensation
+	using wide_terms = util::static_vector<term, 2*MaxSymbols + 1>;
+
+	void assign_condensed(wide_terms& terms);
+
+	T m_center;
+
+	/// the terms sorted by symbol
+	util::static_vector<term, MaxSymbols> m_terms;
+};
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> affine<T, M>::combine(
+	T alpha, affine const& a,
+	T beta, affine const& b,
+	T gamma, T delta)
+{
+	struct operand {
+		uint64_t symbol;
+		T x;
+		T y;
+	};
+
+	std::array<operand, 2*M> merged;
+	std::size_t n = 0;
+
+	auto it_a = a.m_terms.begin(), a_end = a.m_terms.end();
+	auto it_b = b.m_terms.begin(), b_end = b.m_terms.end();
+
+	while(it_a != a_end || it_b != b_end){
+		if(it_b == b_end || (it_a != a_end && it_a->symbol < it_b->symbol)){
+			merged[n++] = operand{ it_a->symbol, it_a->coefficient, T{0} };
+			++it_a;
+		}else if(it_a == a_end || it_b->symbol < it_a->symbol){
+			merged[n++] = operand{ it_b->symbol, T{0}, it_b->coefficient };
+			++it_b;
+		}else{
+			merged[n++] = operand{ it_a->symbol, it_a->coefficient, it_b->coefficient };
+			++it_a;
+			++it_b;
+		}
+	}
+
+	std::array<T, 2*M> lo;
+
+	auto const center_lo = execute_downward([&]{
+		for(std::size_t i=0; i<n; ++i)
+			lo[i] = alpha*merged[i].x + beta*merged[i].y;
+
+		return alpha*a.m_center + beta*b.m_center + gamma;
+	});
+
+	auto const error = execute_upward([&]{
+		auto e = delta;
+
+		for(std::size_t i=0; i<n; ++i)
+			e += (alpha*merged[i].x + beta*merged[i].y) - lo[i];
+
+		e += (alpha*a.m_center + beta*b.m_center + gamma) - center_lo;
+		return e;
+	});
+
+	affine r{ center_lo };
+
+	wide_terms terms;
+	for(std::size_t i=0; i<n; ++i){
+		if(lo[i] != T{0})
+			terms.push_back(term{ merged[i].symbol, lo[i] });
+	}
+
+	if(error != T{0})
+		terms.push_back(term{ detail::new_noise_symbol(), error });
+
+	r.assign_condensed(terms);
+	return r;
+}
+
+template<std::floating_point T, std::size_t M>
+void affine<T, M>::assign_condensed(wide_terms& terms)
+{
+	m_terms.clear();
+
+	if(terms.size() <= M){
+		for(auto&& t : terms)
+			m_terms.push_back(t);
+		return;
+	}
+
+	// keeps the M - 1 largest coefficients and condenses the others
+	std::array<std::size_t, 2*M + 1> order;
+	std::iota(order.begin(), order.begin() + terms.size(), std::size_t{0});
+
+	std::ranges::nth_element(
+		order.begin(),
+		order.begin() + (M - 1),
+		order.begin() + terms.size(),
+		std::greater<T>{},
+		[&terms](auto i){ return std::fabs(terms[i].coefficient); }
+	);
+
+	std::sort(order.begin(), order.begin() + (M - 1));
+
+	auto const condensed = execute_upward([&]{
+		auto c = T{0};
+		for(auto i = M - 1; i<terms.size(); ++i)
+			c += std::fabs(terms[order[i]].coefficient);
+		return c;
+	});
+
+	for(std::size_t i=0; i<M - 1; ++i)
+		m_terms.push_back(terms[order[i]]);
+
+	m_terms.push_back(term{ detail::new_noise_symbol(), condensed });
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator-(affine<T, M> const& a)
+{
+	return affine<T, M>::combine(T{-1}, a, T{0}, a, T{0}, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator+(affine<T, M> const& a, affine<T, M> const& b)
+{
+	return affine<T, M>::combine(T{1}, a, T{1}, b, T{0}, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator-(affine<T, M> const& a, affine<T, M> const& b)
+{
+	return affine<T, M>::combine(T{1}, a, T{-1}, b, T{0}, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator+(affine<T, M> const& a, T scalar)
+{
+	return affine<T, M>::combine(T{1}, a, T{0}, a, scalar, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator-(affine<T, M> const& a, T scalar)
+{
+	return affine<T, M>::combine(T{1}, a, T{0}, a, -scalar, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator*(affine<T, M> const& a, T scalar)
+{
+	return affine<T, M>::combine(scalar, a, T{0}, a, T{0}, T{0});
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator*(T scalar, affine<T, M> const& a)
+{
+	return a*scalar;
+}
+
+/**
+  * the product is x0*y0 + sum(x0*yi + y0*xi)ei and the quadratic terms are
+  * bounded by radius(x)*radius(y) in a new noise symbol
+  */
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator*(affine<T, M> const& a, affine<T, M> const& b)
+{
+	auto const delta = execute_upward([&]{
+		return a.radius()*b.radius();
+	});
+
+	affine<T, M> noise_a = a, noise_b = b;
+	noise_a.m_center = T{0};
+	noise_b.m_center = T{0};
+
+	auto const center = interval<T>{ a.center() }*interval<T>{ b.center() };
+
+	auto r = affine<T, M>::combine(
+		b.center(), noise_a,
+		a.center(), noise_b,
+		center.lo(),
+		execute_upward([&]{ return delta + (center.hi() - center.lo()); })
+	);
+
+	return r;
+}
+
+namespace detail{
+
+/**
+  * min-range affine approximation of 1/x for x in [lo, hi], 0 < lo:
+  * 1/x = alpha*x + zeta +- delta
+  */
+template<class T>
+auto reciprocal_approximation(T lo, T hi)
+{
+	// |alpha| <= 1/hi^2 makes 1/x - alpha*x decreasing in [lo, hi]
+	auto const abs_alpha = execute_downward([&]{
+		return T{1}/execute_upward([&]{ return hi*hi; });
+	});
+
+	auto const g_lo = execute_downward([&]{ return T{1}/hi + abs_alpha*hi; });
+	auto const g_hi = execute_upward([&]{ return T{1}/lo + abs_alpha*lo; });
+
+	return std::tuple{ -abs_alpha, g_lo, g_hi };
+}
+
+/**
+  * min-range affine approximation of sqrt(x) for x in [lo, hi], 0 <= lo:
+  * sqrt(x) = alpha*x + zeta +- delta
+  */
+template<class T>
+auto sqrt_approximation(T lo, T hi)
+{
+	// alpha <= 1/(2 sqrt(hi)) makes sqrt(x) - alpha*x increasing in [lo, hi]
+	auto const alpha = execute_downward([&]{
+		return T{1}/execute_upward([&]{ return T{2}*std::sqrt(hi); });
+	});
+
+	auto const g_lo = execute_downward([&]{
+		return std::sqrt(lo) - execute_upward([&]{ return alpha*lo; });
+	});
+
+	auto const g_hi = execute_upward([&]{
+		return std::sqrt(hi) - execute_downward([&]{ return alpha*hi; });
+	});
+
+	return std::tuple{ alpha, g_lo, g_hi };
+}
+
+/**
+  * @return alpha*a + (g_lo + g_hi)/2 +- (g_hi - g_lo)/2
+  */
+template<class T, std::size_t M>
+affine<T, M> apply_approximation(affine<T, M> const& a, T alpha, T g_lo, T g_hi)
+{
+	auto const zeta = g_lo + (g_hi - g_lo)/T{2};
+	auto const delta = execute_upward([&]{
+		return std::max(zeta - g_lo, g_hi - zeta);
+	});
+
+	return affine<T, M>::combine(alpha, a, T{0}, a, zeta, delta);
+}
+
+} // end of namespace detail
+
+/**
+  * @throws std::runtime_error if the range of `b` contains zero
+  */
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator/(affine<T, M> const& a, affine<T, M> const& b)
+{
+	auto const x = b.to_interval();
+
+	if(x.lo() <= T{0} && x.hi() >= T{0}){
+		throw std::runtime_error(
+			"affine division by a form whose range contains zero"
+		);
+	}
+
+	if(x.lo() > T{0}){
+		auto [ alpha, g_lo, g_hi ] = detail::reciprocal_approximation(
+			x.lo(),
+			x.hi()
+		);
+
+		return a*detail::apply_approximation(b, alpha, g_lo, g_hi);
+	}
+
+	// 1/x = -1/(-x)
+	auto [ alpha, g_lo, g_hi ] = detail::reciprocal_approximation(
+		-x.hi(),
+		-x.lo()
+	);
+
+	return a*detail::apply_approximation(b, alpha, -g_hi, -g_lo);
+}
+
+template<std::floating_point T, std::size_t M>
+affine<T, M> operator/(affine<T, M> const& a, T scalar)
+{
+	return a/affine<T, M>{ scalar };
+}
+
+/**
+  * the negative part of the range of `a` is ignored, as in the sqrt of
+  * intervals
+  *
+  * @throws std::runtime_error if the range of `a` is negative
+  */
+template<std::floating_point T, std::size_t M>
+affine<T, M> sqrt(affine<T, M> const& a)
+{
+	auto const x = a.to_interval();
+
+	if(x.hi() < T{0}){
+		throw std::runtime_error(
+			"sqrt of an affine form with negative range"
+		);
+	}
+
+	if(x.hi() == T{0})
+		return affine<T, M>{ T{0} };
+
+	auto [ alpha, g_lo, g_hi ] = detail::sqrt_approximation(
+		std::max(x.lo(), T{0}),
+		x.hi()
+	);
+
+	return detail::apply_approximation(a, alpha, g_lo, g_hi);
+}
+
+template<std::floating_point T, std::size_t M>
+auto& operator+=(affine<T, M>& a, affine<T, M> const& b)
+{
+	return a = a + b;
+}
+
+template<std::floating_point T, std::size_t M>
+auto& operator-=(affine<T, M>& a, affine<T, M> const& b)
+{
+	return a = a - b;
+}
+
+template<std::floating_point T, std::size_t M>
+auto& operator*=(affine<T, M>& a, affine<T, M> const& b)
+{
+	return a = a * b;
+}
+
+template<std::floating_point T, std::size_t M>
+auto& operator/=(affine<T, M>& a, affine<T, M> const& b)
+{
+	return a = a / b;
+}
+
+template<std::floating_point T, std::size_t M>
+interval<T> to_interval(affine<T, M> const& a)
+{
+	return a.to_interval();
+}
+
+} // end of namespace ia
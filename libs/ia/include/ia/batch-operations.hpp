@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+
+#include "ia/interval.hpp"
+#include "ia/scoped-round-mode.hpp"
+
+/** @file batch-operations.hpp
+  * array-level interval arithmetic. the scalar operators of `interval`
+  * switch the round mode for every bound they compute; the functions in
+  * this file split the spans in chunks of `batch_chunk_size` elements and
+  * compute every lower bound of a chunk in a single downward scope and
+  * every upper bound in a single upward scope.
+  *
+  * the results are bit-identical to the scalar operators
+  */
+
+namespace ia{
+
+/// number of elements computed inside the same round mode scope
+inline constexpr std::size_t batch_chunk_size = 256;
+
+namespace detail{
+
+template<class T>
+constexpr auto division_lo_operands(interval<T> const& a, interval<T> const& b)
+{
+	if(b.lo() >= T{0}){
+		if(a.lo() >= T{0})
+			return std::tuple{ a.lo(), b.hi() };
+		else if(a.hi() <= T{0})
+			return std::tuple{ a.lo(), b.lo() };
+		else
+			return std::tuple{ a.lo(), b.lo() };
+	}
+
+	if(a.lo() >= T{0})
+		return std::tuple{ a.hi(), b.hi() };
+	else if(a.hi() <= T{0})
+		return std::tuple{ a.hi(), b.lo() };
+	else
+		return std::tuple{ a.hi(), b.hi() };
+}
+
+template<class T>
+constexpr auto division_hi_operands(interval<T> const& a, interval<T> const& b)
+{
+	if(b.lo() >= T{0}){
+		if(a.lo() >= T{0})
+			return std::tuple{ a.hi(), b.lo() };
+		else if(a.hi() <= T{0})
+			return std::tuple{ a.hi(), b.hi() };
+		else
+			return std::tuple{ a.hi(), b.lo() };
+	}
+
+	if(a.lo() >= T{0})
+		return std::tuple{ a.lo(), b.lo() };
+	else if(a.hi() <= T{0})
+		return std::tuple{ a.lo(), b.hi() };
+	else
+		return std::tuple{ a.lo(), b.hi() };
+}
+
+template<class T>
+void check_batch_sizes(
+	std::span<interval<T> const> a,
+	std::span<interval<T> const> b,
+	std::span<interval<T>> out)
+{
+	if(a.size() != b.size() || a.size() != out.size()){
+		throw std::runtime_error(
+			"interval batch operation with spans of different sizes"
+		);
+	}
+}
+
+/**
+  * applies a batch operation chunk by chunk; `lower` computes the lower
+  * bound of the i-th element and runs in downward round mode; `result`
+  * receives the i-th element and its lower bound, and runs in upward round
+  * mode. the lower bounds are kept in a buffer, so `out` is only written
+  * after the inputs of the same element are read, which allows `out` to be
+  * one of the inputs
+  */
+template<class T, class FnLower, class FnResult>
+void apply_in_chunks(
+	std::size_t size,
+	std::span<interval<T>> out,
+	FnLower lower,
+	FnResult result)
+{
+	std::array<T, batch_chunk_size> lo;
+
+	for(std::size_t first = 0; first < size; first += batch_chunk_size){
+		auto const n = std::min(batch_chunk_size, size - first);
+
+		execute_downward([&]{
+			for(std::size_t i=0; i<n; ++i)
+				lo[i] = lower(first + i);
+		});
+
+		execute_upward([&]{
+			for(std::size_t i=0; i<n; ++i)
+				out[first + i] = result(first + i, lo[i]);
+		});
+	}
+}
+
+} // end of namespace detail
+
+/**
+  * computes `out[i] = a[i] + b[i]` for every i
+  *
+  * @throws std::runtime_error if the spans have different sizes
+  */
+template<class T>
+void add(
+	std::span<interval<T> const> a,
+	std::span<interval<T> const> b,
+	std::span<interval<T>> out)
+{
+	detail::check_batch_sizes(a, b, out);
+
+	auto lower = [&](std::size_t i)
+	{
+		return a[i].lo() + b[i].lo();
+	};
+
+	auto result = [&](std::size_t i, T lo)
+	{
+		if(a[i].is_empty() || b[i].is_empty())
+			return interval<T>::empty();
+
+		return interval<T>{ lo, a[i].hi() + b[i].hi() };
+	};
+
+	detail::apply_in_chunks(a.size(), out, lower, result);
+}
+
+/**
+  * computes `out[i] = a[i] - b[i]` for every i
+  *
+  * @throws std::runtime_error if the spans have different sizes
+  */
+template<class T>
+void sub(
+	std::span<interval<T> const> a,
+	std::span<interval<T> const> b,
+	std::span<interval<T>> out)
+{
+	detail::check_batch_sizes(a, b, out);
+
+	auto lower = [&](std::size_t i)
+	{
+		return a[i].lo() + -b[i].hi();
+	};
+
+	auto result = [&](std::size_t i, T lo)
+	{
+		if(a[i].is_empty() || interval<T>{ -b[i].hi(), -b[i].lo() }.is_empty())
+			return interval<T>::empty();
+
+		return interval<T>{ lo, a[i].hi() + -b[i].lo() };
+	};
+
+	detail::apply_in_chunks(a.size(), out, lower, result);
+}
+
+/**
+  * computes `out[i] = a[i] * b[i]` for every i
+  *
+  * @throws std::runtime_error if the spans have different sizes
+  */
+template<class T>
+void mul(
+	std::span<interval<T> const> a,
+	std::span<interval<T> const> b,
+	std::span<interval<T>> out)
+{
+	detail::check_batch_sizes(a, b, out);
+
+	auto lower = [&](std::size_t i)
+	{
+		return std::min({
+			a[i].lo()*b[i].lo(),
+			a[i].lo()*b[i].hi(),
+			a[i].hi()*b[i].lo(),
+			a[i].hi()*b[i].hi()
+		});
+	};
+
+	auto result = [&](std::size_t i, T lo)
+	{
+		if(a[i].is_empty() || b[i].is_empty())
+			return interval<T>::empty();
+
+		if(a[i] == T{0} || b[i] == T{0})
+			return interval<T>{ T{0.0}, T{0.0} };
+
+		return interval<T>{
+			lo,
+			std::max({
+				a[i].lo()*b[i].lo(),
+				a[i].lo()*b[i].hi(),
+				a[i].hi()*b[i].lo(),
+				a[i].hi()*b[i].hi()
+			})
+		};
+	};
+
+	detail::apply_in_chunks(a.size(), out, lower, result);
+}
+
+/**
+  * computes `out[i] = a[i] / b[i]` for every i
+  *
+  * @throws std::runtime_error if the spans have different sizes
+  */
+template<class T>
+void div(
+	std::span<interval<T> const> a,
+	std::span<interval<T> const> b,
+	std::span<interval<T>> out)
+{
+	detail::check_batch_sizes(a, b, out);
+
+	auto lower = [&](std::size_t i)
+	{
+		auto [ n, d ] = detail::division_lo_operands(a[i], b[i]);
+		return n/d;
+	};
+
+	auto result = [&](std::size_t i, T lo)
+	{
+		if(a[i].is_empty() && b[i].is_empty())
+			return interval<T>::empty();
+
+		if(a[i] == T{0})
+			return interval<T>{ T{0} };
+
+		if(b[i].lo() < T{0} && b[i].hi() > T{0})
+			return interval<T>::empty();
+
+		auto [ n, d ] = detail::division_hi_operands(a[i], b[i]);
+		return interval<T>{ lo, n/d };
+	};
+
+	detail::apply_in_chunks(a.size(), out, lower, result);
+}
+
+} // end of namespace ia
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/ranges.hpp"
+
+#include "ia/interval.hpp"
+#include "ia/operations.hpp"
+
+/** @file branch-and-bound.hpp
+  * branch-and-bound over boxes of intervals, with a work queue shared by
+  * several threads, and the solvers built on top of it: the certified
+  * root isolation with interval newton and the global minimization
+  */
+
+namespace ia{
+
+/// a n-dimensional box; the cartesian product of N intervals
+template<class T, std::size_t N>
+using box = std::array<interval<T>, N>;
+
+/**
+  * the decision taken by the branch-and-bound about a box
+  */
+enum class bnb_action {
+	DISCARD,	///< the box has no solution
+	ACCEPT,		///< the box is a solution enclosure
+	SPLIT		///< the box must be split
+};
+
+/**
+  * the order in which the boxes are taken from the work queue
+  */
+enum class bnb_order {
+	BREADTH_FIRST,	///< improves the bounds evenly; the best for minimization
+	DEPTH_FIRST	///< keeps the queue small
+};
+
+template<class T>
+struct bnb_options {
+	/// boxes with all sides not wider than `tolerance` are accepted
+	T tolerance = T{1e-8};
+
+	/// number of threads that consume the work queue
+	std::size_t threads = 1;
+
+	/**
+	  * maximum number of processed boxes; 0 means no limit. when the limit
+	  * is reached the boxes still in the queue are accepted as they are,
+	  * so no enclosure is lost. the default bounds the time and the memory
+	  * of a call whose tolerance is too tight for the function
+	  */
+	uint64_t max_boxes = 1'000'000;
+
+	bnb_order order = bnb_order::BREADTH_FIRST;
+};
+
+/**
+  * box splitting heuristic that splits the widest side
+  */
+struct split_widest {
+	template<class T, std::size_t N>
+	std::size_t operator()(box<T, N> const& b, uint64_t) const
+	{
+		auto widest = rg::max_element(
+			b,
+			std::less<T>{},
+			[](auto&& side){ return side.half_width(); }
+		);
+
+		return static_cast<std::size_t>(std::distance(b.begin(), widest));
+	}
+};
+
+/**
+  * box splitting heuristic that cycles through the sides with the depth of
+  * the box in the search tree
+  */
+struct split_round_robin {
+	template<class T, std::size_t N>
+	std::size_t operator()(box<T, N> const&, uint64_t depth) const
+	{
+		return depth % N;
+	}
+};
+
+/**
+  * bisects the box `b` in the side `side`
+  *
+  * @return the two halves or std::nullopt if the side cannot be split
+  *         anymore in the precision of T
+  */
+template<class T, std::size_t N>
+std::optional<std::pair<box<T, N>, box<T, N>>> bisect(
+	box<T, N> const& b,
+	std::size_t side)
+{
+	auto const& s = b[side];
+	auto const m = s.midpoint();
+
+	if(!(s.lo() < m && m < s.hi()))
+		return std::nullopt;
+
+	auto left = b;
+	auto right = b;
+	left[side] = interval<T>{ s.lo(), m };
+	right[side] = interval<T>{ m, s.hi() };
+
+	return std::pair{ left, right };
+}
+
+namespace detail{
+
+template<class T>
+T width(interval<T> const& a)
+{
+	return T{2}*a.half_width();
+}
+
+template<class T, std::size_t N>
+T box_width(box<T, N> const& b)
+{
+	auto w = T{0};
+	for(auto&& side : b)
+		w = std::max(w, width(side));
+	return w;
+}
+
+template<class T, std::size_t N>
+struct bnb_node {
+	box<T, N> b;
+	uint64_t depth;
+};
+
+/**
+  * work queue of the branch-and-bound; `pop` blocks until there is an item
+  * or until the queue is empty and no worker is processing an item, which
+  * means that no more items can be produced, or until `stop` is called
+  */
+template<class Item>
+class work_queue{
+public:
+
+	explicit work_queue(Item initial, bnb_order order)
+		: m_order(order)
+	{
+		m_items.push_back(std::move(initial));
+	}
+
+	void push(Item item)
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+			m_items.push_back(std::move(item));
+		}
+		m_cv.notify_one();
+	}
+
+	std::optional<Item> pop()
+	{
+		std::unique_lock lock{ m_mutex };
+		m_cv.wait(lock, [this]
+		{
+			return !m_items.empty() || m_busy == 0 || m_stopped;
+		});
+
+		if(m_items.empty() || m_stopped)
+			return std::nullopt;
+
+		Item item;
+		if(m_order == bnb_order::BREADTH_FIRST){
+			item = std::move(m_items.front());
+			m_items.pop_front();
+		}else{
+			item = std::move(m_items.back());
+			m_items.pop_back();
+		}
+
+		++m_busy;
+		return item;
+	}
+
+	/// signals that the item returned by the last `pop` was processed
+	void done()
+	{
+		std::lock_guard lock{ m_mutex };
+		if(--m_busy == 0 && m_items.empty())
+			m_cv.notify_all();
+	}
+
+	/// makes every `pop` return std::nullopt, the items left are dropped
+	void stop()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+			m_stopped = true;
+		}
+		m_cv.notify_all();
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::deque<Item> m_items;
+	uint64_t m_busy = 0;
+	bool m_stopped = false;
+	bnb_order const m_order;
+};
+
+/**
+  * calls `done` on the queue when it goes out of scope, so an item is
+  * counted as processed even if its processing throws
+  */
+template<class Queue>
+class done_guard{
+public:
+	explicit done_guard(Queue& queue)
+		: m_queue(queue)
+	{}
+
+	done_guard(done_guard const&) = delete;
+	done_guard& operator=(done_guard const&) = delete;
+
+	~done_guard()
+	{
+		m_queue.done();
+	}
+
+private:
+	Queue& m_queue;
+};
+
+template<class T, std::size_t N>
+bool lexicographical_less(box<T, N> const& a, box<T, N> const& b)
+{
+	return rg::lexicographical_compare(
+		a, b,
+		[](auto&& x, auto&& y)
+		{
+			return x.lo() < y.lo() || (x.lo() == y.lo() && x.hi() < y.hi());
+		}
+	);
+}
+
+} // end of namespace detail
+
+/**
+  * branch-and-bound on the box `initial`. every box taken from the work
+  * queue is given to `process`, which may contract it in place and decides
+  * whether the box is discarded, accepted, or split. a box to be split that
+  * is not wider than the tolerance, or that cannot be bisected anymore, is
+  * accepted.
+  *
+  * @param initial the initial box
+  * @param process box& -> bnb_action; it is called concurrently when
+  *        `options.threads` > 1, so it must be thread safe. if it throws,
+  *        the workers stop taking boxes and the first exception is
+  *        rethrown once they are all finished
+  * @param options see `bnb_options`
+  * @param split (box const&, depth) -> side to be split; see `split_widest`
+  *        and `split_round_robin`
+  *
+  * @return the accepted boxes sorted lexicographically
+  */
+template<class T, std::size_t N, class FnProcess, class FnSplit = split_widest>
+	requires (
+		std::is_invocable_r_v<bnb_action, FnProcess, box<T, N>&>
+		&& std::is_invocable_r_v<
+			std::size_t,
+			FnSplit,
+			box<T, N> const&,
+			uint64_t>)
+std::vector<box<T, N>> branch_and_bound(
+	box<T, N> const& initial,
+	FnProcess process,
+	bnb_options<T> const& options = {},
+	FnSplit split = FnSplit{})
+{
+	using node = detail::bnb_node<T, N>;
+
+	detail::work_queue<node> queue{ node{ initial, 0 }, options.order };
+	std::atomic<uint64_t> processed = 0;
+
+	std::mutex accepted_mutex;
+	std::vector<box<T, N>> accepted;
+	std::exception_ptr error;
+
+	auto process_queue = [&]
+	{
+		while(auto n = queue.pop()){
+			detail::done_guard const guard{ queue };
+			auto& [ b, depth ] = *n;
+
+			auto const over_limit = options.max_boxes != 0
+				&& processed++ >= options.max_boxes;
+
+			auto action = over_limit ? bnb_action::ACCEPT : process(b);
+
+			if(action == bnb_action::SPLIT){
+				auto halves = detail::box_width(b) > options.tolerance
+					? bisect(b, split(std::as_const(b), depth))
+					: std::nullopt;
+
+				if(halves){
+					queue.push(node{ halves->first, depth + 1 });
+					queue.push(node{ halves->second, depth + 1 });
+				}else{
+					action = bnb_action::ACCEPT;
+				}
+			}
+
+			if(action == bnb_action::ACCEPT){
+				std::lock_guard lock{ accepted_mutex };
+				accepted.push_back(b);
+			}
+		}
+	};
+
+	auto worker = [&]
+	{
+		try{
+			process_queue();
+		}catch(...){
+			{
+				std::lock_guard lock{ accepted_mutex };
+				if(!error)
+					error = std::current_exception();
+			}
+			queue.stop();
+		}
+	};
+
+	{
+		std::vector<std::jthread> pool;
+		for(std::size_t i=1; i<options.threads; ++i)
+			pool.emplace_back(worker);
+
+		worker();
+	}
+
+	if(error)
+		std::rethrow_exception(error);
+
+	rg::sort(accepted, detail::lexicographical_less<T, N>);
+	return accepted;
+}
+
+/**
+  * a root enclosure found by `find_roots`
+  */
+template<class T>
+struct root_enclosure {
+	interval<T> x;
+
+	/// true if it is proven that `x` contains exactly one root
+	bool unique;
+};
+
+namespace detail{
+
+/**
+  * interval newton operator N(X) = m - f(m)/f'(X) intersected with X
+  *
+  * @return the contracted interval and whether N(X) is in the interior of
+  *         X, which proves that X has a unique root; if f'(X) contains zero
+  *         X is returned unchanged
+  */
+template<class T, class Fn, class FnDerivative>
+std::pair<interval<T>, bool> newton_step(
+	Fn& f,
+	FnDerivative& df,
+	interval<T> const& x)
+{
+	auto const dx = df(x);
+
+	if(dx.is_empty() || contains(dx, T{0}))
+		return { x, false };
+
+	auto const m = interval<T>{ x.midpoint() };
+	auto const n = m - f(m)/dx;
+
+	auto const unique = !n.is_empty() && x.lo() < n.lo() && n.hi() < x.hi();
+	return { intersect(x, n), unique };
+}
+
+} // end of namespace detail
+
+/**
+  * isolates all the roots of f in `domain` with the interval newton method
+  * and bisection
+  *
+  * @param f interval -> interval; an inclusion function of f
+  * @param df interval -> interval; an inclusion function of the derivative
+  *        of f
+  * @param domain where the roots are searched
+  * @param options see `bnb_options`; `f` and `df` must be thread safe when
+  *        `options.threads` > 1
+  *
+  * @return disjoint enclosures, sorted, such that every root of f in the
+  *         domain is in one of them
+  */
+template<class T, class Fn, class FnDerivative>
+	requires (
+		std::is_invocable_r_v<interval<T>, Fn, interval<T> const&>
+		&& std::is_invocable_r_v<interval<T>, FnDerivative, interval<T> const&>)
+std::vector<root_enclosure<T>> find_roots(
+	Fn f,
+	FnDerivative df,
+	interval<T> const& domain,
+	bnb_options<T> const& options = {})
+{
+	auto process = [&](box<T, 1>& b)
+	{
+		auto& x = b[0];
+
+		for(;;){
+			if(!contains(f(x), T{0}))
+				return bnb_action::DISCARD;
+
+			auto const n = detail::newton_step(f, df, x).first;
+
+			if(n.is_empty())
+				return bnb_action::DISCARD;
+
+			auto const contracted = detail::width(n) < detail::width(x)/T{2};
+			x = n;
+
+			if(detail::width(x) <= options.tolerance)
+				return bnb_action::ACCEPT;
+
+			if(!contracted)
+				return bnb_action::SPLIT;
+		}
+	};
+
+	auto boxes = branch_and_bound(box<T, 1>{ domain }, process, options);
+
+	// a root in a bisection point may be in two adjacent boxes
+	std::vector<interval<T>> enclosures;
+	for(auto&& [ x ] : boxes){
+		if(!enclosures.empty() && enclosures.back().hi() >= x.lo())
+			enclosures.back() = join(enclosures.back(), x);
+		else
+			enclosures.push_back(x);
+	}
+
+	std::vector<root_enclosure<T>> roots;
+	roots.reserve(enclosures.size());
+
+	for(auto&& x : enclosures){
+		auto const unique = detail::newton_step(f, df, x).second;
+		roots.push_back(root_enclosure<T>{ x, unique });
+	}
+
+	return roots;
+}
+
+template<class T, std::size_t N>
+struct minimization_result {
+	/// enclosure of the global minimum value
+	interval<T> minimum;
+
+	/// boxes that may contain a global minimizer
+	std::vector<box<T, N>> minimizers;
+};
+
+/**
+  * global minimization of f in `domain` by branch-and-bound; a box is
+  * discarded when the lower bound of f in it is greater than an upper bound
+  * of the minimum, which is improved with the values of f in the
+  * midpoints of the boxes
+  *
+  * @param f box const& -> interval; an inclusion function of f, it must be
+  *        thread safe when `options.threads` > 1
+  * @param domain where the minimum is searched
+  * @param options see `bnb_options`
+  * @param split see `branch_and_bound`
+  */
+template<class T, std::size_t N, class Fn, class FnSplit = split_widest>
+	requires (std::is_invocable_r_v<interval<T>, Fn, box<T, N> const&>)
+minimization_result<T, N> minimize(
+	Fn f,
+	box<T, N> const& domain,
+	bnb_options<T> const& options = {},
+	FnSplit split = FnSplit{})
+{
+	std::atomic<T> best = interval<T>::infinity;
+
+	auto update_best = [&best](T value)
+	{
+		auto current = best.load();
+		while(value < current && !best.compare_exchange_weak(current, value))
+			;
+	};
+
+	auto midpoint = [](box<T, N> const& b)
+	{
+		box<T, N> m;
+		for(std::size_t i=0; i<N; ++i)
+			m[i] = interval<T>{ b[i].midpoint() };
+		return m;
+	};
+
+	auto process = [&](box<T, N>& b)
+	{
+		auto const fb = f(std::as_const(b));
+
+		if(fb.is_empty() || fb.lo() > best.load())
+			return bnb_action::DISCARD;
+
+		auto const fm = f(midpoint(b));
+		if(!fm.is_empty())
+			update_best(fm.hi());
+
+		return bnb_action::SPLIT;
+	};
+
+	auto boxes = branch_and_bound(domain, process, options, split);
+
+	minimization_result<T, N> r{
+		.minimum = interval<T>::empty(),
+		.minimizers = {}
+	};
+
+	auto lo = interval<T>::infinity;
+
+	for(auto&& b : boxes){
+		auto const fb = f(b);
+
+		if(fb.lo() <= best.load()){
+			lo = std::min(lo, fb.lo());
+			r.minimizers.push_back(b);
+		}
+	}
+
+	if(!r.minimizers.empty())
+		r.minimum = interval<T>{ lo, best.load() };
+
+	return r;
+}
+
+} // end of namespace ia
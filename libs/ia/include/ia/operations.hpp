@@ -134,6 +134,30 @@ constexpr auto join(interval<T> const& a, interval<T> const& b)
 	};
 }
 
+template<class T>
+constexpr auto intersect(interval<T> const& a, interval<T> const& b)
+{
+	if(a.is_empty() || b.is_empty())
+		return interval<T>::empty();
+
+	auto lo = std::max(a.lo(), b.lo());
+	auto hi = std::min(a.hi(), b.hi());
+
+	if(lo > hi)
+		return interval<T>::empty();
+
+	return interval<T>{ lo, hi };
+}
+
+/**
+  * @return true if the scalar `x` is inside the interval `a`
+  */
+template<class T, class S>
+constexpr bool contains(interval<T> const& a, S x)
+{
+	return !a.is_empty() && a.lo() <= x && x <= a.hi();
+}
+
 template<class T>
 constexpr auto smaller_or_join(
 	interval<T> const& a,
@@ -0,0 +1,112 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <cmath>
+
+#include "ia/interval.hpp"
+#include "ia/operations.hpp"
+#include "ia/affine.hpp"
+
+TEST_CASE(
+	"affine forms conversion",
+	"[affine]")
+{
+	using namespace ia;
+
+	affine<double> const c{ 3.0 };
+	REQUIRE(c.terms().empty());
+	REQUIRE(c.to_interval() == 3.0);
+
+	affine<double> const x{ interval{ 1.0, 3.0 } };
+	REQUIRE(x.center() == 2.0);
+	REQUIRE(x.terms().size() == 1);
+	REQUIRE(x.radius() == 1.0);
+	REQUIRE(x.to_interval() == interval{ 1.0, 3.0 });
+
+	REQUIRE_THROWS_AS(affine<double>{ interval<double>::empty() }, std::runtime_error);
+}
+
+TEST_CASE(
+	"affine forms keep the dependency between operands",
+	"[affine]")
+{
+	using namespace ia;
+
+	auto const xi = interval{ 1.0, 2.0 };
+	affine<double> const x{ xi };
+
+	SECTION("x - x"){
+		REQUIRE((x - x).to_interval() == 0.0);
+		REQUIRE(xi - xi == interval{ -1.0, 1.0 });
+	}
+
+	SECTION("x*(3 - x) is tighter than in interval arithmetic"){
+		auto const a = (x*(affine<double>{ 3.0 } - x)).to_interval();
+		auto const i = xi*(interval{ 3.0 } - xi);
+
+		// the exact range is [2, 2.25]
+		REQUIRE(a.lo() <= 2.0);
+		REQUIRE(a.hi() >= 2.25);
+		REQUIRE(a.hi() - a.lo() < i.hi() - i.lo());
+	}
+
+	SECTION("linear operations"){
+		auto const y = (x*2.0 + 1.0) - x;
+		auto const r = y.to_interval();
+		REQUIRE(r.lo() <= 2.0);
+		REQUIRE(r.hi() >= 3.0);
+		REQUIRE(r.hi() - r.lo() <= 1.0 + 1e-12);
+	}
+}
+
+TEST_CASE(
+	"affine nonlinear operations enclose the exact values",
+	"[affine]")
+{
+	using namespace ia;
+
+	auto const xi = interval{ 4.0, 9.0 };
+	affine<double> const x{ xi };
+
+	auto contains_samples = [&](auto&& form, auto&& f)
+	{
+		auto const r = form.to_interval();
+		for(auto i=0; i<=100; ++i){
+			auto const t = xi.lo() + (xi.hi() - xi.lo())*i/100.0;
+			if(!contains(r, f(t)))
+				return false;
+		}
+		return true;
+	};
+
+	REQUIRE(contains_samples(sqrt(x), [](double t){ return std::sqrt(t); }));
+	REQUIRE(contains_samples(affine<double>{ 1.0 }/x, [](double t){ return 1.0/t; }));
+	REQUIRE(contains_samples(affine<double>{ 1.0 }/-x, [](double t){ return -1.0/t; }));
+	REQUIRE(contains_samples(x/3.0, [](double t){ return t/3.0; }));
+	REQUIRE(contains_samples(x*x, [](double t){ return t*t; }));
+
+	affine<double> const zero{ interval{ -1.0, 1.0 } };
+	REQUIRE_THROWS_AS(x/zero, std::runtime_error);
+}
+
+TEST_CASE(
+	"affine forms condensation bounds the number of symbols",
+	"[affine]")
+{
+	using namespace ia;
+	using form = affine<double, 4>;
+
+	form sum{ 0.0 };
+	auto isum = interval{ 0.0 };
+
+	for(auto i=0; i<32; ++i){
+		auto const xi = interval{ double(i), double(i) + 0.5 + i/64.0 };
+		sum += form{ xi };
+		isum += xi;
+
+		REQUIRE(sum.terms().size() <= form::max_symbols);
+	}
+
+	auto const r = sum.to_interval();
+	REQUIRE(r.lo() <= isum.lo());
+	REQUIRE(r.hi() >= isum.hi());
+}
@@ -0,0 +1,61 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <bit>
+#include <vector>
+
+#include "ia/interval.hpp"
+#include "ia/batch-operations.hpp"
+
+#include "random-intervals.hpp"
+
+static bool bit_equal(ia::interval<double> const& a, ia::interval<double> const& b)
+{
+	return std::bit_cast<uint64_t>(a.lo()) == std::bit_cast<uint64_t>(b.lo())
+		&& std::bit_cast<uint64_t>(a.hi()) == std::bit_cast<uint64_t>(b.hi());
+}
+
+TEST_CASE(
+	"batch operations are bit-identical to the scalar operators",
+	"[interval][batch]")
+{
+	auto const n = 3*ia::batch_chunk_size + 17;
+	auto const a = make_intervals(n, 42);
+	auto const b = make_intervals(n, 43);
+	std::vector<ia::interval<double>> out(n);
+
+	SECTION("add"){
+		ia::add<double>(a, b, out);
+		for(std::size_t i=0; i<n; ++i)
+			REQUIRE(bit_equal(out[i], a[i] + b[i]));
+	}
+
+	SECTION("sub"){
+		ia::sub<double>(a, b, out);
+		for(std::size_t i=0; i<n; ++i)
+			REQUIRE(bit_equal(out[i], a[i] - b[i]));
+	}
+
+	SECTION("mul"){
+		ia::mul<double>(a, b, out);
+		for(std::size_t i=0; i<n; ++i)
+			REQUIRE(bit_equal(out[i], a[i] * b[i]));
+	}
+
+	SECTION("div"){
+		ia::div<double>(a, b, out);
+		for(std::size_t i=0; i<n; ++i)
+			REQUIRE(bit_equal(out[i], a[i] / b[i]));
+	}
+
+	SECTION("in place"){
+		auto c = a;
+		ia::mul<double>(c, b, c);
+		for(std::size_t i=0; i<n; ++i)
+			REQUIRE(bit_equal(c[i], a[i] * b[i]));
+	}
+
+	SECTION("different sizes"){
+		std::vector<ia::interval<double>> small(n - 1);
+		REQUIRE_THROWS_AS(ia::add<double>(a, b, small), std::runtime_error);
+	}
+}
@@ -0,0 +1,177 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include "ia/interval.hpp"
+#include "ia/operations.hpp"
+#include "ia/branch-and-bound.hpp"
+
+TEST_CASE(
+	"box splitting heuristics",
+	"[interval][branch-and-bound]")
+{
+	using namespace ia;
+
+	box<double, 3> const b{
+		interval{ 0.0, 1.0 },
+		interval{ 0.0, 4.0 },
+		interval{ 0.0, 2.0 }
+	};
+
+	REQUIRE(split_widest{}(b, 0) == 1);
+	REQUIRE(split_round_robin{}(b, 0) == 0);
+	REQUIRE(split_round_robin{}(b, 5) == 2);
+
+	auto halves = bisect(b, 1);
+	REQUIRE(halves.has_value());
+	REQUIRE(halves->first[1] == interval{ 0.0, 2.0 });
+	REQUIRE(halves->second[1] == interval{ 2.0, 4.0 });
+	REQUIRE(halves->first[0] == b[0]);
+
+	REQUIRE(!bisect(box<double, 1>{ interval{ 1.0 } }, 0).has_value());
+}
+
+TEST_CASE(
+	"interval newton root isolation",
+	"[interval][branch-and-bound]")
+{
+	using namespace ia;
+	using interval_type = interval<double>;
+
+	// (x - 1)(x + 2)(x - 3) = x^3 - 2x^2 - 5x + 6
+	auto f = [](interval_type const& x)
+	{
+		return ((x - 2.0)*x - 5.0)*x + 6.0;
+	};
+
+	auto df = [](interval_type const& x)
+	{
+		return (x*3.0 - 4.0)*x - 5.0;
+	};
+
+	auto const expected = std::array{ -2.0, 1.0, 3.0 };
+
+	for(auto threads : { 1u, 4u }){
+		bnb_options<double> options{
+			.tolerance = 1e-9,
+			.threads = threads
+		};
+
+		auto roots = find_roots(f, df, interval{ -10.0, 10.0 }, options);
+
+		REQUIRE(roots.size() == expected.size());
+
+		for(std::size_t i=0; i<roots.size(); ++i){
+			REQUIRE(contains(roots[i].x, expected[i]));
+			REQUIRE(roots[i].unique);
+			REQUIRE(roots[i].x.hi() - roots[i].x.lo() <= 1e-9);
+		}
+	}
+
+	SECTION("no roots"){
+		auto g = [](interval_type const& x){ return x*x + 1.0; };
+		auto dg = [](interval_type const& x){ return x*2.0; };
+
+		REQUIRE(find_roots(g, dg, interval{ -5.0, 5.0 }).empty());
+	}
+}
+
+TEST_CASE(
+	"branch-and-bound global minimization",
+	"[interval][branch-and-bound]")
+{
+	using namespace ia;
+
+	// (x - 1)^2 + (y + 0.5)^2 + 2 has its minimum 2 at (1, -0.5)
+	auto f = [](box<double, 2> const& b)
+	{
+		auto x = b[0] - 1.0;
+		auto y = b[1] + 0.5;
+		return abs(x)*abs(x) + abs(y)*abs(y) + 2.0;
+	};
+
+	box<double, 2> const domain{
+		interval{ -4.0, 4.0 },
+		interval{ -4.0, 4.0 }
+	};
+
+	for(auto threads : { 1u, 4u }){
+		bnb_options<double> options{
+			.tolerance = 1e-6,
+			.threads = threads
+		};
+
+		auto r = minimize(f, domain, options);
+
+		REQUIRE(contains(r.minimum, 2.0));
+		REQUIRE(r.minimum.hi() - r.minimum.lo() <= 1e-6);
+		REQUIRE(!r.minimizers.empty());
+
+		for(auto&& b : r.minimizers){
+			REQUIRE(std::fabs(b[0].midpoint() - 1.0) <= 1e-3);
+			REQUIRE(std::fabs(b[1].midpoint() + 0.5) <= 1e-3);
+		}
+
+		auto rr = minimize(f, domain, options, split_round_robin{});
+		REQUIRE(contains(rr.minimum, 2.0));
+
+		options.tolerance = 1e-3;
+		options.order = bnb_order::DEPTH_FIRST;
+		auto rd = minimize(f, domain, options);
+		REQUIRE(contains(rd.minimum, 2.0));
+	}
+
+	SECTION("box limit"){
+		bnb_options<double> options{
+			.tolerance = 1e-6,
+			.max_boxes = 16
+		};
+
+		auto r = minimize(f, domain, options);
+		REQUIRE(contains(r.minimum, 2.0));
+	}
+
+	SECTION("the default box limit stops a flat function"){
+		// no box is ever discarded, so only the limit stops the splits
+		auto flat = [](box<double, 2> const&){ return interval{ 0.0 }; };
+
+		auto r = minimize(flat, domain);
+		REQUIRE(contains(r.minimum, 0.0));
+		REQUIRE(r.minimizers.size() <= bnb_options<double>{}.max_boxes + 1);
+	}
+}
+
+TEST_CASE(
+	"branch-and-bound rethrows the exceptions of process",
+	"[interval][branch-and-bound]")
+{
+	using namespace ia;
+
+	for(auto threads : { 1u, 4u }){
+		INFO(threads);
+
+		bnb_options<double> options{
+			.tolerance = 1e-6,
+			.threads = threads
+		};
+
+		// the boxes are split until one reaches the depth of 10
+		std::atomic<uint64_t> calls = 0;
+		auto process = [&](box<double, 1>& b)
+		{
+			++calls;
+			if(b[0].hi() - b[0].lo() < 1.0/512.0)
+				throw std::domain_error("too deep");
+			return bnb_action::SPLIT;
+		};
+
+		REQUIRE_THROWS_AS(
+			branch_and_bound(box<double, 1>{ interval{ 0.0, 1.0 } }, process, options),
+			std::domain_error);
+
+		// the other workers stop, instead of splitting down to the tolerance
+		REQUIRE(calls < 4096);
+	}
+}
@@ -0,0 +1,160 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <limits>
+#include <vector>
+
+#include "ia/interval.hpp"
+#include "ia/operations.hpp"
+#include "ia/interval-array.hpp"
+
+#include "random-intervals.hpp"
+
+template<class FnArray, class FnScalar>
+static void require_element_wise(
+	std::vector<ia::interval<double>> const& a,
+	std::vector<ia::interval<double>> const& b,
+	FnArray f_array,
+	FnScalar f_scalar)
+{
+	auto const r = f_array(
+		ia::interval_array<double>{ a },
+		ia::interval_array<double>{ b }
+	);
+
+	REQUIRE(r.size() == a.size());
+
+	for(std::size_t i=0; i<a.size(); ++i)
+		REQUIRE(r[i] == f_scalar(a[i], b[i]));
+}
+
+TEST_CASE(
+	"interval_array is equal to the element-wise scalar operations",
+	"[interval][interval-array]")
+{
+	auto const a = make_intervals(1001, 7);
+	auto const b = make_intervals(1001, 8);
+
+	SECTION("storage"){
+		ia::interval_array<double> v{ a };
+		REQUIRE(v.to_intervals() == a);
+
+		v.set(1, ia::interval{ 2.0, 3.0 });
+		REQUIRE(v[1] == ia::interval{ 2.0, 3.0 });
+		REQUIRE(v.lo()[1] == 2.0);
+		REQUIRE(v.hi()[1] == 3.0);
+	}
+
+	SECTION("arithmetic"){
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return x + y; },
+			[](auto&& x, auto&& y){ return x + y; });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return x - y; },
+			[](auto&& x, auto&& y){ return x - y; });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return x * y; },
+			[](auto&& x, auto&& y){ return x * y; });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return x / y; },
+			[](auto&& x, auto&& y){ return x / y; });
+	}
+
+	SECTION("min, max, and join"){
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return ia::min(x, y); },
+			[](auto&& x, auto&& y){ return ia::min(x, y); });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return ia::max(x, y); },
+			[](auto&& x, auto&& y){ return ia::max(x, y); });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&& y){ return ia::join(x, y); },
+			[](auto&& x, auto&& y){ return ia::join(x, y); });
+	}
+
+	SECTION("sqrt and abs"){
+		require_element_wise(a, b,
+			[](auto&& x, auto&&){ return ia::sqrt(x); },
+			[](auto&& x, auto&&){ return ia::sqrt(x); });
+
+		require_element_wise(a, b,
+			[](auto&& x, auto&&){ return ia::abs(x); },
+			[](auto&& x, auto&&){ return ia::abs(x); });
+	}
+
+	SECTION("infinite bounds"){
+		auto const inf = std::numeric_limits<double>::infinity();
+
+		std::vector const x{
+			ia::interval{ -1.0, 0.0 },
+			ia::interval{ -inf, -1.0 },
+			ia::interval{ 0.0, 1.0 },
+			ia::interval{ 1.0, inf },
+			ia::interval{ -inf, -1.0 },
+			ia::interval{ 1.0, inf },
+		};
+
+		std::vector const y{
+			ia::interval{ -inf, -1.0 },
+			ia::interval{ -1.0, 0.0 },
+			ia::interval{ 1.0, inf },
+			ia::interval{ 0.0, 1.0 },
+			ia::interval{ 2.0, 3.0 },
+			ia::interval{ -inf, -1.0 },
+		};
+
+		require_element_wise(x, y,
+			[](auto&& l, auto&& r){ return l + r; },
+			[](auto&& l, auto&& r){ return l + r; });
+
+		require_element_wise(x, y,
+			[](auto&& l, auto&& r){ return l - r; },
+			[](auto&& l, auto&& r){ return l - r; });
+
+		require_element_wise(x, y,
+			[](auto&& l, auto&& r){ return l * r; },
+			[](auto&& l, auto&& r){ return l * r; });
+
+		require_element_wise(x, y,
+			[](auto&& l, auto&& r){ return l / r; },
+			[](auto&& l, auto&& r){ return l / r; });
+
+		// 0*inf is a NaN product, which must not replace the lower bound
+		auto const r = ia::interval_array<double>{ x }
+			* ia::interval_array<double>{ y };
+		REQUIRE(r[0] == ia::interval{ 0.0, inf });
+		REQUIRE(r[1] == ia::interval{ 0.0, inf });
+		REQUIRE(r[2] == ia::interval{ 0.0, inf });
+		REQUIRE(r[3] == ia::interval{ 0.0, inf });
+	}
+
+	SECTION("different sizes"){
+		ia::interval_array<double> x(3), y(4);
+		REQUIRE_THROWS_AS(x + y, std::runtime_error);
+	}
+}
+
+TEST_CASE(
+	"interval_array euclidean distance",
+	"[interval][interval-array]")
+{
+	using array_type = ia::interval_array<double>;
+
+	std::vector const px{ ia::interval{ 4.0 }, ia::interval{ 0.0 } };
+	std::vector const py{ ia::interval{ 7.0 }, ia::interval{ 0.0 } };
+	std::vector const qx{ ia::interval{ 1.0 }, ia::interval{ 6.0 } };
+	std::vector const qy{ ia::interval{ 3.0 }, ia::interval{ 8.0 } };
+
+	std::array const p{ array_type{ px }, array_type{ py } };
+	std::array const q{ array_type{ qx }, array_type{ qy } };
+
+	auto d = ia::euclidean_distance<double>(p, q);
+
+	REQUIRE(d.size() == 2);
+	REQUIRE(d[0] == 5.0);
+	REQUIRE(d[1] == 10.0);
+}
@@ -102,6 +102,17 @@ TEST_CASE(
 			join(interval{4., 5.}, interval{3., 6.}) == interval{3., 6.}
 		);
 
+		STATIC_REQUIRE(
+			intersect(interval{2., 5.}, interval{3., 6.}) == interval{3., 5.}
+		);
+		STATIC_REQUIRE(
+			intersect(interval{2., 3.}, interval{4., 5.}).is_empty()
+		);
+
+		STATIC_REQUIRE(contains(interval{2., 3.}, 2.5));
+		STATIC_REQUIRE(!contains(interval{2., 3.}, 4.0));
+		STATIC_REQUIRE(!contains(interval<double>::empty(), 0.0));
+
 		STATIC_REQUIRE(
 			smaller_or_join(interval{2., 3.}, interval{4., 5.})
 			== interval{2., 3.}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "util/misc.hpp"
+#include "ia/interval.hpp"
+
+/**
+  * `n` intervals with random bounds in [-10, 10], one in five being one of
+  * the special cases that the operations handle apart; the cycle of the
+  * special cases starts at `seed`, so two seeds pair different cases
+  */
+inline auto make_intervals(std::size_t n, uint32_t seed)
+{
+	using interval_type = ia::interval<double>;
+
+	std::mt19937 gen{ seed };
+	std::uniform_real_distribution<double> dist{ -10.0, 10.0 };
+
+	std::array const special{
+		interval_type::empty(),
+		interval_type{ 0.0 },
+		interval_type{ 0.0, 1.0 },
+		interval_type{ -1.0, 0.0 },
+		interval_type{ -1.0, 1.0 },
+		interval_type{ 1.0/3.0, 2.0/3.0 },
+	};
+
+	std::vector<interval_type> v;
+	v.reserve(n);
+
+	for(std::size_t i=0; i<n; ++i){
+		if(i%5 == 0){
+			v.push_back(special[(i/5 + seed) % special.size()]);
+		}else{
+			auto [ lo, hi ] = util::minmax(dist(gen), dist(gen));
+			v.push_back(interval_type{ lo, hi });
+		}
+	}
+
+	return v;
+}
@@ -0,0 +1,87 @@
+/**
+  * compares resolving a runtime precision with `unsigned_integer_from_precision`
+  * and `std::visit` against `dispatch_by_precision`
+  *
+  * usage: util-integer-variant-benchmark [number of precisions]
+  */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "util/integer-variant.hpp"
+
+namespace{
+
+using unsigned_variant = util::make_integer_variant_t<util::unsigned_flag, 1, 64>;
+
+/**
+  * a per-width kernel: the largest value of the integer
+  */
+struct max_value{
+	template<class Int>
+	std::uint64_t operator()(Int) const
+	{
+		return static_cast<std::uint64_t>(std::numeric_limits<Int>::max());
+	}
+};
+
+template<class F>
+void run(char const* name, std::vector<std::uint32_t> const& precisions, F&& f)
+{
+	std::uint64_t checksum = 0;
+
+	auto const start = std::chrono::steady_clock::now();
+	for(auto n : precisions)
+		checksum += f(n);
+	std::chrono::duration<double, std::nano> const elapsed =
+		std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": "
+		<< elapsed.count()/static_cast<double>(precisions.size())
+		<< " ns/dispatch (checksum " << checksum << ")\n";
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	std::size_t const n = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 10'000'000;
+
+	std::mt19937 gen{ 42 };
+	std::uniform_int_distribution<std::uint32_t> dist{ 1, 64 };
+
+	std::vector<std::uint32_t> precisions(n);
+	for(auto& p : precisions)
+		p = dist(gen);
+
+	run("linear search + std::visit", precisions, [](std::uint32_t p)
+	{
+		auto const i = util::detail::make_integer<
+			unsigned_variant, util::unsigned_flag>(
+				p,
+				util::integer_precisions_t<
+					util::unsigned_flag, unsigned_variant>{});
+		return std::visit(max_value{}, *i);
+	});
+
+	run("precision table + std::visit", precisions, [](std::uint32_t p)
+	{
+		auto const i = util::unsigned_integer_from_precision<
+			unsigned_variant>(p);
+		return std::visit(max_value{}, *i);
+	});
+
+	run("dispatch_by_precision", precisions, [](std::uint32_t p)
+	{
+		return util::dispatch_by_precision<util::unsigned_flag>(
+			p, max_value{});
+	});
+
+	return EXIT_SUCCESS;
+}
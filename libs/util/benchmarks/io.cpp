@@ -0,0 +1,151 @@
+/**
+  * compares `cout_or_file`/`cin_or_file` against `buffered_cout_or_file`
+  * and `mapped_cin_or_file` writing, scanning and parsing a file of
+  * integers
+  *
+  * usage: util-io-benchmark [size in MiB] [path]
+  */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "util/io.hpp"
+
+namespace{
+
+template<class F>
+double seconds(F&& f)
+{
+	auto const start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> const elapsed =
+		std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+void report(
+	char const* name,
+	std::uintmax_t bytes,
+	double t,
+	std::uint64_t checksum)
+{
+	auto const mib = static_cast<double>(bytes)/(1 << 20);
+	std::cout << name << ": " << t << " s, " << mib/t << " MiB/s"
+		<< " (checksum " << checksum << ")\n";
+}
+
+/**
+  * pseudo-random integers so the output is not trivially compressible
+  */
+std::uint64_t next_value(std::uint64_t& state)
+{
+	state = state*6364136223846793005ull + 1442695040888963407ull;
+	return state >> 40;
+}
+
+std::uintmax_t number_of_digits(std::uint64_t v)
+{
+	std::uintmax_t n = 1;
+	for(; v >= 10; v /= 10)
+		++n;
+	return n;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	std::uintmax_t const mib = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 1024;
+	std::uintmax_t const size = mib << 20;
+
+	auto const path = argc > 2
+		? std::filesystem::path{ argv[2] }
+		: std::filesystem::temp_directory_path() / "util-io-benchmark.txt";
+
+	std::uint64_t checksum = 0;
+
+	auto const t_stream_write = seconds([&]
+	{
+		util::cout_or_file out{ path };
+		std::uint64_t state = 0;
+		checksum = 0;
+		for(std::uintmax_t written = 0; written < size; ){
+			auto const v = next_value(state);
+			out << v << '\n';
+			written += number_of_digits(v) + 1;
+			checksum += v;
+		}
+	});
+	report("cout_or_file write", size, t_stream_write, checksum);
+
+	auto const t_buffered_write = seconds([&]
+	{
+		util::buffered_cout_or_file out{ path };
+		std::uint64_t state = 0;
+		checksum = 0;
+		for(std::uintmax_t written = 0; written < size; ){
+			auto const v = next_value(state);
+			out << v << '\n';
+			written += number_of_digits(v) + 1;
+			checksum += v;
+		}
+		out.flush();
+	});
+	report("buffered_cout_or_file write", size, t_buffered_write, checksum);
+
+	auto const bytes = std::filesystem::file_size(path);
+
+	auto const t_stream_scan = seconds([&]
+	{
+		util::cin_or_file in{ path };
+		std::vector<char> buffer(std::size_t{1} << 20);
+		checksum = 0;
+		while(in.read(buffer.data(), std::ssize(buffer)) || in.gcount() > 0){
+			checksum += static_cast<std::uint64_t>(std::count(
+				buffer.data(), buffer.data() + in.gcount(), '\n'));
+		}
+	});
+	report("cin_or_file scan lines", bytes, t_stream_scan, checksum);
+
+	auto const t_mapped_scan = seconds([&]
+	{
+		util::mapped_cin_or_file in{ path };
+		checksum = static_cast<std::uint64_t>(
+			std::ranges::count(in.data(), '\n'));
+	});
+	report("mapped_cin_or_file scan lines", bytes, t_mapped_scan, checksum);
+
+	auto const t_stream_parse = seconds([&]
+	{
+		util::cin_or_file in{ path };
+		std::uint64_t v;
+		checksum = 0;
+		while(in >> v)
+			checksum += v;
+	});
+	report("cin_or_file operator>>", bytes, t_stream_parse, checksum);
+
+	auto const t_mapped_parse = seconds([&]
+	{
+		util::mapped_cin_or_file in{ path };
+		checksum = 0;
+		util::for_each_field(
+			in.view(),
+			[&](std::size_t, std::size_t, std::string_view field)
+			{
+				checksum += util::from_chars_or_throw<std::uint64_t>(field);
+			});
+	});
+	report("mapped_cin_or_file from_chars", bytes, t_mapped_parse, checksum);
+
+	if(argc <= 2)
+		std::filesystem::remove(path);
+
+	return EXIT_SUCCESS;
+}
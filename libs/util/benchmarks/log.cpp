@@ -0,0 +1,120 @@
+/**
+  * measures the latency of a logging call on the calling thread
+  *
+  * usage: util-log-benchmark [number of calls]
+  */
+#define UTIL_LOG_ACTIVE_LEVEL 1
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "spdlog/sinks/null_sink.h"
+
+#include "util/log.hpp"
+
+namespace{
+
+template<class F>
+double nanoseconds_per_call(std::uint64_t n, F&& f)
+{
+	auto const start = std::chrono::steady_clock::now();
+	for(std::uint64_t i=0; i<n; ++i)
+		f(i);
+	std::chrono::duration<double, std::nano> const elapsed =
+		std::chrono::steady_clock::now() - start;
+	return elapsed.count()/static_cast<double>(n);
+}
+
+/**
+  * times the calls in batches that fit in the logger buffer and waits
+  * for the background thread between them, so no call is dropped
+  */
+template<class F>
+double batched_nanoseconds_per_call(
+	util::logging::async_logger& logger,
+	std::uint64_t n,
+	std::uint64_t batch_size,
+	F&& f)
+{
+	std::chrono::duration<double, std::nano> elapsed{ 0 };
+
+	for(std::uint64_t done=0; done<n; done+=batch_size){
+		auto const start = std::chrono::steady_clock::now();
+		for(std::uint64_t i=done; i<done + batch_size; ++i)
+			f(i);
+		elapsed += std::chrono::steady_clock::now() - start;
+		logger.flush();
+	}
+
+	return elapsed.count()/static_cast<double>(n);
+}
+
+void report(char const* name, double ns)
+{
+	std::cout << name << ": " << ns << " ns/call\n";
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	using namespace util::logging;
+	using namespace std::chrono_literals;
+
+	std::uint64_t const n = argc > 1
+		? std::strtoull(argv[1], nullptr, 10)
+		: 1'000'000;
+
+	auto const sink = std::make_shared<spdlog::logger>(
+		"benchmark",
+		std::make_shared<spdlog::sinks::null_sink_mt>());
+	sink->set_level(spdlog::level::trace);
+	spdlog::set_default_logger(sink);
+
+	constexpr std::uint64_t batch_size = 4096;
+	async_logger logger{ sink, batch_size };
+
+	report("compile-time disabled", nanoseconds_per_call(n, [](auto i)
+	{
+		UTIL_LOG(TRACE, "value {} {}", i, 0.5);
+	}));
+
+	logger.set_level(level::WARN);
+	report("runtime disabled", nanoseconds_per_call(n, [&](auto i)
+	{
+		logger.log(level::INFO, 0, "value {} {}", i, 0.5);
+	}));
+
+	logger.set_level(level::TRACE);
+	auto const async = batched_nanoseconds_per_call(
+		logger, n, batch_size, [&](auto i)
+		{
+			logger.log(level::INFO, 0, "value {} {}", i, 0.5);
+		});
+	report("async enabled", async);
+
+	auto const async_string = batched_nanoseconds_per_call(
+		logger, n, batch_size, [&](auto i)
+		{
+			logger.log(level::INFO, 0, "value {} {}", i, "a short string");
+		});
+	report("async enabled with a string", async_string);
+
+	rate_limiter limiter{ 1ms };
+	report("rate limited", nanoseconds_per_call(n, [&](auto i)
+	{
+		UTIL_LOG_LIMITED(INFO, limiter, "value {} {}", i, 0.5);
+	}));
+
+	report("synchronous spdlog", nanoseconds_per_call(n, [&](auto i)
+	{
+		sink->info("value {} {}", i, 0.5);
+	}));
+
+	std::cout << "dropped: " << logger.dropped() << "\n";
+
+	return EXIT_SUCCESS;
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <concepts>
+#include <functional>
+#include <limits>
+#include <type_traits>
 #include <variant>
 #include <span>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 #include "util/misc.hpp"
 #include "util/variant.hpp"
 
@@ -135,4 +144,341 @@ auto get_bit(
 	}, order);
 }
 
+/**
+  * gathers the bits of `x` selected by `mask` into the lowest bits of
+  * the result, like the PEXT instruction of BMI2, which is used when
+  * the target has it
+  */
+template<std::unsigned_integral T>
+[[nodiscard]] constexpr T extract_bits(T x, T mask) noexcept
+{
+#if defined(__BMI2__)
+	if(!std::is_constant_evaluated()){
+		if constexpr(sizeof(T) <= sizeof(uint32_t))
+			return static_cast<T>(_pext_u32(x, mask));
+		else
+			return static_cast<T>(_pext_u64(x, mask));
+	}
+#endif
+
+	T r = 0;
+	for(T b = 1; mask != 0; b = static_cast<T>(b << 1)){
+		if(x & mask & static_cast<T>(-mask))
+			r |= b;
+		mask &= static_cast<T>(mask - 1);
+	}
+	return r;
+}
+
+/**
+  * scatters the lowest bits of `x` to the positions selected by `mask`,
+  * like the PDEP instruction of BMI2, which is used when the target
+  * has it
+  */
+template<std::unsigned_integral T>
+[[nodiscard]] constexpr T deposit_bits(T x, T mask) noexcept
+{
+#if defined(__BMI2__)
+	if(!std::is_constant_evaluated()){
+		if constexpr(sizeof(T) <= sizeof(uint32_t))
+			return static_cast<T>(_pdep_u32(x, mask));
+		else
+			return static_cast<T>(_pdep_u64(x, mask));
+	}
+#endif
+
+	T r = 0;
+	for(T b = 1; mask != 0; b = static_cast<T>(b << 1)){
+		if(x & b)
+			r |= static_cast<T>(mask & static_cast<T>(-mask));
+		mask &= static_cast<T>(mask - 1);
+	}
+	return r;
+}
+
+/**
+  * reverses the order of the bits of `x`
+  */
+template<std::integral T>
+[[nodiscard]] constexpr T reverse_bits(T x) noexcept
+{
+	auto v = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(x));
+
+	v = ((v >> 1) & 0x5555555555555555) | ((v & 0x5555555555555555) << 1);
+	v = ((v >> 2) & 0x3333333333333333) | ((v & 0x3333333333333333) << 2);
+	v = ((v >> 4) & 0x0f0f0f0f0f0f0f0f) | ((v & 0x0f0f0f0f0f0f0f0f) << 4);
+	v = ((v >> 8) & 0x00ff00ff00ff00ff) | ((v & 0x00ff00ff00ff00ff) << 8);
+	v = ((v >> 16) & 0x0000ffff0000ffff) | ((v & 0x0000ffff0000ffff) << 16);
+	v = (v >> 32) | (v << 32);
+
+	return static_cast<T>(v >> (64 - number_of_bits<T>()));
+}
+
+/**
+  * an integer with the `n` lowest bits set, `n` may be 64
+  */
+[[nodiscard]] constexpr uint64_t low_bits_mask(uint64_t n) noexcept
+{
+	return n >= 64 ? ~uint64_t{0} : (uint64_t{1} << n) - 1;
+}
+
+/*
+ * the functions below see a span of integers as a sequence of bits
+ * indexed like `element_bit_reference` does: the first bit of each
+ * integer is its leftmost one; they work on whole integers, instead
+ * of one bit at a time
+ */
+
+/**
+  * reads `count` <= 64 bits starting at the bit `offset` of `words`,
+  * the first bit read is the leftmost bit of the result
+  */
+template<std::integral T, std::size_t E>
+[[nodiscard]] constexpr
+uint64_t read_bits(std::span<T, E> words, uint64_t offset, uint64_t count)
+	noexcept
+{
+	using word_t = std::make_unsigned_t<std::remove_const_t<T>>;
+	constexpr uint64_t w = number_of_bits<word_t>();
+
+	uint64_t r = 0;
+
+	while(count > 0){
+		auto const shift = offset % w;
+		auto const n = std::min(count, w - shift);
+		auto const word = static_cast<uint64_t>(
+			static_cast<word_t>(words[offset / w]));
+		auto const chunk = (word >> (w - shift - n)) & low_bits_mask(n);
+
+		r = n == 64 ? chunk : (r << n) | chunk;
+		offset += n;
+		count -= n;
+	}
+
+	return r;
+}
+
+/**
+  * writes the `count` <= 64 lowest bits of `value` starting at the bit
+  * `offset` of `words`, the leftmost of them is written first
+  */
+template<std::integral T, std::size_t E>
+constexpr void write_bits(
+	std::span<T, E> words,
+	uint64_t offset,
+	uint64_t count,
+	uint64_t value) noexcept
+	requires (not std::is_const_v<T>)
+{
+	using word_t = std::make_unsigned_t<T>;
+	constexpr uint64_t w = number_of_bits<word_t>();
+
+	while(count > 0){
+		auto const shift = offset % w;
+		auto const n = std::min(count, w - shift);
+		auto const position = w - shift - n;
+		auto const mask = low_bits_mask(n) << position;
+		auto const chunk = ((value >> (count - n)) & low_bits_mask(n))
+			<< position;
+
+		auto& word = words[offset / w];
+		word = static_cast<T>(static_cast<word_t>(
+			(static_cast<word_t>(word) & ~mask) | chunk));
+
+		offset += n;
+		count -= n;
+	}
+}
+
+namespace detail{
+
+/**
+  * whether a copy of bits must go from the last to the first bit,
+  * which is the case when the destination overlaps the source after it
+  */
+template<class T, class Q>
+constexpr bool must_copy_bits_backward(
+	T const* src,
+	uint64_t src_offset,
+	Q const* dst,
+	uint64_t dst_offset) noexcept
+{
+	constexpr uint64_t w = number_of_bits<std::make_unsigned_t<Q>>();
+
+	if constexpr(!std::is_same_v<std::remove_const_t<T>, Q>){
+		return false;
+	}else{
+		auto const s = src + src_offset / w;
+		auto const d = dst + dst_offset / w;
+
+		if(s == d)
+			return src_offset % w < dst_offset % w;
+
+		if(std::is_constant_evaluated())
+			return false;
+
+		return std::less<>{}(s, d);
+	}
+}
+
+} // end of namespace detail
+
+/**
+  * copies `count` bits from the bit `src_offset` of `src` to the bit
+  * `dst_offset` of `dst`, 64 bits at a time; the ranges may overlap,
+  * like in `std::memmove`
+  */
+template<std::integral T, std::size_t E, std::integral Q, std::size_t F>
+constexpr void copy_bits(
+	std::span<T, E> src,
+	uint64_t src_offset,
+	std::span<Q, F> dst,
+	uint64_t dst_offset,
+	uint64_t count) noexcept
+	requires (not std::is_const_v<Q>)
+{
+	if(count == 0)
+		return;
+
+	if(detail::must_copy_bits_backward(
+		src.data(), src_offset, dst.data(), dst_offset))
+	{
+		while(count > 0){
+			auto const n = std::min<uint64_t>(count, 64);
+			count -= n;
+			write_bits(
+				dst, dst_offset + count, n,
+				read_bits(src, src_offset + count, n));
+		}
+	}else{
+		for(uint64_t i=0; i<count; i+=64){
+			auto const n = std::min<uint64_t>(count - i, 64);
+			write_bits(
+				dst, dst_offset + i, n,
+				read_bits(src, src_offset + i, n));
+		}
+	}
+}
+
+/**
+  * the number of bits set among the `count` bits starting at the bit
+  * `offset` of `words`
+  */
+template<std::integral T, std::size_t E>
+[[nodiscard]] constexpr uint64_t popcount(
+	std::span<T, E> words,
+	uint64_t offset,
+	uint64_t count) noexcept
+{
+	using word_t = std::make_unsigned_t<std::remove_const_t<T>>;
+	constexpr uint64_t w = number_of_bits<word_t>();
+
+	uint64_t r = 0;
+
+	auto const head = std::min(count, (w - offset % w) % w);
+	r += std::popcount(read_bits(words, offset, head));
+	offset += head;
+	count -= head;
+
+	for(; count >= w; count -= w, offset += w)
+		r += std::popcount(static_cast<word_t>(words[offset / w]));
+
+	return r + std::popcount(read_bits(words, offset, count));
+}
+
+/**
+  * sets the `count` bits starting at the bit `offset` of `words` to
+  * `value`; only the integers at the edges are masked, the ones in the
+  * middle are assigned whole
+  */
+template<std::integral T, std::size_t E>
+constexpr void fill_bits(
+	std::span<T, E> words,
+	uint64_t offset,
+	uint64_t count,
+	bool value) noexcept
+	requires (not std::is_const_v<T>)
+{
+	using word_t = std::make_unsigned_t<T>;
+	constexpr uint64_t w = number_of_bits<word_t>();
+
+	auto const bits = value ? ~uint64_t{0} : uint64_t{0};
+	auto const word = static_cast<T>(static_cast<word_t>(bits));
+
+	auto const head = std::min(count, (w - offset % w) % w);
+	write_bits(words, offset, head, bits);
+	offset += head;
+	count -= head;
+
+	for(; count >= w; count -= w, offset += w)
+		words[offset / w] = word;
+
+	write_bits(words, offset, count, bits);
+}
+
+/**
+  * the index of the first bit equal to `value` among the `count` bits
+  * starting at the bit `offset` of `words`, or `offset + count` if there
+  * is none
+  */
+template<std::integral T, std::size_t E>
+[[nodiscard]] constexpr uint64_t find_bit(
+	std::span<T, E> words,
+	uint64_t offset,
+	uint64_t count,
+	bool value) noexcept
+{
+	using word_t = std::make_unsigned_t<std::remove_const_t<T>>;
+	constexpr uint64_t w = number_of_bits<word_t>();
+
+	auto const end = offset + count;
+
+	auto first_in = [value](uint64_t chunk, uint64_t n) -> uint64_t
+	{
+		auto const x = value ? chunk : ~chunk & low_bits_mask(n);
+		return n - static_cast<uint64_t>(std::bit_width(x));
+	};
+
+	/*
+	 * the first chunk reaches the next integer boundary, so the
+	 * following ones read whole integers
+	 */
+	auto n = std::min(count, (w - offset % w) % w);
+
+	while(offset < end){
+		if(n == 0)
+			n = std::min<uint64_t>(end - offset, 64);
+
+		auto const i = first_in(read_bits(words, offset, n), n);
+		if(i < n)
+			return offset + i;
+
+		offset += n;
+		n = 0;
+	}
+
+	return end;
+}
+
+/**
+  * whether the `count` bits starting at `a_offset` of `a` are equal to
+  * the ones starting at `b_offset` of `b`, compared 64 at a time
+  */
+template<std::integral T, std::size_t E, std::integral Q, std::size_t F>
+[[nodiscard]] constexpr bool equal_bits(
+	std::span<T, E> a,
+	uint64_t a_offset,
+	std::span<Q, F> b,
+	uint64_t b_offset,
+	uint64_t count) noexcept
+{
+	for(uint64_t i=0; i<count; i+=64){
+		auto const n = std::min<uint64_t>(count - i, 64);
+		if(read_bits(a, a_offset + i, n) != read_bits(b, b_offset + i, n))
+			return false;
+	}
+
+	return true;
+}
+
 } // end of namespace util
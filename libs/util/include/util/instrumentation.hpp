@@ -0,0 +1,315 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(UTIL_INSTRUMENTATION_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define UTIL_INSTRUMENTATION_HAS_RDTSC 1
+#else
+#define UTIL_INSTRUMENTATION_HAS_RDTSC 0
+#endif
+
+/**
+  * @file instrumentation.hpp scoped timers, counters and histograms
+  *
+  * every thread records in its own tables, without locks or atomic
+  * read-modify-write operations, and the registry merges the tables of
+  * all threads when they are read
+  *
+  * the `UTIL_INSTRUMENT_*` macros are the intended entry points: they
+  * expand to nothing unless `UTIL_ENABLE_INSTRUMENTATION` is defined,
+  * which the `ENABLE_INSTRUMENTATION` cmake option does
+  */
+
+namespace util::instrumentation{
+
+inline constexpr std::size_t max_timers = 256;
+inline constexpr std::size_t max_counters = 256;
+inline constexpr std::size_t max_histograms = 64;
+
+/**
+  * a histogram bucket `i` holds the values with `std::bit_width(value) == i`
+  */
+inline constexpr std::size_t histogram_buckets = 65;
+
+using metric_id = std::uint32_t;
+
+/**
+  * the time source of the timers; with `UTIL_INSTRUMENTATION_RDTSC` it is
+  * the time stamp counter, otherwise the steady clock in nanoseconds
+  */
+inline std::uint64_t now_ticks() noexcept
+{
+#if UTIL_INSTRUMENTATION_HAS_RDTSC
+	return __rdtsc();
+#else
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+  * ticks of `now_ticks` per nanosecond, the time stamp counter is
+  * calibrated against the steady clock on the first call
+  */
+double ticks_per_nanosecond();
+
+namespace detail{
+
+inline void bump(std::atomic<std::uint64_t>& a, std::uint64_t value) noexcept
+{
+	a.store(a.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct timer_cell{
+	std::atomic<std::uint64_t> count{ 0 };
+	std::atomic<std::uint64_t> total{ 0 };
+	std::atomic<std::uint64_t> min{ std::numeric_limits<std::uint64_t>::max() };
+	std::atomic<std::uint64_t> max{ 0 };
+};
+
+struct histogram_cell{
+	std::atomic<std::uint64_t> sum{ 0 };
+	std::array<std::atomic<std::uint64_t>, histogram_buckets> buckets{};
+};
+
+struct trace_event{
+	metric_id timer;
+	std::uint64_t start;
+	std::uint64_t duration;
+};
+
+/**
+  * tables written only by their thread; when the thread exits they are
+  * given back to the registry, which keeps their values and hands them
+  * to the next thread that records
+  */
+struct thread_data{
+	std::uint32_t thread_index = 0;
+	std::array<timer_cell, max_timers> timers;
+	std::array<std::atomic<std::uint64_t>, max_counters> counters{};
+	std::array<histogram_cell, max_histograms> histograms;
+
+	std::unique_ptr<trace_event[]> events;
+	std::size_t event_capacity = 0;
+	std::atomic<std::size_t> n_events{ 0 };
+	std::atomic<std::uint64_t> dropped_events{ 0 };
+};
+
+thread_data& register_thread();
+void release_thread(thread_data& data) noexcept;
+
+/**
+  * the tables of the calling thread, released when the thread exits
+  */
+struct thread_handle{
+	thread_data* data = &register_thread();
+
+	~thread_handle()
+	{
+		release_thread(*data);
+	}
+};
+
+inline thread_data& local_data()
+{
+	thread_local thread_handle handle;
+	return *handle.data;
+}
+
+void record_event(thread_data& data, metric_id timer, std::uint64_t start, std::uint64_t end);
+
+} // end of namespace detail
+
+struct timer_summary{
+	std::string name;
+	std::uint64_t count;
+	double total_ns;
+	double min_ns;
+	double max_ns;
+};
+
+struct counter_summary{
+	std::string name;
+	std::uint64_t value;
+};
+
+struct histogram_summary{
+	std::string name;
+	std::uint64_t count;
+	std::uint64_t sum;
+	std::vector<std::uint64_t> buckets;
+};
+
+struct event_summary{
+	std::string name;
+	std::uint32_t thread;
+	double start_ns;
+	double duration_ns;
+};
+
+/**
+  * the merged values of every thread at the time of the read
+  */
+struct snapshot{
+	std::vector<timer_summary> timers;
+	std::vector<counter_summary> counters;
+	std::vector<histogram_summary> histograms;
+	std::vector<event_summary> events;
+	std::uint64_t dropped_events = 0;
+};
+
+/**
+  * names the metrics and owns the tables of the threads; a table is
+  * reused once its thread exits, so their number is the largest number
+  * of threads that recorded at the same time
+  */
+class registry{
+public:
+	static registry& instance();
+
+	/**
+	  * the id of the metric with this name, created on the first call;
+	  * throws `std::runtime_error` if there are too many metrics
+	  */
+	metric_id timer(std::string_view name);
+	metric_id counter(std::string_view name);
+	metric_id histogram(std::string_view name);
+
+	/**
+	  * keeps up to `events_per_thread` timed scopes of every thread
+	  * for the chrome trace export; threads that already recorded an
+	  * event keep their capacity
+	  */
+	void enable_tracing(std::size_t events_per_thread);
+	std::size_t tracing_capacity() const noexcept;
+
+	snapshot collect() const;
+
+	std::size_t thread_tables() const;
+
+	/**
+	  * zeroes every metric; call it only when no thread is recording
+	  */
+	void reset();
+
+private:
+	friend detail::thread_data& detail::register_thread();
+	friend void detail::release_thread(detail::thread_data&) noexcept;
+
+	registry();
+
+	struct impl;
+	std::unique_ptr<impl> m_impl;
+	std::atomic<std::size_t> m_tracing_capacity{ 0 };
+};
+
+/**
+  * measures the time between its construction and destruction
+  */
+class scoped_timer{
+public:
+	explicit scoped_timer(metric_id id) noexcept
+		: m_id(id),
+		  m_start(now_ticks())
+	{}
+
+	scoped_timer(scoped_timer const&) = delete;
+	scoped_timer& operator=(scoped_timer const&) = delete;
+
+	~scoped_timer()
+	{
+		auto const end = now_ticks();
+		auto const elapsed = end - m_start;
+		auto& data = detail::local_data();
+		auto& cell = data.timers[m_id];
+
+		detail::bump(cell.count, 1);
+		detail::bump(cell.total, elapsed);
+
+		if(elapsed < cell.min.load(std::memory_order_relaxed))
+			cell.min.store(elapsed, std::memory_order_relaxed);
+		if(elapsed > cell.max.load(std::memory_order_relaxed))
+			cell.max.store(elapsed, std::memory_order_relaxed);
+
+		if(registry::instance().tracing_capacity() > 0)
+			detail::record_event(data, m_id, m_start, end);
+	}
+
+private:
+	metric_id m_id;
+	std::uint64_t m_start;
+};
+
+inline void add(metric_id counter, std::uint64_t value = 1) noexcept
+{
+	detail::bump(detail::local_data().counters[counter], value);
+}
+
+inline void record(metric_id histogram, std::uint64_t value) noexcept
+{
+	auto& cell = detail::local_data().histograms[histogram];
+	detail::bump(cell.sum, value);
+	detail::bump(cell.buckets[static_cast<std::size_t>(std::bit_width(value))], 1);
+}
+
+/**
+  * writes the timers, counters and histograms as a json object
+  */
+void write_json(std::ostream& out, snapshot const& s);
+
+/**
+  * writes the traced scopes in the chrome trace event format, which
+  * chrome://tracing and perfetto open
+  */
+void write_chrome_trace(std::ostream& out, snapshot const& s);
+
+} // end of namespace util::instrumentation
+
+#define UTIL_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define UTIL_INSTRUMENT_CONCAT(a, b) UTIL_INSTRUMENT_CONCAT_IMPL(a, b)
+#define UTIL_INSTRUMENT_UNIQUE(name) UTIL_INSTRUMENT_CONCAT(name, __LINE__)
+
+#ifdef UTIL_ENABLE_INSTRUMENTATION
+
+#define UTIL_INSTRUMENT_SCOPE(name)                                          \
+	static auto const UTIL_INSTRUMENT_UNIQUE(util_instrument_id_) =          \
+		::util::instrumentation::registry::instance().timer(name);           \
+	::util::instrumentation::scoped_timer const                              \
+		UTIL_INSTRUMENT_UNIQUE(util_instrument_timer_){                      \
+			UTIL_INSTRUMENT_UNIQUE(util_instrument_id_)                      \
+		}
+
+#define UTIL_INSTRUMENT_COUNT(name, value)                                   \
+	do{                                                                      \
+		static auto const util_instrument_id =                               \
+			::util::instrumentation::registry::instance().counter(name);     \
+		::util::instrumentation::add(util_instrument_id, value);             \
+	}while(false)
+
+#define UTIL_INSTRUMENT_HISTOGRAM(name, value)                               \
+	do{                                                                      \
+		static auto const util_instrument_id =                               \
+			::util::instrumentation::registry::instance().histogram(name);   \
+		::util::instrumentation::record(util_instrument_id, value);          \
+	}while(false)
+
+#else
+
+#define UTIL_INSTRUMENT_SCOPE(name) static_cast<void>(0)
+#define UTIL_INSTRUMENT_COUNT(name, value) static_cast<void>(0)
+#define UTIL_INSTRUMENT_HISTOGRAM(name, value) static_cast<void>(0)
+
+#endif
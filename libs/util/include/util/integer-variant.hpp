@@ -1,6 +1,19 @@
 #pragma once
 
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
 #include "util/integers.hpp"
+#include "util/variant.hpp"
 
 namespace util{
 
@@ -82,21 +95,47 @@ constexpr auto make_integer(uint32_t n, std::integer_sequence<T, first, ints ...
 
 } // end of namespace detail
 
+namespace detail{
+
+/**
+  * one entry per precision in [0, 64]; the entries of the precisions
+  * that are not in the variant are empty
+  */
+template<class IntegerVariant, class S, uint32_t ... ints>
+constexpr auto make_integer_table(std::integer_sequence<uint32_t, ints...>)
+{
+	std::array<std::optional<IntegerVariant>, 65> table{};
+	((table[ints] = IntegerVariant{ std::in_place_type<util::integer<ints, S>> }), ...);
+	return table;
+}
+
+template<class IntegerVariant, class S>
+inline constexpr auto integer_table = make_integer_table<IntegerVariant, S>(
+	util::integer_precisions_t<S, IntegerVariant>{});
+
+template<class IntegerVariant, class S>
+constexpr auto integer_from_table(uint32_t n)
+	-> std::optional<IntegerVariant>
+{
+	auto const& table = integer_table<IntegerVariant, S>;
+
+	if(n >= table.size() || !table[n].has_value())
+		return std::nullopt;
+
+	return *table[n];
+}
+
+} // end of namespace detail
+
 /**
   * given a variant of integers `IntegerVariant`, returns a type of
-  * signed integer with `n` bits such that this type is in the variant
+  * unsigned integer with `n` bits such that this type is in the variant
   */
 template<class IntegerVariant>
 constexpr auto unsigned_integer_from_precision(uint32_t n)
 	-> std::optional<IntegerVariant>
 {
-	return detail::make_integer<IntegerVariant, util::unsigned_flag>(
-		n,
-		util::integer_precisions_t<
-			util::unsigned_flag,
-			IntegerVariant
-		>{}
-	);
+	return detail::integer_from_table<IntegerVariant, util::unsigned_flag>(n);
 }
 
 /**
@@ -107,13 +146,98 @@ template<class IntegerVariant>
 constexpr auto signed_integer_from_precision(uint32_t n)
 	-> std::optional<IntegerVariant>
 {
-	return detail::make_integer<IntegerVariant, util::signed_flag>(
-		n,
-		util::integer_precisions_t<
-			util::signed_flag,
-			IntegerVariant
-		>{}
-	);
+	return detail::integer_from_table<IntegerVariant, util::signed_flag>(n);
+}
+
+namespace detail{
+
+template<class S, class Precisions, class F, class ... Args>
+struct dispatch_table;
+
+template<class S, uint32_t first, uint32_t ... ints, class F, class ... Args>
+struct dispatch_table<S, std::integer_sequence<uint32_t, first, ints...>, F, Args...>{
+	using result_type = std::invoke_result_t<
+		F, util::integer<first, S>, Args...>;
+
+	static_assert(
+		(std::is_same_v<
+			std::invoke_result_t<F, util::integer<ints, S>, Args...>,
+			result_type> && ...),
+		"the function must return the same type for every precision");
+
+	using function_type = result_type (*)(F&&, Args&&...);
+
+	template<uint32_t N>
+	static constexpr result_type call(F&& f, Args&& ... args)
+	{
+		return std::invoke(
+			std::forward<F>(f),
+			util::integer<N, S>{},
+			std::forward<Args>(args)...);
+	}
+
+	static constexpr auto make()
+	{
+		std::array<function_type, 65> table{};
+		table[first] = &call<first>;
+		((table[ints] = &call<ints>), ...);
+		return table;
+	}
+
+	static constexpr auto table = make();
+};
+
+[[noreturn]] inline void throw_unsupported_precision(uint32_t n)
+{
+	throw std::runtime_error(
+		"there is no integer with precision " + std::to_string(n));
+}
+
+} // end of namespace detail
+
+/**
+  * calls `f(util::integer<n, S>{}, args...)` for a runtime precision
+  * `n` through a table of function pointers generated at compile time,
+  * instead of comparing `n` against every precision and visiting a
+  * variant
+  *
+  * `Precisions` is the `std::integer_sequence<uint32_t, ...>` of the
+  * precisions accepted, every precision from 1 to 64 by default; the
+  * function must return the same type for all of them; throws
+  * `std::runtime_error` if `n` is not one of them
+  */
+template<
+	util::signess S,
+	class Precisions = util::make_integer_range_t<uint32_t, 1, 64>,
+	class F,
+	class ... Args>
+constexpr decltype(auto) dispatch_by_precision(uint32_t n, F&& f, Args&& ... args)
+{
+	using table_type = detail::dispatch_table<S, Precisions, F, Args...>;
+	constexpr auto const& table = table_type::table;
+
+	if(n >= table.size() || table[n] == nullptr)
+		detail::throw_unsupported_precision(n);
+
+	return table[n](std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+/**
+  * `dispatch_by_precision` restricted to the precisions of the integers
+  * with sign `S` in `IntegerVariant`
+  */
+template<class IntegerVariant, util::signess S, class F, class ... Args>
+constexpr decltype(auto) dispatch_by_variant_precision(
+	uint32_t n,
+	F&& f,
+	Args&& ... args)
+{
+	return util::dispatch_by_precision<
+		S,
+		util::integer_precisions_t<S, IntegerVariant>>(
+			n,
+			std::forward<F>(f),
+			std::forward<Args>(args)...);
 }
 
 
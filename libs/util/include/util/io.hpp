@@ -9,6 +9,21 @@
 #include <filesystem>
 #include <utility>
 #include <type_traits>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <concepts>
+#include <expected>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include "util/integers.hpp"
 
 namespace util{
 
@@ -73,6 +88,278 @@ std::istream& cin_or_file::operator>>(T& value)
 	}
 }
 
+/**
+  * read-only view of a whole file mapped in memory
+  *
+  * if no file is given, the standard input is read into a buffer, as is
+  * a file that cannot be mapped, such as a pipe; either way the content
+  * is exposed as one contiguous span, without going through iostreams
+  */
+class mapped_cin_or_file{
+public:
+	mapped_cin_or_file();
+	explicit mapped_cin_or_file(std::filesystem::path const& path);
+
+	mapped_cin_or_file(mapped_cin_or_file const&) = delete;
+	mapped_cin_or_file& operator=(mapped_cin_or_file const&) = delete;
+
+	mapped_cin_or_file(mapped_cin_or_file&& other) noexcept;
+	mapped_cin_or_file& operator=(mapped_cin_or_file&& other) noexcept;
+
+	~mapped_cin_or_file();
+
+	/**
+	  * true if the content is a memory map of a file
+	  */
+	bool is_mapped() const noexcept;
+
+	std::span<char const> data() const noexcept;
+	std::string_view view() const noexcept;
+	std::size_t size() const noexcept;
+
+private:
+	// reads `file` into the buffer and closes it
+	void read_file(std::FILE* file);
+	void release() noexcept;
+
+	char const* m_data = nullptr;
+	std::size_t m_size = 0;
+	bool m_mapped = false;
+	std::vector<char> m_buffer;
+};
+
+/**
+  * output to a file or, if no file is given, to the standard output
+  * through a large user-space buffer
+  *
+  * the buffer is written only when it is full, when `flush` is called
+  * or on destruction, so small writes cost a copy instead of a call
+  * to the stream
+  */
+class buffered_cout_or_file{
+public:
+	static constexpr std::size_t default_buffer_size = std::size_t{1} << 20;
+
+	explicit buffered_cout_or_file(
+		std::size_t buffer_size = default_buffer_size);
+
+	explicit buffered_cout_or_file(
+		std::filesystem::path const& path,
+		std::size_t buffer_size = default_buffer_size);
+
+	buffered_cout_or_file(buffered_cout_or_file const&) = delete;
+	buffered_cout_or_file& operator=(buffered_cout_or_file const&) = delete;
+
+	/**
+	  * writing to the moved-from object throws `std::logic_error`, until
+	  * another object is assigned to it
+	  */
+	buffered_cout_or_file(buffered_cout_or_file&& other) noexcept;
+	buffered_cout_or_file& operator=(buffered_cout_or_file&& other) noexcept;
+
+	/**
+	  * flushes the buffer; errors are ignored, call `flush` to see them
+	  */
+	~buffered_cout_or_file();
+
+	bool is_open() const noexcept;
+
+	void write(char const* ptr, std::size_t count);
+	void write(std::span<char const> data);
+	void put(char c);
+
+	/**
+	  * writes the buffer to the output; throws `std::runtime_error`
+	  * if the output fails
+	  */
+	void flush();
+
+	/**
+	  * writes strings and characters as they are and numbers
+	  * with `std::to_chars`
+	  */
+	template<class T>
+	buffered_cout_or_file& operator<<(T const& value);
+
+private:
+	/**
+	  * enough for any number written by `std::to_chars`, the buffer is
+	  * never smaller than it
+	  */
+	static constexpr std::size_t max_number_size = 64;
+
+	void close() noexcept;
+
+	// the buffer of a moved-from object is empty
+	void check_not_moved_from() const;
+
+	std::FILE* m_file = nullptr;
+	std::vector<char> m_buffer;
+	std::size_t m_used = 0;
+};
+
+template<class T>
+buffered_cout_or_file& buffered_cout_or_file::operator<<(T const& value)
+{
+	if constexpr(std::same_as<T, char>){
+		put(value);
+	}else if constexpr(std::is_arithmetic_v<T> && !std::same_as<T, bool>){
+		check_not_moved_from();
+		if(m_buffer.size() - m_used < max_number_size)
+			flush();
+
+		auto const first = m_buffer.data() + m_used;
+		auto const [ptr, ec] = std::to_chars(
+			first, first + max_number_size, value);
+		m_used += static_cast<std::size_t>(ptr - first);
+	}else{
+		std::string_view const str{ value };
+		write(str.data(), str.size());
+	}
+
+	return *this;
+}
+
+/**
+  * types that can be parsed with `std::from_chars` as numbers; the
+  * arbitrary integers are parsed into their underlying integer
+  */
+template<class T>
+concept from_chars_parsable = (std::integral<T>
+		&& !std::same_as<T, bool>
+		&& !std::same_as<T, char>)
+	|| std::floating_point<T>
+	|| util::arbitrary_integer<T>;
+
+namespace detail{
+
+template<from_chars_parsable T>
+struct parsed_type{
+	using type = util::underlying_integer_for_t<T>;
+};
+
+template<std::floating_point T>
+struct parsed_type<T>{
+	using type = T;
+};
+
+template<class T>
+struct remove_optional{
+	using type = T;
+};
+
+template<class T>
+struct remove_optional<std::optional<T>>{
+	using type = T;
+};
+
+} // end of namespace detail
+
+/**
+  * error of a failed parse
+  *
+  * `code` is `std::errc::invalid_argument` if the field is not a number
+  * or has trailing characters and `std::errc::result_out_of_range` if
+  * the number does not fit in the type; `position` is the offset in the
+  * field where the parse stopped
+  */
+struct parse_error{
+	std::errc code;
+	std::size_t position;
+};
+
+namespace detail{
+
+constexpr bool is_blank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n'
+		|| c == '\v' || c == '\f';
+}
+
+constexpr std::string_view trim_blanks(std::string_view s)
+{
+	while(!s.empty() && is_blank(s.front()))
+		s.remove_prefix(1);
+	while(!s.empty() && is_blank(s.back()))
+		s.remove_suffix(1);
+	return s;
+}
+
+} // end of namespace detail
+
+/**
+  * parses the number in `field` without allocating and independently
+  * of the locale
+  *
+  * surrounding blanks and a leading '+' are accepted like in
+  * `operator>>`, but any other trailing character is an error
+  */
+template<from_chars_parsable T>
+std::expected<typename detail::parsed_type<T>::type, parse_error>
+from_chars(std::string_view field)
+{
+	using value_type = typename detail::parsed_type<T>::type;
+
+	auto const trimmed = detail::trim_blanks(field);
+	auto const offset = static_cast<std::size_t>(trimmed.data() - field.data());
+
+	auto first = trimmed.data();
+	auto const last = first + trimmed.size();
+
+	if(first != last && *first == '+'){
+		++first;
+		if(first != last && *first == '-'){
+			return std::unexpected(
+				parse_error{ std::errc::invalid_argument, offset + 1 });
+		}
+	}
+
+	value_type value{};
+	auto const [ptr, ec] = std::from_chars(first, last, value);
+
+	auto const position = offset
+		+ static_cast<std::size_t>(ptr - trimmed.data());
+
+	if(ec != std::errc{})
+		return std::unexpected(parse_error{ ec, position });
+
+	if(ptr != last){
+		return std::unexpected(
+			parse_error{ std::errc::invalid_argument, position });
+	}
+
+	if constexpr(util::arbitrary_integer<T>){
+		if(value < std::numeric_limits<T>::min()
+			|| value > std::numeric_limits<T>::max())
+		{
+			return std::unexpected(
+				parse_error{ std::errc::result_out_of_range, offset });
+		}
+	}
+
+	return value;
+}
+
+/**
+  * parses the number in `field` and throws `std::runtime_error` if
+  * it fails
+  */
+template<from_chars_parsable T>
+typename detail::parsed_type<T>::type from_chars_or_throw(std::string_view field)
+{
+	auto result = util::from_chars<T>(field);
+
+	if(!result.has_value()){
+		std::stringstream ss;
+		ss << "could not parse \"" << field << "\": "
+			<< std::make_error_code(result.error().code).message()
+			<< " at position " << result.error().position;
+		throw std::runtime_error(ss.str());
+	}
+
+	return *result;
+}
+
 /**
   * functor to extract a placeholder of type T
   * from a buffer
@@ -90,6 +377,12 @@ struct stream_extractor{
 		std::stringstream ss(buffer);
 		ss >> ref;
 	}
+
+	void operator()(std::string_view buffer)
+	{
+		std::stringstream ss{ std::string{ buffer } };
+		ss >> ref;
+	}
 };
 
 /**
@@ -111,6 +404,244 @@ struct stream_extractor<std::optional<T>>{
 		ss >> tmp;
 		ref = tmp;
 	}
+
+	void operator()(std::string_view buffer)
+	{
+		T tmp;
+		std::stringstream ss{ std::string{ buffer } };
+		ss >> tmp;
+		ref = tmp;
+	}
+};
+
+/**
+  * functor to extract a number from a buffer with `std::from_chars`;
+  * throws `std::runtime_error` if the buffer is not a number of type T
+  *
+  * unlike `stream_extractor`, which leaves the failures to the stream,
+  * a malformed buffer is never read as a number
+  */
+template<class T>
+struct from_chars_extractor;
+
+template<from_chars_parsable T>
+struct from_chars_extractor<T>{
+	using value_type = typename detail::parsed_type<T>::type;
+
+	value_type& ref;
+
+	explicit from_chars_extractor(value_type& a_placeholder)
+		: ref(a_placeholder)
+	{}
+
+	void operator()(std::string_view buffer)
+	{
+		ref = util::from_chars_or_throw<T>(buffer);
+	}
+};
+
+/**
+  * functor to extract an optional number from a buffer with
+  * `std::from_chars`; a blank buffer or a malformed number
+  * extracts `std::nullopt`
+  */
+template<from_chars_parsable T>
+struct from_chars_extractor<std::optional<T>>{
+	using value_type = typename detail::parsed_type<T>::type;
+
+	std::optional<value_type>& ref;
+
+	explicit from_chars_extractor(std::optional<value_type>& a_placeholder)
+		: ref(a_placeholder)
+	{}
+
+	void operator()(std::string_view buffer)
+	{
+		auto result = util::from_chars<T>(buffer);
+		if(result.has_value())
+			ref = *result;
+		else
+			ref = std::nullopt;
+	}
+};
+
+/**
+  * options of the delimited buffer tokenizer
+  *
+  * if `merge_delimiters` is set, consecutive delimiters are
+  * treated as one, which is what whitespace separated files need
+  */
+struct tokenizer_options{
+	char delimiter = ',';
+	bool merge_delimiters = false;
+};
+
+/**
+  * calls `f(line, column, field)` for every field of the delimited
+  * `buffer`; fields are views into the buffer, lines are counted
+  * from 0 and blank lines are skipped
+  */
+template<class F>
+void for_each_field(
+	std::string_view buffer,
+	F&& f,
+	tokenizer_options const& options = {})
+{
+	std::size_t line_number = 0;
+
+	while(!buffer.empty()){
+		auto const eol = buffer.find('\n');
+		auto line = buffer.substr(0, eol);
+		buffer.remove_prefix(
+			eol == std::string_view::npos ? buffer.size() : eol + 1);
+
+		if(!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		if(!detail::trim_blanks(line).empty()){
+			std::size_t column = 0;
+
+			while(true){
+				auto const end = line.find(options.delimiter);
+				auto const field = line.substr(0, end);
+
+				if(!options.merge_delimiters || !field.empty())
+					f(line_number, column++, field);
+
+				if(end == std::string_view::npos)
+					break;
+
+				line.remove_prefix(end + 1);
+			}
+		}
+
+		++line_number;
+	}
+}
+
+namespace detail{
+
+template<class T>
+struct column_type{
+	using type = typename parsed_type<T>::type;
+};
+
+template<class T>
+struct column_type<std::optional<T>>{
+	using type = std::optional<typename parsed_type<T>::type>;
+};
+
+template<class T>
+struct column_parser{
+	static void parse(std::string_view field, auto& column)
+	{
+		column.push_back(util::from_chars_or_throw<T>(field));
+	}
+};
+
+template<class T>
+struct column_parser<std::optional<T>>{
+	static void parse(std::string_view field, auto& column)
+	{
+		if(detail::trim_blanks(field).empty())
+			column.push_back(std::nullopt);
+		else
+			column.push_back(util::from_chars_or_throw<T>(field));
+	}
 };
 
+[[noreturn]] inline void throw_field_error(
+	std::size_t line,
+	std::size_t column,
+	std::string_view what)
+{
+	std::stringstream ss;
+	ss << "line " << line + 1 << ", column " << column + 1 << ": " << what;
+	throw std::runtime_error(ss.str());
+}
+
+[[noreturn]] inline void throw_row_error(
+	std::size_t line,
+	std::size_t expected,
+	std::size_t found)
+{
+	std::stringstream ss;
+	ss << "line " << line + 1 << ": expected " << expected
+		<< " fields but found " << found;
+	throw std::runtime_error(ss.str());
+}
+
+} // end of namespace detail
+
+/**
+  * parses a delimited buffer with one row per line into one vector per
+  * column; a `std::optional<T>` column accepts empty fields
+  *
+  * the fields are parsed in place with `std::from_chars`, so the only
+  * allocations are the ones of the columns, and any malformed field or
+  * row with the wrong number of fields throws `std::runtime_error`
+  */
+template<class ... Ts>
+	requires (from_chars_parsable<
+		typename detail::remove_optional<Ts>::type> && ...)
+std::tuple<std::vector<typename detail::column_type<Ts>::type>...>
+parse_columns(std::string_view buffer, tokenizer_options const& options = {})
+{
+	constexpr auto n_columns = sizeof...(Ts);
+
+	std::tuple<std::vector<typename detail::column_type<Ts>::type>...> columns;
+
+	auto const n_lines = static_cast<std::size_t>(
+		std::ranges::count(buffer, '\n')) + 1;
+	std::apply([n_lines](auto& ... c){ (c.reserve(n_lines), ...); }, columns);
+
+	constexpr auto no_line = std::numeric_limits<std::size_t>::max();
+
+	std::size_t current_line = no_line;
+	std::size_t n_fields = 0;
+
+	auto check_row = [&]
+	{
+		if(current_line != no_line && n_fields != n_columns)
+			detail::throw_row_error(current_line, n_columns, n_fields);
+	};
+
+	auto parse_field = [&]<std::size_t ... I>(
+		std::index_sequence<I...>,
+		std::size_t column,
+		std::string_view field)
+	{
+		((column == I
+			? detail::column_parser<Ts>::parse(field, std::get<I>(columns))
+			: void()), ...);
+	};
+
+	util::for_each_field(
+		buffer,
+		[&](std::size_t line, std::size_t column, std::string_view field)
+		{
+			if(line != current_line){
+				check_row();
+				current_line = line;
+				n_fields = 0;
+			}
+
+			++n_fields;
+
+			if(column >= n_columns)
+				return;
+
+			try{
+				parse_field(std::index_sequence_for<Ts...>{}, column, field);
+			}catch(std::runtime_error const& e){
+				detail::throw_field_error(line, column, e.what());
+			}
+		},
+		options);
+
+	check_row();
+
+	return columns;
+}
+
 } // end of namespace util
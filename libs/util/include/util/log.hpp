@@ -1,7 +1,479 @@
 #pragma once
 
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/sinks/basic_file_sink.h"
 
 namespace slg = spdlog;
+
+/**
+  * levels below this one are removed at compile time from the
+  * `util::logging` functions; 0 is trace and 6 is off
+  */
+#ifndef UTIL_LOG_ACTIVE_LEVEL
+#define UTIL_LOG_ACTIVE_LEVEL 0
+#endif
+
+/**
+  * @file log.hpp asynchronous logging facade over spdlog
+  *
+  * the arguments of a message are captured by value on the calling
+  * thread and formatted by a background thread, which writes them to
+  * a spdlog logger; format strings are not copied and must outlive the
+  * message, which string literals do
+  *
+  * the `UTIL_LOG` and `UTIL_LOG_LIMITED` macros are the intended entry
+  * points: unlike the functions, they do not evaluate the arguments of
+  * a message whose level is disabled
+  */
+
+namespace util::logging{
+
+enum class level : int {
+	TRACE = spdlog::level::trace,
+	DEBUG = spdlog::level::debug,
+	INFO = spdlog::level::info,
+	WARN = spdlog::level::warn,
+	ERROR = spdlog::level::err,
+	CRITICAL = spdlog::level::critical,
+	OFF = spdlog::level::off
+};
+
+inline constexpr auto active_level = static_cast<level>(UTIL_LOG_ACTIVE_LEVEL);
+
+constexpr bool is_compiled_in(level lvl) noexcept
+{
+	return lvl >= active_level && lvl != level::OFF;
+}
+
+/**
+  * lets through at most one call per period; the calls in between
+  * are counted as suppressed
+  */
+class rate_limiter{
+public:
+	explicit rate_limiter(std::chrono::nanoseconds period) noexcept
+		: m_period(period)
+	{}
+
+	/**
+	  * returns the number of calls suppressed since the last one let
+	  * through or `std::nullopt` if this call is suppressed
+	  */
+	std::optional<std::uint64_t> try_acquire() noexcept
+	{
+		auto const now = std::chrono::steady_clock::now()
+			.time_since_epoch().count();
+
+		auto next = m_next.load(std::memory_order_relaxed);
+
+		if(now < next || !m_next.compare_exchange_strong(
+			next, now + m_period.count(), std::memory_order_relaxed))
+		{
+			m_suppressed.fetch_add(1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		return m_suppressed.exchange(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::chrono::nanoseconds m_period;
+	std::atomic<std::chrono::steady_clock::rep> m_next{
+		std::numeric_limits<std::chrono::steady_clock::rep>::min()
+	};
+	std::atomic<std::uint64_t> m_suppressed{ 0 };
+};
+
+namespace detail{
+
+inline constexpr std::size_t record_storage_size = 128;
+
+/**
+  * a message waiting to be formatted, the arguments are stored
+  * in `storage` and known only by `format` and `destroy`
+  */
+struct record{
+	using format_function = void (*)(record const&, fmt::memory_buffer&);
+	using destroy_function = void (*)(record&) noexcept;
+
+	level lvl;
+	spdlog::log_clock::time_point time;
+	std::uint64_t suppressed;
+	fmt::string_view format_string;
+	format_function format;
+	destroy_function destroy;
+	alignas(std::max_align_t) std::byte storage[record_storage_size];
+};
+
+/**
+  * strings are copied, because the views may not outlive the call
+  */
+template<class T>
+using captured_t = std::conditional_t<
+	std::is_convertible_v<T, std::string_view>,
+	std::string,
+	std::decay_t<T>
+>;
+
+template<class Tuple>
+Tuple const& stored_arguments(record const& r) noexcept
+{
+	return *std::launder(reinterpret_cast<Tuple const*>(r.storage));
+}
+
+template<class Tuple>
+void format_record(record const& r, fmt::memory_buffer& out)
+{
+	std::apply(
+		[&](auto const& ... args)
+		{
+			fmt::vformat_to(
+				std::back_inserter(out),
+				r.format_string,
+				fmt::make_format_args(args...));
+		},
+		stored_arguments<Tuple>(r));
+}
+
+template<class Tuple>
+void destroy_record(record& r) noexcept
+{
+	std::destroy_at(std::launder(reinterpret_cast<Tuple*>(r.storage)));
+}
+
+template<class Tuple>
+inline constexpr bool fits_in_record = sizeof(Tuple) <= record_storage_size
+	&& alignof(Tuple) <= alignof(std::max_align_t);
+
+/**
+  * captures the arguments in the record; if they do not fit, the
+  * message is formatted right away and the resulting string is stored
+  */
+template<class ... Args>
+void capture(
+	record& r,
+	fmt::format_string<Args...> format_string,
+	Args&& ... args)
+{
+	using tuple_type = std::tuple<captured_t<Args>...>;
+
+	if constexpr(fits_in_record<tuple_type>){
+		r.format_string = format_string;
+		std::construct_at(
+			reinterpret_cast<tuple_type*>(r.storage),
+			std::forward<Args>(args)...);
+		r.format = &format_record<tuple_type>;
+		r.destroy = &destroy_record<tuple_type>;
+	}else{
+		using string_tuple = std::tuple<std::string>;
+		r.format_string = "{}";
+		std::construct_at(
+			reinterpret_cast<string_tuple*>(r.storage),
+			fmt::format(format_string, std::forward<Args>(args)...));
+		r.format = &format_record<string_tuple>;
+		r.destroy = &destroy_record<string_tuple>;
+	}
+}
+
+/**
+  * bounded lock-free queue of records for many producers and one
+  * consumer, the records are built and consumed in place
+  */
+class record_queue{
+public:
+	explicit record_queue(std::size_t capacity)
+		: m_slots(std::make_unique<slot[]>(std::bit_ceil(capacity))),
+		  m_mask(std::bit_ceil(capacity) - 1)
+	{
+		for(std::size_t i=0; i<=m_mask; ++i)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/**
+	  * builds a record with `init(record&)` and returns false,
+	  * without calling it, if the queue is full
+	  */
+	template<class F>
+	bool try_push(F&& init)
+	{
+		auto position = m_enqueue.load(std::memory_order_relaxed);
+
+		while(true){
+			auto& s = m_slots[position & m_mask];
+			auto const sequence = s.sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<std::ptrdiff_t>(sequence)
+				- static_cast<std::ptrdiff_t>(position);
+
+			if(diff == 0){
+				if(m_enqueue.compare_exchange_weak(
+					position, position + 1, std::memory_order_relaxed))
+				{
+					init(s.r);
+					s.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				position = m_enqueue.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	  * calls `f(record&)` on the oldest record and releases its slot,
+	  * returns false if the queue is empty; only one thread may pop
+	  */
+	template<class F>
+	bool try_pop(F&& f)
+	{
+		auto& s = m_slots[m_dequeue & m_mask];
+		auto const sequence = s.sequence.load(std::memory_order_acquire);
+
+		if(sequence != m_dequeue + 1)
+			return false;
+
+		f(s.r);
+		s.sequence.store(m_dequeue + m_mask + 1, std::memory_order_release);
+		++m_dequeue;
+		return true;
+	}
+
+private:
+	struct slot{
+		std::atomic<std::size_t> sequence;
+		record r;
+	};
+
+	std::unique_ptr<slot[]> m_slots;
+	std::size_t m_mask;
+
+	alignas(64) std::atomic<std::size_t> m_enqueue{ 0 };
+	alignas(64) std::size_t m_dequeue = 0;
+};
+
+} // end of namespace detail
+
+/**
+  * logger that formats and writes the messages in a background thread
+  *
+  * the calling thread only captures the arguments in a ring buffer;
+  * when the buffer is full the message is dropped and counted, so
+  * logging never blocks
+  */
+class async_logger{
+public:
+	static constexpr std::size_t default_capacity = 8192;
+
+	explicit async_logger(
+		std::shared_ptr<spdlog::logger> sink,
+		std::size_t capacity = default_capacity);
+
+	async_logger(async_logger const&) = delete;
+	async_logger& operator=(async_logger const&) = delete;
+
+	/**
+	  * writes every pending message before returning
+	  */
+	~async_logger();
+
+	void set_level(level lvl) noexcept;
+	level get_level() const noexcept;
+	bool should_log(level lvl) const noexcept;
+
+	/**
+	  * number of messages dropped because the buffer was full
+	  */
+	std::uint64_t dropped() const noexcept;
+
+	/**
+	  * waits until every message logged before the call is written
+	  * and flushes the sink
+	  */
+	void flush();
+
+	template<class ... Args>
+	void log(
+		level lvl,
+		std::uint64_t suppressed,
+		fmt::format_string<Args...> format_string,
+		Args&& ... args)
+	{
+		if(!should_log(lvl))
+			return;
+
+		auto const pushed = m_queue.try_push([&](detail::record& r)
+		{
+			r.lvl = lvl;
+			r.time = spdlog::log_clock::now();
+			r.suppressed = suppressed;
+
+			try{
+				detail::capture(
+					r, format_string, std::forward<Args>(args)...);
+			}catch(...){
+				detail::capture(r, "could not capture the log message");
+			}
+		});
+
+		if(!pushed){
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// the worker sleeps only when every counted message is written
+		if(m_pushed.fetch_add(1) == m_written.load())
+			wake_worker();
+	}
+
+private:
+	void wake_worker() noexcept;
+	void consume(std::stop_token stop);
+	bool write_pending(fmt::memory_buffer& buffer);
+
+	std::shared_ptr<spdlog::logger> m_sink;
+	detail::record_queue m_queue;
+	std::atomic<level> m_level{ level::TRACE };
+	std::atomic<std::uint64_t> m_pushed{ 0 };
+	std::atomic<std::uint64_t> m_written{ 0 };
+	std::atomic<std::uint64_t> m_dropped{ 0 };
+	std::atomic<std::uint64_t> m_wakeups{ 0 };
+	std::uint64_t m_reported_dropped = 0;
+	std::jthread m_worker;
+};
+
+/**
+  * the logger of the free functions, it writes to the spdlog
+  * default logger
+  */
+async_logger& default_logger();
+
+template<level L, class ... Args>
+void log(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	if constexpr(is_compiled_in(L)){
+		default_logger().log(
+			L, 0, format_string, std::forward<Args>(args)...);
+	}
+}
+
+/**
+  * logs only if `limiter` lets the call through, the message reports
+  * how many calls were suppressed since the last one
+  */
+template<level L, class ... Args>
+void log(
+	rate_limiter& limiter,
+	fmt::format_string<Args...> format_string,
+	Args&& ... args)
+{
+	if constexpr(is_compiled_in(L)){
+		auto& logger = default_logger();
+
+		if(!logger.should_log(L))
+			return;
+
+		if(auto suppressed = limiter.try_acquire(); suppressed.has_value()){
+			logger.log(
+				L, *suppressed, format_string, std::forward<Args>(args)...);
+		}
+	}
+}
+
+template<class ... Args>
+void trace(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::TRACE>(format_string, std::forward<Args>(args)...);
+}
+
+template<class ... Args>
+void debug(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::DEBUG>(format_string, std::forward<Args>(args)...);
+}
+
+template<class ... Args>
+void info(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::INFO>(format_string, std::forward<Args>(args)...);
+}
+
+template<class ... Args>
+void warn(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::WARN>(format_string, std::forward<Args>(args)...);
+}
+
+template<class ... Args>
+void error(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::ERROR>(format_string, std::forward<Args>(args)...);
+}
+
+template<class ... Args>
+void critical(fmt::format_string<Args...> format_string, Args&& ... args)
+{
+	logging::log<level::CRITICAL>(format_string, std::forward<Args>(args)...);
+}
+
+} // end of namespace util::logging
+
+/**
+  * `UTIL_LOG(INFO, "{}", f())` logs like `util::logging::log`, but `f()`
+  * is evaluated only if the level is compiled in and enabled in the
+  * default logger
+  */
+#define UTIL_LOG(lvl, ...)                                                   \
+	do{                                                                      \
+		if constexpr(::util::logging::is_compiled_in(                        \
+			::util::logging::level::lvl))                                    \
+		{                                                                    \
+			if(::util::logging::default_logger().should_log(                 \
+				::util::logging::level::lvl))                                \
+			{                                                                \
+				::util::logging::log<::util::logging::level::lvl>(           \
+					__VA_ARGS__);                                            \
+			}                                                                \
+		}                                                                    \
+	}while(false)
+
+/**
+  * `UTIL_LOG_LIMITED(INFO, limiter, "{}", f())` logs like the rate limited
+  * `util::logging::log`, but `f()` is evaluated only for the calls that
+  * `limiter` lets through
+  */
+#define UTIL_LOG_LIMITED(lvl, limiter, ...)                                  \
+	do{                                                                      \
+		if constexpr(::util::logging::is_compiled_in(                        \
+			::util::logging::level::lvl))                                    \
+		{                                                                    \
+			auto& util_log_logger = ::util::logging::default_logger();       \
+			if(util_log_logger.should_log(::util::logging::level::lvl)){     \
+				if(auto const util_log_suppressed = (limiter).try_acquire()) \
+				{                                                            \
+					util_log_logger.log(                                     \
+						::util::logging::level::lvl,                         \
+						*util_log_suppressed,                                \
+						__VA_ARGS__);                                        \
+				}                                                            \
+			}                                                                \
+		}                                                                    \
+	}while(false)
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <deque>
+#include <exception>
 #include <numbers>
+#include <optional>
 #include <type_traits>
 #include <concepts>
 #include <functional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace util {
 
@@ -146,4 +155,333 @@ template<class Fn, std::floating_point Float, class FnExtreme = std::less<Float>
 	);
 }
 
+/**
+  * batched golden section search: advances many independent searches in
+  * lockstep, so each iteration evaluates the function once for all the
+  * searches that did not converge yet. the i-th search is the same of
+  * `golden_section_search(f_i, a[i], b[i], tol, extreme)`, so it returns
+  * the same points.
+  *
+  * @param f (std::span<std::size_t const> searches, std::span<Float const> x,
+  *        std::span<Float> fx) -> void; must store f_{searches[k]}(x[k])
+  *        in fx[k] for every k. the points of a call are independent, so
+  *        they can be evaluated with SIMD or in several threads
+  * @param a first elements of the domains
+  * @param b last elements of the domains
+  * @param tol tolerance of the searches; see `golden_section_search`
+  * @param extreme see `golden_section_search`
+  *
+  * @return the extreme point of each search
+  */
+template<class FnBatch, std::floating_point Float, class FnExtreme = std::less<Float>>
+	requires (std::is_invocable_v<
+		FnBatch,
+		std::span<std::size_t const>,
+		std::span<Float const>,
+		std::span<Float>>)
+[[nodiscard]] std::vector<Float> golden_section_search_batch(
+	FnBatch&& f,
+	std::span<Float const> a,
+	std::span<Float const> b,
+	Float tol = Float{1e-10},
+	FnExtreme extreme = FnExtreme{})
+{
+	static constexpr auto phi = std::numbers::phi_v<Float>;
+
+	if(a.size() != b.size()){
+		throw std::runtime_error(
+			"golden_section_search_batch with domains of different sizes"
+		);
+	}
+
+	auto const n = a.size();
+
+	std::vector<golden_section_state<Float>> states(n);
+	std::vector<std::size_t> searches(2*n);
+	std::vector<Float> x(2*n), fx(2*n);
+
+	for(std::size_t i=0; i<n; ++i){
+		auto& s = states[i];
+		s.a = a[i];
+		s.b = b[i];
+		s.c = b[i] - (b[i] - a[i]) / phi;
+		s.d = a[i] + (b[i] - a[i]) / phi;
+
+		searches[2*i] = searches[2*i + 1] = i;
+		x[2*i] = s.c;
+		x[2*i + 1] = s.d;
+	}
+
+	f(std::span<std::size_t const>{ searches },
+		std::span<Float const>{ x },
+		std::span<Float>{ fx });
+
+	for(std::size_t i=0; i<n; ++i){
+		states[i].fc = fx[2*i];
+		states[i].fd = fx[2*i + 1];
+	}
+
+	// indices of the searches to be advanced; every search takes at least
+	// one step, as the do-while of golden_section_search
+	std::vector<std::size_t> active(n);
+	for(std::size_t i=0; i<n; ++i)
+		active[i] = i;
+
+	// whether the k-th active search evaluates its inner left value
+	std::vector<uint8_t> evaluates_c(n);
+
+	while(!active.empty()){
+		auto const m = active.size();
+
+		for(std::size_t k=0; k<m; ++k){
+			auto& s = states[active[k]];
+
+			if(extreme(s.fc, s.fd)){
+				s.b = s.d;
+				s.d = s.c;
+				s.c = s.b - (s.b - s.a)/phi;
+
+				s.fb = s.fd;
+				s.fd = s.fc;
+
+				x[k] = s.c;
+				evaluates_c[k] = true;
+			}else{
+				s.a = s.c;
+				s.c = s.d;
+				s.d = s.a + (s.b - s.a)/phi;
+
+				s.fa = s.fc;
+				s.fc = s.fd;
+
+				x[k] = s.d;
+				evaluates_c[k] = false;
+			}
+		}
+
+		f(std::span<std::size_t const>{ active },
+			std::span<Float const>{ x.data(), m },
+			std::span<Float>{ fx.data(), m });
+
+		std::size_t next = 0;
+		for(std::size_t k=0; k<m; ++k){
+			auto const i = active[k];
+			auto& s = states[i];
+
+			if(evaluates_c[k])
+				s.fc = fx[k];
+			else
+				s.fd = fx[k];
+
+			if(std::fabs(s.b - s.a) > tol)
+				active[next++] = i;
+		}
+
+		active.resize(next);
+	}
+
+	std::vector<Float> result(n);
+	for(std::size_t i=0; i<n; ++i){
+		auto const& s = states[i];
+		result[i] = extreme(s.fc, s.fd) ? s.c : s.d;
+	}
+
+	return result;
+}
+
+/**
+  * k-section search: each iteration evaluates `k` equally spaced interior
+  * points of the domain at once and keeps the two subintervals around the
+  * best one, so the domain shrinks by a factor of 2/(k + 1) per iteration
+  * instead of the 1/phi of the golden section search. with the `k` points
+  * evaluated concurrently, the wall-clock time of a search is divided by
+  * about log(k + 1)/log(phi) - 1.
+  *
+  * @param f (std::span<Float const> x, std::span<Float> fx) -> void; must
+  *        store f(x[i]) in fx[i], for the `k` points of an iteration
+  * @param a first element of the domain
+  * @param b last element of the domain
+  * @param k number of interior points per iteration; at least 2
+  * @param tol tolerance of the algorithm; see `golden_section_search`
+  * @param extreme see `golden_section_search`
+  *
+  * @return the extreme point x, where f(x) is the extreme value
+  */
+template<class FnBatch, std::floating_point Float, class FnExtreme = std::less<Float>>
+	requires (std::is_invocable_v<FnBatch, std::span<Float const>, std::span<Float>>)
+[[nodiscard]] Float k_section_search(
+	FnBatch&& f,
+	Float a, Float b,
+	std::size_t k,
+	Float tol = Float{1e-10},
+	FnExtreme extreme = FnExtreme{})
+{
+	if(k < 2){
+		throw std::runtime_error(
+			"k_section_search needs at least two interior points"
+		);
+	}
+
+	std::vector<Float> x(k), fx(k);
+	auto best = std::size_t{0};
+
+	do {
+		auto const step = (b - a)/static_cast<Float>(k + 1);
+
+		for(std::size_t i=0; i<k; ++i)
+			x[i] = a + step*static_cast<Float>(i + 1);
+
+		f(std::span<Float const>{ x }, std::span<Float>{ fx });
+
+		best = 0;
+		for(std::size_t i=1; i<k; ++i){
+			if(extreme(fx[i], fx[best]))
+				best = i;
+		}
+
+		auto const lo = best == 0 ? a : x[best - 1];
+		auto const hi = best == k - 1 ? b : x[best + 1];
+
+		a = lo;
+		b = hi;
+	} while(std::fabs(b - a) > tol);
+
+	return x[best];
+}
+
+namespace detail{
+
+/**
+  * evaluates `f` on the `k` points of each iteration of a k-section
+  * search, the first on the calling thread and the others on `k - 1`
+  * threads started once for the whole search
+  */
+template<class Fn, std::floating_point Float>
+class k_section_workers{
+public:
+	k_section_workers(Fn& f, std::size_t k)
+		: m_f(f), m_errors(k)
+	{
+		m_threads.reserve(k - 1);
+		for(std::size_t i=1; i<k; ++i){
+			m_threads.emplace_back([this, i](std::stop_token stop)
+			{
+				work(stop, i);
+			});
+		}
+	}
+
+	k_section_workers(k_section_workers const&) = delete;
+	k_section_workers& operator=(k_section_workers const&) = delete;
+
+	~k_section_workers()
+	{
+		for(auto& t : m_threads)
+			t.request_stop();
+
+		m_generation.fetch_add(1);
+		m_generation.notify_all();
+	}
+
+	/**
+	  * stores `f(x[i])` in `fx[i]`; rethrows the exception of the
+	  * first point whose evaluation threw, once every point is done
+	  */
+	void operator()(std::span<Float const> x, std::span<Float> fx)
+	{
+		m_x = x;
+		m_fx = fx;
+		m_remaining.store(m_threads.size());
+		m_generation.fetch_add(1);
+		m_generation.notify_all();
+
+		evaluate(0);
+
+		for(auto r = m_remaining.load(); r != 0; r = m_remaining.load())
+			m_remaining.wait(r);
+
+		std::exception_ptr error;
+		for(auto& e : m_errors){
+			if(e && !error)
+				error = e;
+			e = nullptr;
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+	}
+
+private:
+	void evaluate(std::size_t i)
+	{
+		try{
+			m_fx[i] = m_f(m_x[i]);
+		}catch(...){
+			m_errors[i] = std::current_exception();
+		}
+	}
+
+	void work(std::stop_token stop, std::size_t i)
+	{
+		auto generation = uint64_t{0};
+
+		while(true){
+			m_generation.wait(generation);
+			generation = m_generation.load();
+
+			if(stop.stop_requested())
+				return;
+
+			evaluate(i);
+
+			if(m_remaining.fetch_sub(1) == 1)
+				m_remaining.notify_one();
+		}
+	}
+
+	Fn& m_f;
+	std::span<Float const> m_x;
+	std::span<Float> m_fx;
+	std::vector<std::exception_ptr> m_errors;
+	std::atomic<uint64_t> m_generation{ 0 };
+	std::atomic<std::size_t> m_remaining{ 0 };
+
+	// the last member, so the threads stop before the rest is destroyed
+	std::vector<std::jthread> m_threads;
+};
+
+} // end of namespace detail
+
+/**
+  * k-section search that evaluates the `threads` interior points of each
+  * iteration concurrently, one per thread; see `k_section_search`. the
+  * threads are started once for the whole search, so it pays off when
+  * `f` is expensive compared to waking a thread
+  *
+  * @param f float -> float unimodal function; it must be thread safe.
+  *        if it throws, the iteration is finished and the exception of
+  *        the leftmost point that threw is rethrown on the calling thread
+  */
+template<class Fn, std::floating_point Float, class FnExtreme = std::less<Float>>
+	requires (std::is_invocable_r_v<Float, Fn, Float>)
+[[nodiscard]] Float parallel_k_section_search(
+	Fn&& f,
+	Float a, Float b,
+	std::size_t threads,
+	Float tol = Float{1e-10},
+	FnExtreme extreme = FnExtreme{})
+{
+	if(threads < 2){
+		throw std::runtime_error(
+			"k_section_search needs at least two interior points"
+		);
+	}
+
+	detail::k_section_workers<std::remove_reference_t<Fn>, Float> workers{
+		f, threads
+	};
+
+	return k_section_search(workers, a, b, threads, tol, extreme);
+}
+
 }
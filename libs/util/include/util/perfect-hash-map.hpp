@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "util/static-string.hpp"
+
+/**
+  * @file perfect-hash-map.hpp maps with keys known at compile time
+  *
+  * the keys are placed with the PTHash scheme: a key goes to the bucket
+  * given by its hash and every bucket has a pilot, searched when the map
+  * is built, such that `mix(hash ^ pilot)` sends the keys of the bucket
+  * to free slots; a lookup is one hash of the string, two table reads
+  * and one comparison
+  */
+
+namespace util{
+
+namespace detail{
+
+/**
+  * the finalizer of splitmix64
+  */
+constexpr uint64_t mix64(uint64_t h) noexcept
+{
+	h ^= h >> 30;
+	h *= 0xbf58476d1ce4e5b9;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111eb;
+	h ^= h >> 31;
+	return h;
+}
+
+/**
+  * FNV-1a followed by `mix64`, so the low and the high bits are both
+  * usable
+  */
+constexpr uint64_t perfect_hash(std::string_view s) noexcept
+{
+	uint64_t h = 0xcbf29ce484222325;
+	for(auto c : s){
+		h ^= static_cast<unsigned char>(c);
+		h *= 0x100000001b3;
+	}
+
+	return mix64(h);
+}
+
+/**
+  * the length of the string in a `static_string`, without the null
+  * terminator
+  */
+template<uint64_t N>
+constexpr uint64_t static_string_length(
+	basic_static_string<char, N> const& s) noexcept
+{
+	return (N > 0 && s[N - 1] == '\0') ? N - 1 : N;
+}
+
+/**
+  * `N` of the `basic_static_string<char, N>` base of `T`, which may be
+  * a `static_string` or the result of a concatenation
+  */
+template<uint64_t N>
+std::integral_constant<uint64_t, N> static_string_capacity(
+	basic_static_string<char, N> const&);
+
+template<class T>
+inline constexpr uint64_t static_string_capacity_v = decltype(
+	static_string_capacity(std::declval<T const&>()))::value;
+
+template<class T>
+concept static_string_entry = requires {
+	static_string_capacity_v<typename T::first_type>;
+	typename T::second_type;
+};
+
+} // end of namespace detail
+
+/**
+  * a read-only map from the `K` strings known at compile time to values
+  * of type `V`; the keys use `C` characters in total
+  *
+  * the map does not allocate and can be built and queried in constant
+  * expressions; build it with `make_perfect_hash_map`
+  */
+template<class V, std::size_t K, std::size_t C>
+class perfect_hash_map{
+public:
+	static_assert(K > 0, "perfect_hash_map needs at least one key");
+
+	using mapped_type = V;
+	using size_type = std::size_t;
+
+	static constexpr size_type n_buckets = (K + 1)/2;
+	static constexpr size_type n_slots = std::bit_ceil(2*K);
+
+	/**
+	  * throws `std::logic_error` if a key is repeated, which makes it a
+	  * compilation error in a constant expression
+	  */
+	template<detail::static_string_entry ... Entries>
+	constexpr explicit perfect_hash_map(Entries const& ... entries)
+		: m_values{ static_cast<V>(entries.second)... }
+	{
+		static_assert(sizeof...(Entries) == K);
+
+		size_type i = 0;
+		size_type c = 0;
+		auto add_key = [&](auto const& s)
+		{
+			m_offsets[i++] = static_cast<uint32_t>(c);
+			for(uint64_t j=0; j<detail::static_string_length(s); ++j)
+				m_chars[c++] = s[j];
+		};
+
+		(add_key(entries.first), ...);
+		m_offsets[K] = static_cast<uint32_t>(c);
+
+		build();
+	}
+
+	static constexpr size_type size() noexcept
+	{
+		return K;
+	}
+
+	constexpr std::string_view key(size_type i) const noexcept
+	{
+		return {
+			m_chars.data() + m_offsets[i],
+			m_offsets[i + 1] - m_offsets[i]
+		};
+	}
+
+	constexpr V const& value(size_type i) const noexcept
+	{
+		return m_values[i];
+	}
+
+	/**
+	  * the position of `k` in the arguments of `make_perfect_hash_map`
+	  */
+	constexpr std::optional<size_type> index_of(std::string_view k)
+		const noexcept
+	{
+		auto const h = detail::perfect_hash(k);
+		auto const i = m_slots[slot_of(h, m_pilots[bucket_of(h)])];
+
+		if(i == K || key(i) != k)
+			return std::nullopt;
+
+		return i;
+	}
+
+	/**
+	  * the value of `k` or `nullptr` if `k` is not a key
+	  */
+	constexpr V const* find(std::string_view k) const noexcept
+	{
+		auto const i = index_of(k);
+		return i.has_value() ? &m_values[*i] : nullptr;
+	}
+
+	constexpr bool contains(std::string_view k) const noexcept
+	{
+		return index_of(k).has_value();
+	}
+
+	/**
+	  * the value of `k`; throws `std::out_of_range` if it is not a key
+	  */
+	constexpr V const& at(std::string_view k) const
+	{
+		if(auto const v = find(k); v != nullptr)
+			return *v;
+
+		throw std::out_of_range(
+			"perfect_hash_map has no key " + std::string{ k });
+	}
+
+private:
+	static constexpr uint64_t max_pilot = uint64_t{1} << 20;
+
+	static constexpr size_type bucket_of(uint64_t h) noexcept
+	{
+		return static_cast<size_type>((h >> 32) % n_buckets);
+	}
+
+	static constexpr size_type slot_of(uint64_t h, uint64_t pilot) noexcept
+	{
+		return static_cast<size_type>(
+			detail::mix64(h ^ pilot) & (n_slots - 1));
+	}
+
+	/**
+	  * places the largest buckets first, each one with the first pilot
+	  * that sends its keys to free and distinct slots
+	  */
+	constexpr void build()
+	{
+		std::array<uint64_t, K> hashes{};
+		std::array<size_type, K> order{};
+
+		for(size_type i=0; i<K; ++i){
+			hashes[i] = detail::perfect_hash(key(i));
+			order[i] = i;
+
+			for(size_type j=0; j<i; ++j){
+				if(hashes[j] == hashes[i] && key(j) == key(i))
+					throw std::logic_error("repeated perfect_hash_map key");
+			}
+		}
+
+		std::array<size_type, n_buckets> bucket_size{};
+		for(auto h : hashes)
+			++bucket_size[bucket_of(h)];
+
+		std::sort(order.begin(), order.end(), [&](size_type a, size_type b)
+		{
+			auto const ba = bucket_of(hashes[a]);
+			auto const bb = bucket_of(hashes[b]);
+			return bucket_size[ba] != bucket_size[bb]
+				? bucket_size[ba] > bucket_size[bb]
+				: ba < bb;
+		});
+
+		m_slots.fill(static_cast<uint32_t>(K));
+		m_pilots.fill(0);
+
+		for(size_type first=0; first<K;){
+			auto const bucket = bucket_of(hashes[order[first]]);
+			auto const last = first + bucket_size[bucket];
+
+			m_pilots[bucket] = find_pilot(hashes, order, first, last);
+
+			for(auto j=first; j<last; ++j){
+				auto const s = slot_of(hashes[order[j]], m_pilots[bucket]);
+				m_slots[s] = static_cast<uint32_t>(order[j]);
+			}
+
+			first = last;
+		}
+	}
+
+	constexpr uint32_t find_pilot(
+		std::array<uint64_t, K> const& hashes,
+		std::array<size_type, K> const& order,
+		size_type first,
+		size_type last) const
+	{
+		for(uint64_t pilot=0; pilot<max_pilot; ++pilot){
+			auto fits = true;
+
+			for(auto j=first; fits && j<last; ++j){
+				auto const s = slot_of(hashes[order[j]], pilot);
+				fits = m_slots[s] == K;
+
+				for(auto k=first; fits && k<j; ++k)
+					fits = slot_of(hashes[order[k]], pilot) != s;
+			}
+
+			if(fits)
+				return static_cast<uint32_t>(pilot);
+		}
+
+		throw std::logic_error("no pilot found for a perfect_hash_map bucket");
+	}
+
+	std::array<char, C> m_chars{};
+	std::array<uint32_t, K + 1> m_offsets{};
+	std::array<V, K> m_values;
+	std::array<uint32_t, n_buckets> m_pilots{};
+	std::array<uint32_t, n_slots> m_slots{};
+};
+
+/**
+  * builds a `perfect_hash_map` from pairs of keys and values, as in
+  *
+  *     constexpr auto m = util::make_perfect_hash_map(
+  *         std::pair{ util::static_string("width"), 0 },
+  *         std::pair{ util::static_string("height"), 1 });
+  *
+  *     static_assert(*m.find("height") == 1);
+  */
+template<detail::static_string_entry ... Entries>
+constexpr auto make_perfect_hash_map(Entries const& ... entries)
+{
+	using value_type = std::common_type_t<typename Entries::second_type...>;
+
+	constexpr std::size_t n_chars = (detail::static_string_capacity_v<
+		typename Entries::first_type> + ... + 0);
+
+	return perfect_hash_map<value_type, sizeof...(Entries), n_chars>(
+		entries...);
+}
+
+} // end of namespace util
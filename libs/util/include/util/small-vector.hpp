@@ -0,0 +1,535 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "util/static-vector.hpp"
+
+namespace util{
+
+/**
+  * a vector that keeps up to `N` elements inline and moves them to the
+  * heap only when it grows past that, so short lists never allocate
+  *
+  * unlike `std::vector`, moving a vector whose elements are inline moves
+  * the elements one by one, and the iterators are invalidated by it
+  */
+template<class T, uint64_t N>
+class small_vector{
+public:
+	static_assert(N > 0, "small_vector needs an inline capacity");
+
+	using value_type = T;
+	using size_type = uint64_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = T const&;
+	using pointer = T*;
+	using const_pointer = T const*;
+	using iterator = T*;
+	using const_iterator = T const*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	static constexpr size_type inline_capacity = N;
+
+	small_vector() noexcept = default;
+
+	explicit small_vector(size_type n)
+	{
+		resize(n);
+	}
+
+	small_vector(size_type n, T const& value)
+	{
+		resize(n, value);
+	}
+
+	small_vector(std::initializer_list<T> values)
+	{
+		append(std::span{ values.begin(), values.size() });
+	}
+
+	template<std::input_iterator It, std::sentinel_for<It> S>
+	small_vector(It first, S last)
+	{
+		insert(end(), first, last);
+	}
+
+	small_vector(small_vector const& other)
+	{
+		append(std::span{ other.data(), other.size() });
+	}
+
+	small_vector(small_vector&& other)
+		noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		steal(other);
+	}
+
+	small_vector& operator=(small_vector const& other)
+	{
+		if(this != &other){
+			clear();
+			append(std::span{ other.data(), other.size() });
+		}
+
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& other)
+		noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if(this != &other){
+			clear();
+			release();
+			steal(other);
+		}
+
+		return *this;
+	}
+
+	~small_vector()
+	{
+		clear();
+		release();
+	}
+
+	size_type capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/**
+	  * whether the elements are in the inline storage
+	  */
+	bool is_inline() const noexcept
+	{
+		return m_data == m_inline.data();
+	}
+
+	T* data() noexcept
+	{
+		return m_data;
+	}
+
+	T const* data() const noexcept
+	{
+		return m_data;
+	}
+
+	iterator begin() noexcept
+	{
+		return m_data;
+	}
+
+	iterator end() noexcept
+	{
+		return m_data + m_size;
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return m_data;
+	}
+
+	const_iterator end() const noexcept
+	{
+		return m_data + m_size;
+	}
+
+	const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator{ end() };
+	}
+
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator{ begin() };
+	}
+
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator{ end() };
+	}
+
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator{ begin() };
+	}
+
+	T& operator[](size_type i) noexcept
+	{
+		return m_data[i];
+	}
+
+	T const& operator[](size_type i) const noexcept
+	{
+		return m_data[i];
+	}
+
+	/**
+	  * the element `i`; throws `std::out_of_range` if `i >= size()`
+	  */
+	T& at(size_type i)
+	{
+		check_index(i);
+		return m_data[i];
+	}
+
+	T const& at(size_type i) const
+	{
+		check_index(i);
+		return m_data[i];
+	}
+
+	T& front() noexcept
+	{
+		return m_data[0];
+	}
+
+	T const& front() const noexcept
+	{
+		return m_data[0];
+	}
+
+	T& back() noexcept
+	{
+		return m_data[m_size - 1];
+	}
+
+	T const& back() const noexcept
+	{
+		return m_data[m_size - 1];
+	}
+
+	/**
+	  * makes room for `n` elements, moving them to the heap if `n` is
+	  * greater than the inline capacity
+	  */
+	void reserve(size_type n)
+	{
+		if(n > m_capacity)
+			reallocate(n);
+	}
+
+	template<class ... Args>
+	T& emplace_back(Args&& ... args)
+	{
+		if(m_size < m_capacity){
+			auto const p = std::construct_at(
+				m_data + m_size, std::forward<Args>(args)...);
+			++m_size;
+			return *p;
+		}
+
+		/*
+		 * the new element is constructed before the others are moved,
+		 * because the arguments may refer to them
+		 */
+		auto const capacity = grown_capacity(m_size + 1);
+		auto const new_data = allocate(capacity);
+
+		try{
+			std::construct_at(
+				new_data + m_size, std::forward<Args>(args)...);
+		}catch(...){
+			deallocate(new_data, capacity);
+			throw;
+		}
+
+		try{
+			relocate(new_data);
+		}catch(...){
+			std::destroy_at(new_data + m_size);
+			deallocate(new_data, capacity);
+			throw;
+		}
+
+		release();
+
+		m_data = new_data;
+		m_capacity = capacity;
+
+		return m_data[m_size++];
+	}
+
+	void push_back(T const& elem)
+	{
+		emplace_back(elem);
+	}
+
+	void push_back(T&& elem)
+	{
+		emplace_back(std::move(elem));
+	}
+
+	void pop_back() noexcept
+	{
+		std::destroy_at(m_data + --m_size);
+	}
+
+	/**
+	  * adds copies of `values` to the end, growing at most once;
+	  * trivially copyable elements are copied with `std::memcpy`
+	  */
+	void append(std::span<T const> values)
+	{
+		if(values.size() > m_capacity - m_size){
+			auto const aliases =
+				!std::less<>{}(values.data(), cbegin())
+				&& std::less<>{}(values.data(), cend());
+			auto const offset = aliases ? values.data() - cbegin() : 0;
+
+			reserve(grown_capacity(m_size + values.size()));
+
+			if(aliases)
+				values = std::span{ cbegin() + offset, values.size() };
+		}
+
+		detail::uninitialized_copy_n(values.data(), values.size(), end());
+		m_size += values.size();
+	}
+
+	template<class ... Args>
+	iterator emplace(const_iterator position, Args&& ... args)
+	{
+		auto const i = position - cbegin();
+		emplace_back(std::forward<Args>(args)...);
+		detail::rotate_last_to(begin() + i, end());
+		return begin() + i;
+	}
+
+	iterator insert(const_iterator position, T const& value)
+	{
+		return emplace(position, value);
+	}
+
+	iterator insert(const_iterator position, T&& value)
+	{
+		return emplace(position, std::move(value));
+	}
+
+	iterator insert(const_iterator position, size_type n, T const& value)
+	{
+		auto const i = position - cbegin();
+
+		if(n > m_capacity - m_size){
+			T const copy = value;
+			reserve(grown_capacity(m_size + n));
+			return insert(begin() + i, n, copy);
+		}
+
+		auto const old_size = m_size;
+
+		for(size_type k=0; k<n; ++k)
+			emplace_back(value);
+
+		std::rotate(begin() + i, begin() + old_size, end());
+		return begin() + i;
+	}
+
+	template<std::input_iterator It, std::sentinel_for<It> S>
+	iterator insert(const_iterator position, It first, S last)
+	{
+		auto const i = position - cbegin();
+		auto const old_size = m_size;
+
+		for(; first != last; ++first)
+			emplace_back(*first);
+
+		std::rotate(begin() + i, begin() + old_size, end());
+		return begin() + i;
+	}
+
+	iterator insert(const_iterator position, std::initializer_list<T> values)
+	{
+		return insert(position, values.begin(), values.end());
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto const f = begin() + (first - cbegin());
+		auto const l = begin() + (last - cbegin());
+
+		auto const new_end = std::move(l, end(), f);
+		std::destroy(new_end, end());
+		m_size = static_cast<size_type>(new_end - begin());
+
+		return f;
+	}
+
+	/**
+	  * the new elements are value-initialized
+	  */
+	void resize(size_type n)
+	{
+		resize_with(n, [this]{ emplace_back(); });
+	}
+
+	void resize(size_type n, T const& value)
+	{
+		resize_with(n, [&]{ emplace_back(value); });
+	}
+
+	/**
+	  * destroys the elements and keeps the capacity
+	  */
+	void clear() noexcept
+	{
+		std::destroy(begin(), end());
+		m_size = 0;
+	}
+
+	friend bool operator==(small_vector const& a, small_vector const& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+private:
+	static T* allocate(size_type n)
+	{
+		return std::allocator<T>{}.allocate(n);
+	}
+
+	static void deallocate(T* p, size_type n) noexcept
+	{
+		std::allocator<T>{}.deallocate(p, n);
+	}
+
+	size_type grown_capacity(size_type n) const noexcept
+	{
+		return std::max(n, 2*m_capacity);
+	}
+
+	/**
+	  * moves the elements to `new_data` and destroys the old ones
+	  */
+	void relocate(T* new_data) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if constexpr(std::is_trivially_copyable_v<T>){
+			if(m_size > 0)
+				std::memcpy(new_data, m_data, m_size*sizeof(T));
+		}else if constexpr(std::is_nothrow_move_constructible_v<T>
+			|| !std::is_copy_constructible_v<T>)
+		{
+			std::uninitialized_move(begin(), end(), new_data);
+			std::destroy(begin(), end());
+		}else{
+			std::uninitialized_copy(begin(), end(), new_data);
+			std::destroy(begin(), end());
+		}
+	}
+
+	void reallocate(size_type capacity)
+	{
+		auto const new_data = allocate(capacity);
+
+		try{
+			relocate(new_data);
+		}catch(...){
+			deallocate(new_data, capacity);
+			throw;
+		}
+
+		release();
+		m_data = new_data;
+		m_capacity = capacity;
+	}
+
+	/**
+	  * frees the heap storage, the elements must be already destroyed
+	  * or relocated
+	  */
+	void release() noexcept
+	{
+		if(!is_inline())
+			deallocate(m_data, m_capacity);
+
+		m_data = m_inline.data();
+		m_capacity = N;
+	}
+
+	/**
+	  * takes the heap storage of `other` or moves its inline elements;
+	  * `this` must be empty and inline
+	  */
+	void steal(small_vector& other)
+		noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if(other.is_inline()){
+			for(auto&& e : other)
+				emplace_back(std::move(e));
+			other.clear();
+			return;
+		}
+
+		m_data = std::exchange(other.m_data, other.m_inline.data());
+		m_size = std::exchange(other.m_size, 0);
+		m_capacity = std::exchange(other.m_capacity, N);
+	}
+
+	void check_index(size_type i) const
+	{
+		if(i >= m_size){
+			throw std::out_of_range(
+				"small_vector index out of range"
+			);
+		}
+	}
+
+	template<class F>
+	void resize_with(size_type n, F&& add)
+	{
+		if(n <= m_size){
+			std::destroy(begin() + n, end());
+			m_size = n;
+			return;
+		}
+
+		reserve(n);
+		while(m_size < n)
+			add();
+	}
+
+	detail::uninitialized_array<T, N> m_inline;
+	T* m_data = m_inline.data();
+	size_type m_size = 0;
+	size_type m_capacity = N;
+};
+
+} // end of namespace util
@@ -1,55 +1,551 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace util{
 
+namespace detail{
+
+/**
+  * storage for `N` elements that are not constructed with it
+  */
+template<class T, uint64_t N>
+union uninitialized_array{
+	constexpr uninitialized_array() noexcept
+	{}
+
+	constexpr ~uninitialized_array()
+		requires std::is_trivially_destructible_v<T> = default;
+
+	constexpr ~uninitialized_array()
+	{}
+
+	constexpr T* data() noexcept
+	{
+		return elements;
+	}
+
+	constexpr T const* data() const noexcept
+	{
+		return elements;
+	}
+
+	T elements[N];
+};
+
+/**
+  * trivial elements are kept in a `std::array`, which is left
+  * uninitialized, so the vector can be used in constant expressions
+  */
+template<class T, uint64_t N>
+using static_storage_t = std::conditional_t<
+	(std::is_trivially_default_constructible_v<T>
+		&& std::is_trivially_destructible_v<T>) || N == 0,
+	std::array<T, N>,
+	uninitialized_array<T, N>
+>;
+
+/**
+  * constructs copies of the `n` elements at `first` in the uninitialized
+  * memory at `out`; trivially copyable elements are copied with
+  * `std::memcpy`
+  */
+template<class T>
+constexpr T* uninitialized_copy_n(T const* first, uint64_t n, T* out)
+{
+	if constexpr(std::is_trivially_copyable_v<T>){
+		if(!std::is_constant_evaluated()){
+			if(n > 0)
+				std::memcpy(out, first, n*sizeof(T));
+			return out + n;
+		}
+	}
+
+	auto it = out;
+
+	try{
+		for(; n > 0; --n, ++first, ++it)
+			std::construct_at(it, *first);
+	}catch(...){
+		std::destroy(out, it);
+		throw;
+	}
+
+	return it;
+}
+
+/**
+  * moves the element at `last - 1` to `position` and shifts the ones in
+  * between one position to the right; trivially copyable elements are
+  * shifted with `std::memmove`
+  */
+template<class T>
+constexpr void rotate_last_to(T* position, T* last)
+{
+	if constexpr(std::is_trivially_copyable_v<T>){
+		if(!std::is_constant_evaluated()){
+			auto const n = static_cast<std::size_t>(last - 1 - position);
+			if(n > 0){
+				T const value = *(last - 1);
+				std::memmove(position + 1, position, n*sizeof(T));
+				*position = value;
+			}
+			return;
+		}
+	}
+
+	std::rotate(position, last - 1, last);
+}
+
+} // end of namespace detail
+
+/**
+  * a vector with its capacity `N` fixed at compile time and its elements
+  * stored inline, so it never allocates; the elements past `size()` are
+  * not constructed
+  *
+  * adding elements over the capacity throws `std::runtime_error`, the
+  * `try_*` functions return `nullptr` instead; the vector is trivially
+  * copyable if `T` is
+  */
 template<class T, uint64_t N>
-class static_vector : public std::array<T, N>{
+class static_vector{
 public:
+	using value_type = T;
+	using size_type = uint64_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = T const&;
+	using pointer = T*;
+	using const_pointer = T const*;
+	using iterator = T*;
+	using const_iterator = T const*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-	constexpr void push_back(T const& elem)
+	constexpr static_vector() noexcept = default;
+
+	constexpr explicit static_vector(size_type n)
 	{
-		if(m_next == N){
-			throw std::runtime_error(
-				"attempt push over capacity in static_vector"
-			);
+		resize(n);
+	}
+
+	constexpr static_vector(size_type n, T const& value)
+	{
+		resize(n, value);
+	}
+
+	constexpr static_vector(std::initializer_list<T> values)
+	{
+		append(std::span{ values.begin(), values.size() });
+	}
+
+	template<std::input_iterator It, std::sentinel_for<It> S>
+	constexpr static_vector(It first, S last)
+	{
+		insert(end(), first, last);
+	}
+
+	constexpr static_vector(static_vector const&)
+		requires std::is_trivially_copyable_v<T> = default;
+
+	constexpr static_vector(static_vector const& other)
+	{
+		append(std::span{ other.data(), other.size() });
+	}
+
+	constexpr static_vector(static_vector&&)
+		requires std::is_trivially_copyable_v<T> = default;
+
+	constexpr static_vector(static_vector&& other)
+		noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		for(auto&& e : other)
+			unchecked_emplace_back(std::move(e));
+	}
+
+	constexpr static_vector& operator=(static_vector const&)
+		requires std::is_trivially_copyable_v<T> = default;
+
+	constexpr static_vector& operator=(static_vector const& other)
+	{
+		if(this != &other){
+			clear();
+			append(std::span{ other.data(), other.size() });
 		}
 
+		return *this;
+	}
 
-		(*this)[m_next++] = elem;
+	constexpr static_vector& operator=(static_vector&&)
+		requires std::is_trivially_copyable_v<T> = default;
+
+	constexpr static_vector& operator=(static_vector&& other)
+		noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if(this != &other){
+			clear();
+			for(auto&& e : other)
+				unchecked_emplace_back(std::move(e));
+		}
+
+		return *this;
+	}
+
+	constexpr ~static_vector()
+		requires std::is_trivially_destructible_v<T> = default;
+
+	constexpr ~static_vector()
+	{
+		clear();
 	}
 
-	constexpr auto size() const noexcept
+	static constexpr size_type capacity() noexcept
 	{
-		return m_next;
+		return N;
 	}
 
-	constexpr auto capacity() const noexcept
+	static constexpr size_type max_size() noexcept
 	{
 		return N;
 	}
 
-	constexpr auto clear() noexcept
+	constexpr size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	constexpr bool full() const noexcept
+	{
+		return m_size == N;
+	}
+
+	constexpr T* data() noexcept
+	{
+		return m_storage.data();
+	}
+
+	constexpr T const* data() const noexcept
+	{
+		return m_storage.data();
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return data();
+	}
+
+	constexpr iterator end() noexcept
 	{
-		m_next = 0;
+		return data() + m_size;
 	}
 
+	constexpr const_iterator begin() const noexcept
+	{
+		return data();
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return data() + m_size;
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator{ end() };
+	}
+
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator{ begin() };
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator{ end() };
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator{ begin() };
+	}
+
+	constexpr T& operator[](size_type i) noexcept
+	{
+		return data()[i];
+	}
 
-	constexpr auto end() noexcept
+	constexpr T const& operator[](size_type i) const noexcept
 	{
-		return begin(*this) + m_next;
+		return data()[i];
 	}
 
-	constexpr auto end() const noexcept
+	/**
+	  * the element `i`; throws `std::out_of_range` if `i >= size()`
+	  */
+	constexpr T& at(size_type i)
 	{
-		return cbegin(*this) + m_next;
+		check_index(i);
+		return data()[i];
+	}
+
+	constexpr T const& at(size_type i) const
+	{
+		check_index(i);
+		return data()[i];
+	}
+
+	constexpr T& front() noexcept
+	{
+		return data()[0];
+	}
+
+	constexpr T const& front() const noexcept
+	{
+		return data()[0];
+	}
+
+	constexpr T& back() noexcept
+	{
+		return data()[m_size - 1];
+	}
+
+	constexpr T const& back() const noexcept
+	{
+		return data()[m_size - 1];
+	}
+
+	template<class ... Args>
+	constexpr T& emplace_back(Args&& ... args)
+	{
+		check_capacity(1);
+		return unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	/**
+	  * adds the element only if there is room for it
+	  * @return the new element or `nullptr` if the vector is full
+	  */
+	template<class ... Args>
+	constexpr T* try_emplace_back(Args&& ... args)
+	{
+		if(full())
+			return nullptr;
+		return &unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	/**
+	  * adds the element without checking the capacity
+	  */
+	template<class ... Args>
+	constexpr T& unchecked_emplace_back(Args&& ... args)
+	{
+		auto const p = std::construct_at(
+			data() + m_size, std::forward<Args>(args)...);
+		++m_size;
+		return *p;
+	}
+
+	constexpr void push_back(T const& elem)
+	{
+		emplace_back(elem);
+	}
+
+	constexpr void push_back(T&& elem)
+	{
+		emplace_back(std::move(elem));
+	}
+
+	constexpr T* try_push_back(T const& elem)
+	{
+		return try_emplace_back(elem);
+	}
+
+	constexpr T* try_push_back(T&& elem)
+	{
+		return try_emplace_back(std::move(elem));
+	}
+
+	constexpr void pop_back() noexcept
+	{
+		std::destroy_at(data() + --m_size);
+	}
+
+	/**
+	  * adds copies of `values` to the end; trivially copyable elements
+	  * are copied at once with `std::memcpy`
+	  */
+	constexpr void append(std::span<T const> values)
+	{
+		check_capacity(values.size());
+		detail::uninitialized_copy_n(values.data(), values.size(), end());
+		m_size += values.size();
+	}
+
+	template<class ... Args>
+	constexpr iterator emplace(const_iterator position, Args&& ... args)
+	{
+		auto const i = position - cbegin();
+		emplace_back(std::forward<Args>(args)...);
+		detail::rotate_last_to(begin() + i, end());
+		return begin() + i;
+	}
+
+	constexpr iterator insert(const_iterator position, T const& value)
+	{
+		return emplace(position, value);
+	}
+
+	constexpr iterator insert(const_iterator position, T&& value)
+	{
+		return emplace(position, std::move(value));
+	}
+
+	constexpr iterator insert(
+		const_iterator position,
+		size_type n,
+		T const& value)
+	{
+		check_capacity(n);
+
+		auto const i = position - cbegin();
+		auto const old_size = m_size;
+
+		for(size_type k=0; k<n; ++k)
+			unchecked_emplace_back(value);
+
+		std::rotate(begin() + i, begin() + old_size, end());
+		return begin() + i;
+	}
+
+	template<std::input_iterator It, std::sentinel_for<It> S>
+	constexpr iterator insert(const_iterator position, It first, S last)
+	{
+		if constexpr(std::forward_iterator<It>){
+			check_capacity(static_cast<size_type>(
+				std::ranges::distance(first, last)));
+		}
+
+		auto const i = position - cbegin();
+		auto const old_size = m_size;
+
+		for(; first != last; ++first)
+			emplace_back(*first);
+
+		std::rotate(begin() + i, begin() + old_size, end());
+		return begin() + i;
+	}
+
+	constexpr iterator insert(
+		const_iterator position,
+		std::initializer_list<T> values)
+	{
+		return insert(position, values.begin(), values.end());
+	}
+
+	constexpr iterator erase(const_iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+	constexpr iterator erase(const_iterator first, const_iterator last)
+	{
+		auto const f = begin() + (first - cbegin());
+		auto const l = begin() + (last - cbegin());
+
+		auto const new_end = std::move(l, end(), f);
+		std::destroy(new_end, end());
+		m_size = static_cast<size_type>(new_end - begin());
+
+		return f;
+	}
+
+	/**
+	  * the new elements are value-initialized
+	  */
+	constexpr void resize(size_type n)
+	{
+		resize_with(n, [this]{ unchecked_emplace_back(); });
+	}
+
+	constexpr void resize(size_type n, T const& value)
+	{
+		resize_with(n, [&]{ unchecked_emplace_back(value); });
+	}
+
+	constexpr void clear() noexcept
+	{
+		std::destroy(begin(), end());
+		m_size = 0;
+	}
+
+	friend constexpr bool operator==(
+		static_vector const& a,
+		static_vector const& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end());
 	}
 
 private:
-	uint64_t m_next = 0;
+	constexpr void check_capacity(size_type n) const
+	{
+		if(n > N - m_size){
+			throw std::runtime_error(
+				"attempt push over capacity in static_vector"
+			);
+		}
+	}
+
+	constexpr void check_index(size_type i) const
+	{
+		if(i >= m_size){
+			throw std::out_of_range(
+				"static_vector index out of range"
+			);
+		}
+	}
+
+	template<class F>
+	constexpr void resize_with(size_type n, F&& add)
+	{
+		if(n <= m_size){
+			std::destroy(begin() + n, end());
+			m_size = n;
+			return;
+		}
+
+		check_capacity(n - m_size);
+		while(m_size < n)
+			add();
+	}
+
+	detail::static_storage_t<T, N> m_storage;
+	size_type m_size = 0;
 };
 
 } // end of namespace util
-
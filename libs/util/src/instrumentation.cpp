@@ -0,0 +1,387 @@
+#include "util/instrumentation.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace util::instrumentation{
+
+namespace{
+
+metric_id intern(
+	std::vector<std::string>& names,
+	std::string_view name,
+	std::size_t max,
+	char const* kind)
+{
+	auto const it = std::ranges::find(names, name);
+	if(it != names.end())
+		return static_cast<metric_id>(it - names.begin());
+
+	if(names.size() == max){
+		throw std::runtime_error(
+			std::string{ "too many instrumentation " } + kind
+			+ ", could not add " + std::string{ name });
+	}
+
+	names.emplace_back(name);
+	return static_cast<metric_id>(names.size() - 1);
+}
+
+void write_escaped(std::ostream& out, std::string_view s)
+{
+	out << '"';
+	for(auto c : s){
+		switch(c){
+		case '"': out << "\\\""; break;
+		case '\\': out << "\\\\"; break;
+		case '\n': out << "\\n"; break;
+		case '\t': out << "\\t"; break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20)
+				out << ' ';
+			else
+				out << c;
+		}
+	}
+	out << '"';
+}
+
+/**
+  * writes the doubles of the exporters with three decimals, down to the
+  * nanosecond or the picosecond, and restores the stream on destruction
+  */
+class fixed_decimals{
+public:
+	explicit fixed_decimals(std::ostream& out)
+		: m_out(out),
+		  m_flags(out.flags()),
+		  m_precision(out.precision())
+	{
+		m_out << std::fixed << std::setprecision(3);
+	}
+
+	fixed_decimals(fixed_decimals const&) = delete;
+	fixed_decimals& operator=(fixed_decimals const&) = delete;
+
+	~fixed_decimals()
+	{
+		m_out.flags(m_flags);
+		m_out.precision(m_precision);
+	}
+
+private:
+	std::ostream& m_out;
+	std::ios_base::fmtflags m_flags;
+	std::streamsize m_precision;
+};
+
+} // end of anonymous namespace
+
+double ticks_per_nanosecond()
+{
+#if UTIL_INSTRUMENTATION_HAS_RDTSC
+	static double const ratio = []
+	{
+		using namespace std::chrono_literals;
+
+		auto const t0 = std::chrono::steady_clock::now();
+		auto const c0 = __rdtsc();
+		std::this_thread::sleep_for(10ms);
+		auto const c1 = __rdtsc();
+		auto const t1 = std::chrono::steady_clock::now();
+
+		std::chrono::duration<double, std::nano> const elapsed = t1 - t0;
+		return static_cast<double>(c1 - c0)/elapsed.count();
+	}();
+
+	return ratio;
+#else
+	return 1.0;
+#endif
+}
+
+struct registry::impl{
+	mutable std::mutex mutex;
+	std::vector<std::string> timer_names;
+	std::vector<std::string> counter_names;
+	std::vector<std::string> histogram_names;
+	std::vector<std::unique_ptr<detail::thread_data>> threads;
+	std::vector<detail::thread_data*> free_threads;
+	std::uint64_t epoch = now_ticks();
+};
+
+registry::registry()
+	: m_impl(std::make_unique<impl>())
+{}
+
+registry& registry::instance()
+{
+	static registry r;
+	return r;
+}
+
+metric_id registry::timer(std::string_view name)
+{
+	std::scoped_lock lock{ m_impl->mutex };
+	return intern(m_impl->timer_names, name, max_timers, "timers");
+}
+
+metric_id registry::counter(std::string_view name)
+{
+	std::scoped_lock lock{ m_impl->mutex };
+	return intern(m_impl->counter_names, name, max_counters, "counters");
+}
+
+metric_id registry::histogram(std::string_view name)
+{
+	std::scoped_lock lock{ m_impl->mutex };
+	return intern(
+		m_impl->histogram_names, name, max_histograms, "histograms");
+}
+
+void registry::enable_tracing(std::size_t events_per_thread)
+{
+	m_tracing_capacity.store(events_per_thread, std::memory_order_relaxed);
+}
+
+std::size_t registry::tracing_capacity() const noexcept
+{
+	return m_tracing_capacity.load(std::memory_order_relaxed);
+}
+
+snapshot registry::collect() const
+{
+	std::scoped_lock lock{ m_impl->mutex };
+
+	auto const ratio = ticks_per_nanosecond();
+	auto to_ns = [ratio](std::uint64_t ticks)
+	{
+		return static_cast<double>(ticks)/ratio;
+	};
+
+	snapshot s;
+
+	for(std::size_t i=0; i<m_impl->timer_names.size(); ++i){
+		std::uint64_t count = 0;
+		std::uint64_t total = 0;
+		auto min = std::numeric_limits<std::uint64_t>::max();
+		std::uint64_t max = 0;
+
+		for(auto&& t : m_impl->threads){
+			auto const& cell = t->timers[i];
+			count += cell.count.load(std::memory_order_relaxed);
+			total += cell.total.load(std::memory_order_relaxed);
+			min = std::min(min, cell.min.load(std::memory_order_relaxed));
+			max = std::max(max, cell.max.load(std::memory_order_relaxed));
+		}
+
+		s.timers.push_back({
+			m_impl->timer_names[i],
+			count,
+			to_ns(total),
+			count == 0 ? 0.0 : to_ns(min),
+			to_ns(max)
+		});
+	}
+
+	for(std::size_t i=0; i<m_impl->counter_names.size(); ++i){
+		std::uint64_t value = 0;
+		for(auto&& t : m_impl->threads)
+			value += t->counters[i].load(std::memory_order_relaxed);
+
+		s.counters.push_back({ m_impl->counter_names[i], value });
+	}
+
+	for(std::size_t i=0; i<m_impl->histogram_names.size(); ++i){
+		histogram_summary h{
+			m_impl->histogram_names[i],
+			0,
+			0,
+			std::vector<std::uint64_t>(histogram_buckets, 0)
+		};
+
+		for(auto&& t : m_impl->threads){
+			auto const& cell = t->histograms[i];
+			h.sum += cell.sum.load(std::memory_order_relaxed);
+			for(std::size_t b=0; b<histogram_buckets; ++b){
+				auto const n = cell.buckets[b].load(std::memory_order_relaxed);
+				h.buckets[b] += n;
+				h.count += n;
+			}
+		}
+
+		s.histograms.push_back(std::move(h));
+	}
+
+	for(auto&& t : m_impl->threads){
+		auto const n = t->n_events.load(std::memory_order_acquire);
+		s.dropped_events += t->dropped_events.load(std::memory_order_relaxed);
+
+		for(std::size_t i=0; i<n; ++i){
+			auto const& e = t->events[i];
+			s.events.push_back({
+				m_impl->timer_names[e.timer],
+				t->thread_index,
+				to_ns(e.start - m_impl->epoch),
+				to_ns(e.duration)
+			});
+		}
+	}
+
+	std::ranges::sort(s.events, {}, &event_summary::start_ns);
+
+	return s;
+}
+
+std::size_t registry::thread_tables() const
+{
+	std::scoped_lock lock{ m_impl->mutex };
+	return m_impl->threads.size();
+}
+
+void registry::reset()
+{
+	std::scoped_lock lock{ m_impl->mutex };
+
+	for(auto&& t : m_impl->threads){
+		for(auto&& cell : t->timers){
+			cell.count.store(0, std::memory_order_relaxed);
+			cell.total.store(0, std::memory_order_relaxed);
+			cell.min.store(
+				std::numeric_limits<std::uint64_t>::max(),
+				std::memory_order_relaxed);
+			cell.max.store(0, std::memory_order_relaxed);
+		}
+
+		for(auto&& c : t->counters)
+			c.store(0, std::memory_order_relaxed);
+
+		for(auto&& cell : t->histograms){
+			cell.sum.store(0, std::memory_order_relaxed);
+			for(auto&& b : cell.buckets)
+				b.store(0, std::memory_order_relaxed);
+		}
+
+		t->n_events.store(0, std::memory_order_relaxed);
+		t->dropped_events.store(0, std::memory_order_relaxed);
+	}
+
+	m_impl->epoch = now_ticks();
+}
+
+namespace detail{
+
+thread_data& register_thread()
+{
+	auto& r = registry::instance();
+	std::scoped_lock lock{ r.m_impl->mutex };
+
+	// the values of the previous thread are kept, as they are merged anyway
+	if(!r.m_impl->free_threads.empty()){
+		auto& data = *r.m_impl->free_threads.back();
+		r.m_impl->free_threads.pop_back();
+		return data;
+	}
+
+	r.m_impl->free_threads.reserve(r.m_impl->threads.size() + 1);
+	auto& data = r.m_impl->threads.emplace_back(
+		std::make_unique<thread_data>());
+	data->thread_index = static_cast<std::uint32_t>(
+		r.m_impl->threads.size() - 1);
+
+	return *data;
+}
+
+void release_thread(thread_data& data) noexcept
+{
+	auto& r = registry::instance();
+	std::scoped_lock lock{ r.m_impl->mutex };
+
+	// `register_thread` reserved a place for every table, so it does not throw
+	r.m_impl->free_threads.push_back(&data);
+}
+
+void record_event(
+	thread_data& data,
+	metric_id timer,
+	std::uint64_t start,
+	std::uint64_t end)
+{
+	if(data.events == nullptr){
+		data.event_capacity = registry::instance().tracing_capacity();
+		data.events = std::make_unique<trace_event[]>(data.event_capacity);
+	}
+
+	auto const n = data.n_events.load(std::memory_order_relaxed);
+
+	if(n == data.event_capacity){
+		bump(data.dropped_events, 1);
+		return;
+	}
+
+	data.events[n] = trace_event{ timer, start, end - start };
+	data.n_events.store(n + 1, std::memory_order_release);
+}
+
+} // end of namespace detail
+
+void write_json(std::ostream& out, snapshot const& s)
+{
+	fixed_decimals const decimals{ out };
+
+	out << "{\n\t\"timers\": [";
+	for(std::size_t i=0; i<s.timers.size(); ++i){
+		auto const& t = s.timers[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{ \"name\": ";
+		write_escaped(out, t.name);
+		out << ", \"count\": " << t.count
+			<< ", \"total_ns\": " << t.total_ns
+			<< ", \"mean_ns\": " << (t.count == 0 ? 0.0 : t.total_ns/t.count)
+			<< ", \"min_ns\": " << t.min_ns
+			<< ", \"max_ns\": " << t.max_ns << " }";
+	}
+
+	out << "\n\t],\n\t\"counters\": [";
+	for(std::size_t i=0; i<s.counters.size(); ++i){
+		auto const& c = s.counters[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{ \"name\": ";
+		write_escaped(out, c.name);
+		out << ", \"value\": " << c.value << " }";
+	}
+
+	out << "\n\t],\n\t\"histograms\": [";
+	for(std::size_t i=0; i<s.histograms.size(); ++i){
+		auto const& h = s.histograms[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{ \"name\": ";
+		write_escaped(out, h.name);
+		out << ", \"count\": " << h.count
+			<< ", \"sum\": " << h.sum
+			<< ", \"buckets\": [";
+		for(std::size_t b=0; b<h.buckets.size(); ++b)
+			out << (b == 0 ? "" : ", ") << h.buckets[b];
+		out << "] }";
+	}
+
+	out << "\n\t]\n}\n";
+}
+
+void write_chrome_trace(std::ostream& out, snapshot const& s)
+{
+	fixed_decimals const decimals{ out };
+
+	out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+	for(std::size_t i=0; i<s.events.size(); ++i){
+		auto const& e = s.events[i];
+		out << (i == 0 ? "\n" : ",\n") << "{\"name\": ";
+		write_escaped(out, e.name);
+		out << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.thread
+			<< ", \"ts\": " << e.start_ns/1000.0
+			<< ", \"dur\": " << e.duration_ns/1000.0 << "}";
+	}
+	out << "\n]}\n";
+}
+
+} // end of namespace util::instrumentation
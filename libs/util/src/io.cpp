@@ -1,5 +1,20 @@
 #include "util/io.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UTIL_IO_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define UTIL_IO_HAS_MMAP 0
+#endif
 
 namespace util{
 
@@ -43,4 +58,287 @@ std::istream& cin_or_file::get_stream()
 		return std::cin;
 }
 
+namespace{
+
+[[noreturn]] void throw_errno(
+	std::string const& what,
+	std::filesystem::path const& path)
+{
+	throw std::runtime_error(
+		what + " " + path.string() + ": " + std::strerror(errno));
+}
+
+std::vector<char> read_all(std::FILE* file)
+{
+	constexpr std::size_t chunk_size = std::size_t{1} << 20;
+
+	std::vector<char> buffer;
+	std::size_t used = 0;
+
+	while(true){
+		buffer.resize(used + chunk_size);
+		auto const n = std::fread(buffer.data() + used, 1, chunk_size, file);
+		used += n;
+		if(n < chunk_size)
+			break;
+	}
+
+	if(std::ferror(file))
+		throw std::runtime_error("could not read the input");
+
+	buffer.resize(used);
+	return buffer;
+}
+
+} // end of anonymous namespace
+
+mapped_cin_or_file::mapped_cin_or_file()
+	: m_buffer(read_all(stdin))
+{
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+}
+
+mapped_cin_or_file::mapped_cin_or_file(std::filesystem::path const& path)
+{
+#if UTIL_IO_HAS_MMAP
+	auto const fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		throw_errno("could not open", path);
+
+	struct stat st;
+	if(::fstat(fd, &st) != 0){
+		::close(fd);
+		throw_errno("could not stat", path);
+	}
+
+	// pipes and devices have no size to map, they are read until the end
+	if(!S_ISREG(st.st_mode)){
+		auto const file = ::fdopen(fd, "rb");
+		if(file == nullptr){
+			::close(fd);
+			throw_errno("could not open", path);
+		}
+
+		read_file(file);
+		return;
+	}
+
+	m_size = static_cast<std::size_t>(st.st_size);
+
+	if(m_size > 0){
+		auto const p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(p == MAP_FAILED){
+			::close(fd);
+			throw_errno("could not map", path);
+		}
+
+		::madvise(p, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<char const*>(p);
+		m_mapped = true;
+	}
+
+	::close(fd);
+#else
+	auto const file = std::fopen(path.string().c_str(), "rb");
+	if(file == nullptr)
+		throw_errno("could not open", path);
+
+	read_file(file);
+#endif
+}
+
+void mapped_cin_or_file::read_file(std::FILE* file)
+{
+	try{
+		m_buffer = read_all(file);
+	}catch(...){
+		std::fclose(file);
+		throw;
+	}
+
+	std::fclose(file);
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+}
+
+mapped_cin_or_file::mapped_cin_or_file(mapped_cin_or_file&& other) noexcept
+	: m_data(std::exchange(other.m_data, nullptr)),
+	  m_size(std::exchange(other.m_size, 0)),
+	  m_mapped(std::exchange(other.m_mapped, false)),
+	  m_buffer(std::move(other.m_buffer))
+{}
+
+mapped_cin_or_file& mapped_cin_or_file::operator=(
+	mapped_cin_or_file&& other) noexcept
+{
+	if(this != &other){
+		release();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_mapped = std::exchange(other.m_mapped, false);
+		m_buffer = std::move(other.m_buffer);
+	}
+	return *this;
+}
+
+mapped_cin_or_file::~mapped_cin_or_file()
+{
+	release();
+}
+
+void mapped_cin_or_file::release() noexcept
+{
+#if UTIL_IO_HAS_MMAP
+	if(m_mapped)
+		::munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_mapped = false;
+	m_buffer.clear();
+}
+
+bool mapped_cin_or_file::is_mapped() const noexcept
+{
+	return m_mapped;
+}
+
+std::span<char const> mapped_cin_or_file::data() const noexcept
+{
+	return { m_data, m_size };
+}
+
+std::string_view mapped_cin_or_file::view() const noexcept
+{
+	return { m_data, m_size };
+}
+
+std::size_t mapped_cin_or_file::size() const noexcept
+{
+	return m_size;
+}
+
+buffered_cout_or_file::buffered_cout_or_file(std::size_t buffer_size)
+	: m_buffer(std::max(buffer_size, max_number_size))
+{}
+
+buffered_cout_or_file::buffered_cout_or_file(
+	std::filesystem::path const& path,
+	std::size_t buffer_size)
+	: m_file(std::fopen(path.string().c_str(), "wb")),
+	  m_buffer(std::max(buffer_size, max_number_size))
+{
+	if(m_file == nullptr)
+		throw_errno("could not open", path);
+}
+
+buffered_cout_or_file::buffered_cout_or_file(
+	buffered_cout_or_file&& other) noexcept
+	: m_file(std::exchange(other.m_file, nullptr)),
+	  m_buffer(std::move(other.m_buffer)),
+	  m_used(std::exchange(other.m_used, 0))
+{}
+
+buffered_cout_or_file& buffered_cout_or_file::operator=(
+	buffered_cout_or_file&& other) noexcept
+{
+	if(this != &other){
+		close();
+		m_file = std::exchange(other.m_file, nullptr);
+		m_buffer = std::move(other.m_buffer);
+		m_used = std::exchange(other.m_used, 0);
+	}
+	return *this;
+}
+
+buffered_cout_or_file::~buffered_cout_or_file()
+{
+	close();
+}
+
+void buffered_cout_or_file::close() noexcept
+{
+	try{
+		flush();
+	}catch(...){
+	}
+
+	if(m_file != nullptr)
+		std::fclose(m_file);
+
+	m_file = nullptr;
+}
+
+bool buffered_cout_or_file::is_open() const noexcept
+{
+	return m_file != nullptr;
+}
+
+void buffered_cout_or_file::check_not_moved_from() const
+{
+	if(m_buffer.empty())
+		throw std::logic_error("write to a moved-from buffered_cout_or_file");
+}
+
+void buffered_cout_or_file::write(char const* ptr, std::size_t count)
+{
+	check_not_moved_from();
+
+	if(count > m_buffer.size() - m_used){
+		flush();
+
+		if(count >= m_buffer.size()){
+			auto output = m_file;
+
+			if(!is_open()){
+				std::cout.flush();
+				output = stdout;
+			}
+
+			if(std::fwrite(ptr, 1, count, output) != count)
+				throw std::runtime_error("could not write the output");
+			return;
+		}
+	}
+
+	std::memcpy(m_buffer.data() + m_used, ptr, count);
+	m_used += count;
+}
+
+void buffered_cout_or_file::write(std::span<char const> data)
+{
+	write(data.data(), data.size());
+}
+
+void buffered_cout_or_file::put(char c)
+{
+	check_not_moved_from();
+
+	if(m_used == m_buffer.size())
+		flush();
+
+	m_buffer[m_used++] = c;
+}
+
+void buffered_cout_or_file::flush()
+{
+	if(m_used == 0 || m_buffer.empty())
+		return;
+
+	auto output = m_file;
+
+	if(!is_open()){
+		std::cout.flush();
+		output = stdout;
+	}
+
+	auto const written = std::fwrite(m_buffer.data(), 1, m_used, output);
+	auto const failed = written != m_used || std::fflush(output) != 0;
+	m_used = 0;
+
+	if(failed)
+		throw std::runtime_error("could not write the output");
+}
+
 } // end of namespace util
@@ -0,0 +1,146 @@
+#include "util/log.hpp"
+
+#include <exception>
+
+namespace util::logging{
+
+async_logger::async_logger(
+	std::shared_ptr<spdlog::logger> sink,
+	std::size_t capacity)
+	: m_sink(std::move(sink)),
+	  m_queue(capacity),
+	  m_worker([this](std::stop_token stop){ consume(stop); })
+{}
+
+async_logger::~async_logger()
+{
+	m_worker.request_stop();
+	wake_worker();
+	m_worker.join();
+}
+
+void async_logger::set_level(level lvl) noexcept
+{
+	m_level.store(lvl, std::memory_order_relaxed);
+}
+
+level async_logger::get_level() const noexcept
+{
+	return m_level.load(std::memory_order_relaxed);
+}
+
+bool async_logger::should_log(level lvl) const noexcept
+{
+	return lvl != level::OFF && lvl >= get_level();
+}
+
+std::uint64_t async_logger::dropped() const noexcept
+{
+	return m_dropped.load(std::memory_order_relaxed);
+}
+
+void async_logger::flush()
+{
+	auto const target = m_pushed.load(std::memory_order_acquire);
+
+	while(m_written.load(std::memory_order_acquire) < target)
+		std::this_thread::yield();
+
+	m_sink->flush();
+}
+
+void async_logger::wake_worker() noexcept
+{
+	m_wakeups.fetch_add(1);
+	m_wakeups.notify_one();
+}
+
+bool async_logger::write_pending(fmt::memory_buffer& buffer)
+{
+	auto written = false;
+
+	while(m_queue.try_pop([&](detail::record& r)
+	{
+		auto const invalid = [&](std::string_view reason)
+		{
+			buffer.clear();
+			fmt::format_to(
+				std::back_inserter(buffer),
+				"invalid log message \"{}\": {}",
+				std::string_view{ r.format_string.data(), r.format_string.size() },
+				reason);
+		};
+
+		buffer.clear();
+
+		try{
+			r.format(r, buffer);
+		}catch(std::exception const& e){
+			invalid(e.what());
+		}catch(...){
+			invalid("unknown exception");
+		}
+
+		r.destroy(r);
+
+		if(r.suppressed > 0){
+			fmt::format_to(
+				std::back_inserter(buffer),
+				" [{} similar messages suppressed]",
+				r.suppressed);
+		}
+
+		m_sink->log(
+			r.time,
+			spdlog::source_loc{},
+			static_cast<spdlog::level::level_enum>(r.lvl),
+			spdlog::string_view_t{ buffer.data(), buffer.size() });
+	}))
+	{
+		m_written.fetch_add(1);
+		written = true;
+	}
+
+	auto const dropped = m_dropped.load(std::memory_order_relaxed);
+	if(dropped != m_reported_dropped){
+		m_sink->warn(
+			"{} log messages dropped because the buffer was full",
+			dropped - m_reported_dropped);
+		m_reported_dropped = dropped;
+	}
+
+	return written;
+}
+
+void async_logger::consume(std::stop_token stop)
+{
+	fmt::memory_buffer buffer;
+
+	while(!stop.stop_requested()){
+		auto const wakeups = m_wakeups.load();
+
+		if(write_pending(buffer))
+			continue;
+
+		/*
+		 * a message can be written before it is counted in `m_pushed`, the
+		 * worker sleeps only once the counts agree, and a producer that
+		 * then finds them equal wakes it
+		 */
+		if(m_written.load() != m_pushed.load() || stop.stop_requested())
+			continue;
+
+		m_wakeups.wait(wakeups);
+	}
+
+	write_pending(buffer);
+	m_sink->flush();
+}
+
+async_logger& default_logger()
+{
+	static async_logger logger{ spdlog::default_logger() };
+	return logger;
+}
+
+} // end of namespace util::logging
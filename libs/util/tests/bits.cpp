@@ -1,5 +1,9 @@
 #include "catch2/catch_test_macros.hpp"
 
+#include <array>
+#include <numeric>
+#include <vector>
+
 #include "util/bit.hpp"
 
 template<class T, class F, class Init>
@@ -219,3 +223,178 @@ TEST_CASE("get bits test", "[util]")
 	STATIC_REQUIRE(util::get_bit(0b11110010, 7) == 1);
 }
 
+
+template<class T>
+constexpr T naive_reverse(T x)
+{
+	T r = 0;
+	for(int i=0; i<util::number_of_bits<T>(); ++i){
+		r = util::set_bit(
+			r, i, util::get_bit(x, i, util::bit_order::leftmost{}));
+	}
+	return r;
+}
+
+TEST_CASE("extract and deposit bits", "[util]")
+{
+	STATIC_REQUIRE(util::extract_bits<uint8_t>(0b10110110, 0b11110000) == 0b1011);
+	STATIC_REQUIRE(util::extract_bits<uint8_t>(0b10110110, 0b01010101) == 0b0110);
+	STATIC_REQUIRE(util::extract_bits<uint64_t>(~uint64_t{0}, 0) == 0);
+	STATIC_REQUIRE(util::deposit_bits<uint8_t>(0b1011, 0b11110000) == 0b10110000);
+	STATIC_REQUIRE(util::deposit_bits<uint8_t>(0b0110, 0b01010101) == 0b00010100);
+
+	constexpr uint64_t x = 0xdeadbeefcafebabe;
+	constexpr uint64_t masks[] = {
+		0, ~uint64_t{0}, 0xff00ff00ff00ff00, 0x8000000000000001, x
+	};
+
+	for(auto mask : masks){
+		auto const e = util::extract_bits(x, mask);
+		REQUIRE(util::deposit_bits(e, mask) == (x & mask));
+		REQUIRE(std::popcount(e) == std::popcount(x & mask));
+
+		auto const c = util::extract_bits<uint32_t>(
+			static_cast<uint32_t>(x), static_cast<uint32_t>(mask));
+		REQUIRE(util::deposit_bits(c, static_cast<uint32_t>(mask))
+			== static_cast<uint32_t>(x & mask));
+	}
+}
+
+TEST_CASE("reverse bits", "[util]")
+{
+	STATIC_REQUIRE(util::reverse_bits<uint8_t>(0b00000001) == 0b10000000);
+	STATIC_REQUIRE(util::reverse_bits<uint8_t>(0b11010000) == 0b00001011);
+	STATIC_REQUIRE(util::reverse_bits<int8_t>(1) == std::numeric_limits<int8_t>::min());
+	STATIC_REQUIRE(util::reverse_bits<uint16_t>(0x00f1) == 0x8f00);
+	STATIC_REQUIRE(util::reverse_bits(uint64_t{1}) == uint64_t{1} << 63);
+
+	constexpr uint64_t x = 0x0123456789abcdef;
+	STATIC_REQUIRE(util::reverse_bits(x) == naive_reverse(x));
+	STATIC_REQUIRE(util::reverse_bits(static_cast<uint32_t>(x))
+		== naive_reverse(static_cast<uint32_t>(x)));
+	STATIC_REQUIRE(util::reverse_bits(util::reverse_bits(x)) == x);
+}
+
+/**
+  * reads the bit `i` of `words` one bit at a time, as reference
+  */
+template<class T>
+uint64_t bit_at(std::span<T const> words, uint64_t i)
+{
+	constexpr auto w = util::number_of_bits<T>();
+	return util::get_bit(words[i / w], i % w, util::bit_order::leftmost{}) & 1;
+}
+
+template<class T>
+void test_bit_ranges()
+{
+	constexpr auto w = util::number_of_bits<T>();
+
+	std::vector<T> words(9);
+	uint64_t seed = 0x9e3779b97f4a7c15;
+	for(auto& v : words){
+		seed = seed*6364136223846793005 + 1442695040888963407;
+		v = static_cast<T>(seed >> 17);
+	}
+
+	std::span<T const> const cwords{ words };
+	auto const n_bits = words.size()*w;
+
+	for(uint64_t offset : { 0ul, 1ul, 3ul, w - 1ul, w + 5ul }){
+		for(uint64_t count : { 0ul, 1ul, 7ul, 31ul, 63ul, 64ul }){
+			if(offset + count > n_bits)
+				continue;
+
+			uint64_t expected = 0;
+			uint64_t ones = 0;
+			for(uint64_t i=0; i<count; ++i){
+				expected = (expected << 1) | bit_at(cwords, offset + i);
+				ones += bit_at(cwords, offset + i);
+			}
+
+			REQUIRE(util::read_bits(cwords, offset, count) == expected);
+
+			auto copy = words;
+			util::write_bits(std::span(copy), offset, count, ~expected);
+			for(uint64_t i=0; i<n_bits; ++i){
+				auto const inside = i >= offset && i < offset + count;
+				REQUIRE(bit_at<T>(copy, i)
+					== (inside ? 1 - bit_at(cwords, i) : bit_at(cwords, i)));
+			}
+
+			util::write_bits(std::span(copy), offset, count, expected);
+			REQUIRE(copy == words);
+
+			REQUIRE(util::popcount(cwords, offset, count) == ones);
+		}
+	}
+
+	REQUIRE(util::popcount(cwords, 0, n_bits) == std::accumulate(
+		words.begin(), words.end(), uint64_t{0},
+		[](uint64_t acc, T v){
+			return acc + std::popcount(static_cast<std::make_unsigned_t<T>>(v));
+		}));
+
+	for(uint64_t src : { 0ul, 3ul, w + 1ul }){
+		for(uint64_t dst : { 0ul, 2ul, 5ul, 2*w + 7ul }){
+			uint64_t const count = 4*w + 3;
+
+			auto moved = words;
+			util::copy_bits(
+				std::span<T const>(moved), src,
+				std::span(moved), dst,
+				count);
+
+			auto other = std::vector<T>(words.size());
+			util::copy_bits(cwords, src, std::span(other), dst, count);
+
+			for(uint64_t i=0; i<count; ++i){
+				REQUIRE(bit_at<T>(moved, dst + i) == bit_at(cwords, src + i));
+				REQUIRE(bit_at<T>(other, dst + i) == bit_at(cwords, src + i));
+			}
+		}
+	}
+}
+
+TEST_CASE("bit ranges", "[util]")
+{
+	test_bit_ranges<uint8_t>();
+	test_bit_ranges<int16_t>();
+	test_bit_ranges<uint32_t>();
+	test_bit_ranges<uint64_t>();
+}
+
+constexpr bool constexpr_copy_bits()
+{
+	std::array<uint8_t, 3> a{ 0b10110011, 0b01010101, 0 };
+	util::copy_bits(std::span(a), 0, std::span(a), 4, 16);
+	return a[0] == 0b10111011 && a[1] == 0b00110101 && a[2] == 0b01010000;
+}
+
+TEST_CASE("constexpr bit ranges", "[util]")
+{
+	STATIC_REQUIRE(constexpr_copy_bits());
+	STATIC_REQUIRE(util::read_bits(std::span<uint8_t const>(
+		std::array<uint8_t, 2>{ 0x0f, 0xf0 }), 4, 8) == 0xff);
+}
+
+TEST_CASE("fill, find and compare bit ranges", "[util]")
+{
+	std::array<uint32_t, 4> a{};
+
+	util::fill_bits(std::span(a), 5, 70, true);
+	REQUIRE(util::popcount(std::span(a), 0, 128) == 70);
+	REQUIRE(util::find_bit(std::span(a), 0, 128, true) == 5);
+	REQUIRE(util::find_bit(std::span(a), 5, 123, false) == 75);
+	REQUIRE(util::find_bit(std::span(a), 5, 70, false) == 75);
+	REQUIRE(util::find_bit(std::span(a), 80, 48, true) == 128);
+
+	util::fill_bits(std::span(a), 40, 3, false);
+	REQUIRE(util::popcount(std::span(a), 0, 128) == 67);
+	REQUIRE(util::find_bit(std::span(a), 33, 90, false) == 40);
+
+	std::array<uint8_t, 16> b{};
+	util::copy_bits(std::span(a), 0, std::span(b), 3, 125);
+	REQUIRE(util::equal_bits(std::span(a), 0, std::span(b), 3, 125));
+	REQUIRE(!util::equal_bits(std::span(a), 0, std::span(b), 2, 125));
+}
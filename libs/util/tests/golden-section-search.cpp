@@ -1,6 +1,12 @@
 #include "catch2/catch_test_macros.hpp"
 
+#include <mutex>
 #include <numbers>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "util/numeric-computing.hpp"
 
 TEST_CASE("golden search minimum", "[util][numeric-computing]")
@@ -44,3 +50,141 @@ TEST_CASE("golden search maximum", "[util][numeric-computing]")
 
 	REQUIRE(c <= max_calls);
 }
+
+TEST_CASE("batched golden search", "[util][numeric-computing]")
+{
+	auto const n = std::size_t{100};
+
+	std::vector<double> a(n), b(n);
+	for(std::size_t i=0; i<n; ++i){
+		a[i] = -4.0 - static_cast<double>(i);
+		b[i] = +4.0 + static_cast<double>(i)/3.0;
+	}
+
+	// the i-th search minimizes (x - i/10)^2
+	auto f_i = [](std::size_t i, double x)
+	{
+		auto const t = x - static_cast<double>(i)/10.0;
+		return t*t;
+	};
+
+	auto calls = uint64_t{0};
+	auto f = [&](
+		std::span<std::size_t const> searches,
+		std::span<double const> x,
+		std::span<double> fx)
+	{
+		++calls;
+		for(std::size_t k=0; k<x.size(); ++k)
+			fx[k] = f_i(searches[k], x[k]);
+	};
+
+	auto const tol = 1e-10;
+	auto x = util::golden_section_search_batch(
+		f,
+		std::span<double const>{ a },
+		std::span<double const>{ b },
+		tol);
+
+	REQUIRE(x.size() == n);
+
+	for(std::size_t i=0; i<n; ++i){
+		auto fi = [&](double t){ return f_i(i, t); };
+		REQUIRE(x[i] == util::golden_section_search(fi, a[i], b[i], tol));
+		REQUIRE(std::fabs(x[i] - static_cast<double>(i)/10.0) <= tol);
+	}
+
+	// the batch is evaluated once per iteration of the longest search
+	static constexpr auto phi = std::numbers::phi_v<double>;
+	auto const max_iterations = static_cast<uint64_t>(
+		std::log((b.back() - a.back())/tol) / std::log(phi) + 1.0);
+
+	REQUIRE(calls <= max_iterations + 1);
+}
+
+TEST_CASE("k-section search", "[util][numeric-computing]")
+{
+	auto const tol = 1e-10;
+
+	auto iterations = uint64_t{0};
+	auto f = [&](std::span<double const> x, std::span<double> fx)
+	{
+		++iterations;
+		for(std::size_t i=0; i<x.size(); ++i)
+			fx[i] = (x[i] - 1.0)*(x[i] - 1.0);
+	};
+
+	auto x = util::k_section_search(f, -4.0, 4.0, 7, tol);
+	REQUIRE(std::fabs(x - 1.0) <= tol);
+
+	auto const max_iterations = static_cast<uint64_t>(
+		std::log(8.0/tol) / std::log(4.0) + 1.0);
+	REQUIRE(iterations <= max_iterations);
+
+	auto y = util::k_section_search(f, -4.0, 4.0, 2, tol);
+	REQUIRE(std::fabs(y - 1.0) <= tol);
+
+	auto z = util::parallel_k_section_search(
+		[](double t) -> double { return -(t + 2.0)*(t + 2.0); },
+		-4.0, 4.0,
+		4,
+		tol,
+		std::greater<double>{});
+	REQUIRE(std::fabs(z + 2.0) <= tol);
+
+	REQUIRE_THROWS_AS(util::k_section_search(f, -4.0, 4.0, 1, tol), std::runtime_error);
+}
+
+TEST_CASE("parallel k-section search", "[util][numeric-computing]")
+{
+	auto const tol = 1e-10;
+
+	std::mutex mutex;
+	std::set<std::thread::id> ids;
+	auto calls = uint64_t{0};
+
+	auto f = [&](double t) -> double
+	{
+		{
+			std::scoped_lock lock(mutex);
+			ids.insert(std::this_thread::get_id());
+			++calls;
+		}
+		return (t - 0.5)*(t - 0.5);
+	};
+
+	auto x = util::parallel_k_section_search(f, -4.0, 4.0, 3, tol);
+	REQUIRE(std::fabs(x - 0.5) <= tol);
+
+	// the calling thread and the same two workers for every iteration
+	REQUIRE(calls > 3*10);
+	REQUIRE(ids.size() == 3);
+	REQUIRE(ids.contains(std::this_thread::get_id()));
+
+	SECTION("the exceptions of f are rethrown"){
+		// the first points are -2.4, -0.8, 0.8 and 2.4
+		auto const throw_above = [](double limit)
+		{
+			return [limit](double t) -> double
+			{
+				if(t > limit)
+					throw std::domain_error("above");
+				return t*t;
+			};
+		};
+
+		// on a worker
+		REQUIRE_THROWS_AS(
+			util::parallel_k_section_search(throw_above(2.), -4.0, 4.0, 4),
+			std::domain_error);
+
+		// on the calling thread, with every worker throwing too
+		REQUIRE_THROWS_AS(
+			util::parallel_k_section_search(throw_above(-3.), -4.0, 4.0, 4),
+			std::domain_error);
+	}
+
+	REQUIRE_THROWS_AS(
+		util::parallel_k_section_search(f, -4.0, 4.0, 1, tol),
+		std::runtime_error);
+}
@@ -0,0 +1,164 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "util/instrumentation.hpp"
+
+namespace{
+
+template<class T>
+auto const& find(std::vector<T> const& v, std::string const& name)
+{
+	for(auto&& x : v){
+		if(x.name == name)
+			return x;
+	}
+	throw std::runtime_error("metric not found: " + name);
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("instrumentation merges the threads on read", "[instrumentation]")
+{
+	namespace in = util::instrumentation;
+
+	auto& r = in::registry::instance();
+	auto const timer = r.timer("test timer");
+	auto const counter = r.counter("test counter");
+	auto const histogram = r.histogram("test histogram");
+
+	REQUIRE(r.timer("test timer") == timer);
+
+	r.reset();
+	r.enable_tracing(1024);
+
+	{
+		std::vector<std::jthread> threads;
+		for(auto t=0; t<4; ++t){
+			threads.emplace_back([=]
+			{
+				for(std::uint64_t i=0; i<100; ++i){
+					in::scoped_timer const scope{ timer };
+					in::add(counter);
+					in::record(histogram, i);
+				}
+			});
+		}
+	}
+
+	auto const s = r.collect();
+
+	auto const& t = find(s.timers, "test timer");
+	REQUIRE(t.count == 400);
+	REQUIRE(t.min_ns <= t.max_ns);
+	REQUIRE(t.total_ns >= t.max_ns);
+
+	REQUIRE(find(s.counters, "test counter").value == 400);
+
+	auto const& h = find(s.histograms, "test histogram");
+	REQUIRE(h.count == 400);
+	REQUIRE(h.sum == 4*(99*100/2));
+	REQUIRE(h.buckets[0] == 4);
+	REQUIRE(h.buckets[1] == 4);
+	REQUIRE(h.buckets[2] == 8);
+	REQUIRE(h.buckets[7] == 4*(100 - 64));
+
+	REQUIRE(s.events.size() + s.dropped_events >= 400);
+
+	SECTION("exporters"){
+		std::ostringstream json;
+		in::write_json(json, s);
+		REQUIRE(json.str().find("\"name\": \"test timer\", \"count\": 400")
+			!= std::string::npos);
+
+		std::ostringstream trace;
+		in::write_chrome_trace(trace, s);
+		REQUIRE(trace.str().starts_with("{\"displayTimeUnit\""));
+		REQUIRE(trace.str().find("\"ph\": \"X\"") != std::string::npos);
+	}
+
+	SECTION("reset"){
+		r.reset();
+		auto const z = r.collect();
+		REQUIRE(find(z.timers, "test timer").count == 0);
+		REQUIRE(find(z.counters, "test counter").value == 0);
+		REQUIRE(z.events.empty());
+	}
+
+	r.enable_tracing(0);
+}
+
+TEST_CASE("instrumentation exporters keep the nanoseconds", "[instrumentation]")
+{
+	namespace in = util::instrumentation;
+
+	in::snapshot s;
+	s.timers.push_back({ "late", 2, 1e10 + 0.5, 1e10 - 400.0, 900.5 });
+	s.events.push_back({ "late", 0, 1e10, 500.0 });
+
+	// reads back the number after `key` in `text`
+	auto number = [](std::string const& text, std::string const& key)
+	{
+		auto const i = text.find(key);
+		REQUIRE(i != std::string::npos);
+		return std::stod(text.substr(i + key.size()));
+	};
+
+	std::ostringstream trace;
+	trace << 1.5;
+	in::write_chrome_trace(trace, s);
+	trace << 1.25e10;
+
+	REQUIRE(number(trace.str(), "\"ts\": ")*1000.0 == 1e10);
+	REQUIRE(number(trace.str(), "\"dur\": ")*1000.0 == 500.0);
+	REQUIRE(trace.str().starts_with("1.5{"));
+	REQUIRE(trace.str().ends_with("\n1.25e+10"));
+
+	std::ostringstream json;
+	in::write_json(json, s);
+
+	REQUIRE(number(json.str(), "\"total_ns\": ") == 1e10 + 0.5);
+	REQUIRE(number(json.str(), "\"mean_ns\": ") == 5e9 + 0.25);
+	REQUIRE(number(json.str(), "\"min_ns\": ") == 1e10 - 400.0);
+	REQUIRE(number(json.str(), "\"max_ns\": ") == 900.5);
+	REQUIRE(json.precision() == 6);
+}
+
+TEST_CASE("instrumentation reuses the tables of finished threads", "[instrumentation]")
+{
+	namespace in = util::instrumentation;
+
+	auto& r = in::registry::instance();
+	auto const counter = r.counter("test reused counter");
+	r.reset();
+
+	auto const tables = r.thread_tables();
+
+	for(auto t=0; t<64; ++t)
+		std::jthread{ [=]{ in::add(counter, 2); } };
+
+	REQUIRE(r.thread_tables() <= tables + 1);
+	REQUIRE(find(r.collect().counters, "test reused counter").value == 128);
+}
+
+TEST_CASE("instrumentation macros", "[instrumentation]")
+{
+	for(auto i=0; i<3; ++i){
+		UTIL_INSTRUMENT_SCOPE("test macro scope");
+		UTIL_INSTRUMENT_COUNT("test macro counter", 2);
+		UTIL_INSTRUMENT_HISTOGRAM("test macro histogram", 5);
+	}
+
+	auto const s = util::instrumentation::registry::instance().collect();
+
+#ifdef UTIL_ENABLE_INSTRUMENTATION
+	REQUIRE(find(s.timers, "test macro scope").count == 3);
+	REQUIRE(find(s.counters, "test macro counter").value == 6);
+	REQUIRE(find(s.histograms, "test macro histogram").buckets[3] == 3);
+#else
+	REQUIRE_THROWS(find(s.timers, "test macro scope"));
+#endif
+}
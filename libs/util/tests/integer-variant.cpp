@@ -132,3 +132,77 @@ TEST_CASE("integers from precision", "[integer-variant]")
 		REQUIRE(test_precision_to_signed_integer<integer_32>(b));
 	}
 }
+
+TEST_CASE("dispatch by precision", "[integer-variant]")
+{
+	auto bits = []<class Int>(Int, int offset)
+	{
+		return static_cast<int>(util::integer_info<Int>::n_bits) + offset;
+	};
+
+	for(uint32_t n = 1; n <= 64; ++n){
+		REQUIRE(util::dispatch_by_precision<util::unsigned_flag>(n, bits, 1)
+			== static_cast<int>(n) + 1);
+		REQUIRE(util::dispatch_by_precision<util::signed_flag>(n, bits, 0)
+			== static_cast<int>(n));
+	}
+
+	REQUIRE_THROWS_AS(
+		util::dispatch_by_precision<util::unsigned_flag>(0, bits, 0),
+		std::runtime_error);
+	REQUIRE_THROWS_AS(
+		util::dispatch_by_precision<util::unsigned_flag>(65, bits, 0),
+		std::runtime_error);
+
+	SECTION("restricted to a variant"){
+		auto is_signed = []<class Int>(Int)
+		{
+			return std::is_same_v<
+				typename util::integer_info<Int>::signess,
+				util::signed_flag>;
+		};
+
+		REQUIRE(util::dispatch_by_variant_precision<
+			integer_32, util::signed_flag>(5, is_signed));
+		REQUIRE(!util::dispatch_by_variant_precision<
+			integer_32, util::unsigned_flag>(32, is_signed));
+		REQUIRE_THROWS_AS(
+			(util::dispatch_by_variant_precision<
+				integer_32, util::signed_flag>(1, is_signed)),
+			std::runtime_error);
+	}
+
+	SECTION("arguments are forwarded"){
+		std::string out;
+		util::dispatch_by_precision<util::unsigned_flag>(
+			12,
+			[]<class Int>(Int, std::string& s)
+			{
+				s = util::integer_info<Int>::type_name.data();
+			},
+			out);
+		REQUIRE(out == "uint12");
+	}
+
+	STATIC_REQUIRE(util::dispatch_by_precision<util::signed_flag>(
+		7, []<class Int>(Int){ return util::integer_info<Int>::n_bits + 0u; }) == 7);
+}
+
+TEST_CASE("precision tables match the linear search", "[integer-variant]")
+{
+	for(uint32_t n = 0; n <= 70; ++n){
+		auto const table = util::unsigned_integer_from_precision<integer_32>(n);
+		auto const linear = util::detail::make_integer<
+			integer_32, util::unsigned_flag>(
+				n,
+				util::integer_precisions_t<
+					util::unsigned_flag, integer_32>{});
+
+		REQUIRE(table.has_value() == linear.has_value());
+		if(table.has_value())
+			REQUIRE(table->index() == linear->index());
+	}
+
+	STATIC_REQUIRE(util::signed_integer_from_precision<integer_32>(3).has_value());
+	STATIC_REQUIRE(!util::signed_integer_from_precision<integer_32>(1).has_value());
+}
@@ -0,0 +1,246 @@
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "util/io.hpp"
+#include "util/integers.hpp"
+
+namespace{
+
+/**
+  * a path in the temporary directory that no other test run uses
+  */
+std::filesystem::path unique_temp_path(std::string const& name)
+{
+	auto const suffix = std::random_device{}();
+	return std::filesystem::temp_directory_path()
+		/ (name + "-" + std::to_string(suffix));
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("parse numbers with from_chars", "[io]")
+{
+	REQUIRE(util::from_chars<int>("42") == 42);
+	REQUIRE(util::from_chars<int>("  -7\n") == -7);
+	REQUIRE(util::from_chars<int>("+7") == 7);
+	REQUIRE(util::from_chars<uint8_t>("255") == 255);
+	REQUIRE(util::from_chars<double>("1.5e3") == 1500.0);
+	REQUIRE(util::from_chars<float>("-0.25") == -0.25f);
+
+	SECTION("errors"){
+		auto trailing = util::from_chars<int>("12a");
+		REQUIRE(!trailing.has_value());
+		REQUIRE(trailing.error().code == std::errc::invalid_argument);
+		REQUIRE(trailing.error().position == 2);
+
+		auto overflow = util::from_chars<uint8_t>("256");
+		REQUIRE(!overflow.has_value());
+		REQUIRE(overflow.error().code == std::errc::result_out_of_range);
+
+		REQUIRE(!util::from_chars<int>("").has_value());
+		REQUIRE(!util::from_chars<int>("+-1").has_value());
+		REQUIRE(!util::from_chars<unsigned>("-1").has_value());
+
+		REQUIRE_THROWS_AS(util::from_chars_or_throw<double>("x"), std::runtime_error);
+	}
+
+	SECTION("arbitrary integers"){
+		using uint5 = util::unsigned_integer<5>;
+		using int5 = util::signed_integer<5>;
+
+		REQUIRE(util::from_chars<uint5>("31") == 31);
+		REQUIRE(util::from_chars<int5>("-16") == -16);
+		REQUIRE(!util::from_chars<uint5>("32").has_value());
+		REQUIRE(!util::from_chars<int5>("16").has_value());
+		REQUIRE(!util::from_chars<int5>("-17").has_value());
+	}
+}
+
+TEST_CASE("stream_extractor", "[io]")
+{
+	int i = 0;
+	util::stream_extractor<int>{ i }("123");
+	REQUIRE(i == 123);
+
+	// the failures are left to the stream, which stores 0
+	REQUIRE_NOTHROW(util::stream_extractor<int>{ i }("abc"));
+	REQUIRE(i == 0);
+
+	std::optional<double> d;
+	util::stream_extractor<std::optional<double>>{ d }(" 2.5");
+	REQUIRE(d == 2.5);
+
+	std::string s;
+	util::stream_extractor<std::string>{ s }(std::string_view{ "word" });
+	REQUIRE(s == "word");
+}
+
+TEST_CASE("from_chars_extractor", "[io]")
+{
+	int i = 0;
+	util::from_chars_extractor<int>{ i }("123");
+	REQUIRE(i == 123);
+	REQUIRE_THROWS_AS(util::from_chars_extractor<int>{ i }("abc"), std::runtime_error);
+
+	std::optional<double> d;
+	util::from_chars_extractor<std::optional<double>>{ d }(" 2.5");
+	REQUIRE(d == 2.5);
+	util::from_chars_extractor<std::optional<double>>{ d }("");
+	REQUIRE(!d.has_value());
+
+	uint8_t u = 0;
+	util::from_chars_extractor<util::unsigned_integer<3>>{ u }("7");
+	REQUIRE(u == 7);
+}
+
+TEST_CASE("parse delimited columns", "[io]")
+{
+	SECTION("comma separated"){
+		auto [a, b, c] = util::parse_columns<int, double, std::optional<uint16_t>>(
+			"1, 0.5, 10\r\n"
+			"\n"
+			"-2,1e2,\n"
+			"3,-4,65535");
+
+		REQUIRE(a == std::vector{ 1, -2, 3 });
+		REQUIRE(b == std::vector{ 0.5, 100.0, -4.0 });
+		REQUIRE(c.size() == 3);
+		REQUIRE(c[0] == 10);
+		REQUIRE(!c[1].has_value());
+		REQUIRE(c[2] == 65535);
+	}
+
+	SECTION("whitespace separated"){
+		util::tokenizer_options const options{
+			.delimiter = ' ',
+			.merge_delimiters = true
+		};
+
+		auto [x, y] = util::parse_columns<float, util::signed_integer<4>>(
+			"  1.0   -8\n2.0 7  \n", options);
+
+		REQUIRE(x == std::vector{ 1.0f, 2.0f });
+		REQUIRE(y == std::vector<int8_t>{ -8, 7 });
+	}
+
+	SECTION("errors"){
+		REQUIRE_THROWS_AS(
+			util::parse_columns<int>("1\n2,3\n"), std::runtime_error);
+		REQUIRE_THROWS_AS(
+			(util::parse_columns<int, int>("1,2\n3\n")), std::runtime_error);
+		REQUIRE_THROWS_AS(
+			(util::parse_columns<int, int>("1,2\n3,x\n")), std::runtime_error);
+	}
+
+	SECTION("fields"){
+		std::size_t n = 0;
+		util::for_each_field(
+			"a;b\n;c",
+			[&](std::size_t, std::size_t, std::string_view){ ++n; },
+			{ .delimiter = ';' });
+		REQUIRE(n == 4);
+	}
+}
+
+TEST_CASE("buffered output and mapped input", "[io]")
+{
+	auto const path = unique_temp_path("util-io-tests");
+
+	std::string expected;
+
+	{
+		util::buffered_cout_or_file out{ path, 16 };
+		REQUIRE(out.is_open());
+
+		for(auto i=0; i<1000; ++i){
+			out << i << ',' << i*0.5 << "\n";
+			expected += std::to_string(i) + ",";
+			expected += i % 2 == 0 ? std::to_string(i/2) : std::to_string(i/2) + ".5";
+			expected += "\n";
+		}
+
+		std::string const big(100, 'x');
+		out.write(std::span{ big.data(), big.size() });
+		expected += big;
+
+		auto moved = std::move(out);
+		REQUIRE(!out.is_open());
+		moved << 1.5;
+		expected += "1.5";
+
+		REQUIRE_THROWS_AS(out << 0, std::logic_error);
+		REQUIRE_THROWS_AS(out << "x", std::logic_error);
+		REQUIRE_THROWS_AS(out.put('x'), std::logic_error);
+		REQUIRE_NOTHROW(out.flush());
+
+		// assigning to the moved-from object makes it usable again
+		out = std::move(moved);
+		REQUIRE(out.is_open());
+		REQUIRE_THROWS_AS(moved.put('x'), std::logic_error);
+	}
+
+	{
+		util::mapped_cin_or_file in{ path };
+		REQUIRE(in.is_mapped());
+		REQUIRE(in.size() == expected.size());
+		REQUIRE(in.view() == expected);
+
+		auto moved = std::move(in);
+		REQUIRE(moved.view() == expected);
+		REQUIRE(in.size() == 0);
+	}
+
+	{
+		util::buffered_cout_or_file empty{ path };
+	}
+
+	{
+		util::mapped_cin_or_file in{ path };
+		REQUIRE(in.data().empty());
+	}
+
+	std::filesystem::remove(path);
+
+	REQUIRE_THROWS_AS(
+		util::mapped_cin_or_file{ path },
+		std::runtime_error);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("mapped input of a pipe", "[io]")
+{
+	auto const path = unique_temp_path("util-io-tests-fifo");
+	REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+	std::string expected;
+	for(auto i=0; i<10000; ++i)
+		expected += std::to_string(i) + "\n";
+
+	std::jthread writer([&]
+	{
+		std::ofstream out{ path };
+		out << expected;
+	});
+
+	util::mapped_cin_or_file in{ path };
+	REQUIRE(!in.is_mapped());
+	REQUIRE(in.view() == expected);
+
+	writer.join();
+	std::filesystem::remove(path);
+}
+#endif
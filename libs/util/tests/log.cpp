@@ -0,0 +1,185 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "spdlog/sinks/ostream_sink.h"
+
+#include "util/log.hpp"
+
+namespace{
+
+auto make_sink(std::ostringstream& out)
+{
+	auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+	auto logger = std::make_shared<spdlog::logger>("test", sink);
+	logger->set_pattern("%l %v");
+	logger->set_level(spdlog::level::trace);
+	return logger;
+}
+
+/**
+  * a value whose formatting throws `error`
+  */
+template<class Error>
+struct throwing_value{
+	Error error;
+};
+
+} // end of anonymous namespace
+
+template<class Error>
+struct fmt::formatter<throwing_value<Error>>{
+	constexpr auto parse(fmt::format_parse_context& ctx)
+	{
+		return ctx.begin();
+	}
+
+	auto format(throwing_value<Error> const& v, fmt::format_context& ctx)
+		-> decltype(ctx.out())
+	{
+		throw v.error;
+	}
+};
+
+TEST_CASE("async logger formats in the background", "[log]")
+{
+	using namespace util::logging;
+
+	std::ostringstream out;
+
+	{
+		async_logger logger{ make_sink(out) };
+
+		{
+			std::string temporary = "captured";
+			logger.log(level::INFO, 0, "{} {} {:.1f}", temporary, 42, 0.25);
+			temporary = "changed";
+		}
+
+		logger.set_level(level::WARN);
+		REQUIRE(!logger.should_log(level::INFO));
+		logger.log(level::INFO, 0, "filtered");
+		logger.log(level::ERROR, 3, "value {}", 7);
+
+		std::string const big(200, 'x');
+		logger.log(level::WARN, 0, "{}{}", big, big);
+
+		logger.flush();
+
+		REQUIRE(out.str() ==
+			"info captured 42 0.2\n"
+			"error value 7 [3 similar messages suppressed]\n"
+			"warning " + big + big + "\n");
+	}
+}
+
+TEST_CASE("async logger reports the messages that fail", "[log]")
+{
+	using namespace std::chrono_literals;
+	using namespace util::logging;
+
+	std::ostringstream out;
+
+	{
+		async_logger logger{ make_sink(out) };
+
+		logger.log(level::INFO, 0, "first");
+		logger.flush();
+
+		// the worker sleeps until the next message
+		std::this_thread::sleep_for(10ms);
+
+		logger.log(level::INFO, 0, "bad {}",
+			throwing_value{ std::runtime_error("oops") });
+		logger.log(level::INFO, 0, "worse {}", throwing_value{ 3 });
+		logger.log(level::INFO, 0, "last");
+		logger.flush();
+
+		REQUIRE(out.str() ==
+			"info first\n"
+			"info invalid log message \"bad {}\": oops\n"
+			"info invalid log message \"worse {}\": unknown exception\n"
+			"info last\n");
+	}
+}
+
+TEST_CASE("async logger with many producers", "[log]")
+{
+	using namespace util::logging;
+
+	std::ostringstream out;
+	constexpr auto n_threads = 4;
+	constexpr auto n_messages = 1000;
+
+	{
+		async_logger logger{ make_sink(out), 16 };
+
+		{
+			std::vector<std::jthread> threads;
+			for(auto t=0; t<n_threads; ++t){
+				threads.emplace_back([&logger, t]
+				{
+					for(auto i=0; i<n_messages; ++i)
+						logger.log(level::INFO, 0, "{} {}", t, i);
+				});
+			}
+		}
+
+		logger.flush();
+
+		std::istringstream lines{ out.str() };
+		std::uint64_t written = 0;
+		for(std::string line; std::getline(lines, line); )
+			written += line.starts_with("info ") ? 1 : 0;
+
+		// with such a small buffer some messages are dropped and
+		// reported in warnings instead
+		REQUIRE(written + logger.dropped() == n_threads*n_messages);
+	}
+}
+
+TEST_CASE("rate limiter", "[log]")
+{
+	using namespace std::chrono_literals;
+
+	util::logging::rate_limiter limiter{ 1h };
+
+	REQUIRE(limiter.try_acquire() == 0u);
+
+	for(auto i=0; i<10; ++i)
+		REQUIRE(!limiter.try_acquire().has_value());
+
+	util::logging::rate_limiter always{ 0ns };
+	REQUIRE(always.try_acquire() == 0u);
+	REQUIRE(always.try_acquire() == 0u);
+}
+
+TEST_CASE("log macros skip the arguments of disabled messages", "[log]")
+{
+	using namespace std::chrono_literals;
+	using util::logging::level;
+
+	auto evaluations = 0;
+	auto argument = [&]{ return ++evaluations; };
+
+	auto& logger = util::logging::default_logger();
+	auto const previous = logger.get_level();
+
+	logger.set_level(level::OFF);
+	UTIL_LOG(INFO, "{}", argument());
+	REQUIRE(evaluations == 0);
+	logger.set_level(previous);
+
+	util::logging::rate_limiter limiter{ 1h };
+	REQUIRE(limiter.try_acquire() == 0u);
+	UTIL_LOG_LIMITED(CRITICAL, limiter, "{}", argument());
+	REQUIRE(evaluations == 0);
+	REQUIRE(!limiter.try_acquire().has_value());
+}
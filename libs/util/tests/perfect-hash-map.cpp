@@ -0,0 +1,78 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+
+#include "util/perfect-hash-map.hpp"
+#include "util/static-string.hpp"
+
+namespace{
+
+enum class command{ OPEN, SAVE, QUIT, UNDO, REDO };
+
+constexpr auto commands = util::make_perfect_hash_map(
+	std::pair{ util::static_string("open"), command::OPEN },
+	std::pair{ util::static_string("save"), command::SAVE },
+	std::pair{ util::static_string("quit"), command::QUIT },
+	std::pair{ util::static_string("undo"), command::UNDO },
+	std::pair{ util::static_string("redo"), command::REDO });
+
+} // end of anonymous namespace
+
+TEST_CASE("perfect hash map in constant expressions", "[util]")
+{
+	STATIC_REQUIRE(commands.size() == 5);
+	STATIC_REQUIRE(*commands.find("quit") == command::QUIT);
+	STATIC_REQUIRE(commands.at("redo") == command::REDO);
+	STATIC_REQUIRE(commands.index_of("save") == 1);
+	STATIC_REQUIRE(commands.key(3) == "undo");
+	STATIC_REQUIRE(!commands.contains("close"));
+	STATIC_REQUIRE(!commands.contains("ope"));
+	STATIC_REQUIRE(!commands.contains(""));
+
+	constexpr auto single = util::make_perfect_hash_map(
+		std::pair{ util::static_string("uniform") + "_color", 3.5 });
+	STATIC_REQUIRE(single.at("uniform_color") == 3.5);
+	STATIC_REQUIRE(single.find("uniform") == nullptr);
+}
+
+TEST_CASE("perfect hash map with many keys", "[util]")
+{
+	using util::static_string;
+	using util::to_static_string;
+
+	static constexpr auto m = util::make_perfect_hash_map(
+		std::pair{ "key" + to_static_string<0>(), 0 },
+		std::pair{ "key" + to_static_string<1>(), 1 },
+		std::pair{ "key" + to_static_string<2>(), 2 },
+		std::pair{ "key" + to_static_string<3>(), 3 },
+		std::pair{ "key" + to_static_string<4>(), 4 },
+		std::pair{ "key" + to_static_string<5>(), 5 },
+		std::pair{ "key" + to_static_string<6>(), 6 },
+		std::pair{ "key" + to_static_string<7>(), 7 },
+		std::pair{ "key" + to_static_string<8>(), 8 },
+		std::pair{ "key" + to_static_string<9>(), 9 },
+		std::pair{ "key" + to_static_string<10>(), 10 },
+		std::pair{ "key" + to_static_string<11>(), 11 },
+		std::pair{ "key" + to_static_string<12>(), 12 },
+		std::pair{ "key" + to_static_string<13>(), 13 },
+		std::pair{ "key" + to_static_string<14>(), 14 },
+		std::pair{ "key" + to_static_string<15>(), 15 },
+		std::pair{ "key" + to_static_string<16>(), 16 },
+		std::pair{ "key" + to_static_string<17>(), 17 },
+		std::pair{ "key" + to_static_string<18>(), 18 },
+		std::pair{ "key" + to_static_string<19>(), 19 },
+		std::pair{ "key" + to_static_string<20>(), 20 },
+		std::pair{ static_string("a_much_longer_key_than_the_others"), 21 });
+
+	for(int i=0; i<21; ++i){
+		auto const k = "key" + std::to_string(i);
+		REQUIRE(m.contains(k));
+		REQUIRE(m.at(k) == i);
+		REQUIRE(m.key(static_cast<std::size_t>(i)) == k);
+	}
+
+	REQUIRE(m.at("a_much_longer_key_than_the_others") == 21);
+	REQUIRE(!m.contains("key21"));
+	REQUIRE(!m.contains("key"));
+	REQUIRE_THROWS_AS(m.at("key-1"), std::out_of_range);
+}
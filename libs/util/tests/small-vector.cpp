@@ -0,0 +1,143 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "util/small-vector.hpp"
+
+TEST_CASE("small vector", "[util]")
+{
+	using vector_t = util::small_vector<int, 4>;
+
+	vector_t v{ 1, 2, 3 };
+	REQUIRE(v.is_inline());
+	REQUIRE(v.capacity() == 4);
+
+	v.push_back(4);
+	REQUIRE(v.is_inline());
+
+	v.push_back(v[0]);
+	REQUIRE(!v.is_inline());
+	REQUIRE(v.capacity() == 8);
+	REQUIRE(v == vector_t{ 1, 2, 3, 4, 1 });
+
+	v.insert(v.begin() + 1, 5, v[4]);
+	REQUIRE(v == vector_t{ 1, 1, 1, 1, 1, 1, 2, 3, 4, 1 });
+
+	v.erase(v.begin(), v.begin() + 5);
+	REQUIRE(v == vector_t{ 1, 2, 3, 4, 1 });
+
+	v.append(std::span{ v.data(), v.size() });
+	REQUIRE(v == vector_t{ 1, 2, 3, 4, 1, 1, 2, 3, 4, 1 });
+
+	auto const data = v.data();
+	auto moved = std::move(v);
+	REQUIRE(moved.data() == data);
+	REQUIRE(v.empty());
+	REQUIRE(v.is_inline());
+
+	vector_t small{ 7, 8 };
+	auto moved_small = std::move(small);
+	REQUIRE(moved_small.is_inline());
+	REQUIRE(moved_small == vector_t{ 7, 8 });
+
+	moved_small = moved;
+	REQUIRE(moved_small == moved);
+	REQUIRE_THROWS_AS(moved_small.at(10), std::out_of_range);
+}
+
+TEST_CASE("small vector of non trivial elements", "[util]")
+{
+	using vector_t = util::small_vector<std::shared_ptr<int>, 2>;
+
+	auto const p = std::make_shared<int>(42);
+
+	{
+		vector_t v;
+		for(int i=0; i<10; ++i)
+			v.push_back(p);
+
+		REQUIRE(p.use_count() == 11);
+
+		v.emplace(v.begin(), std::make_shared<int>(1));
+		REQUIRE(*v.front() == 1);
+
+		v.resize(3);
+		REQUIRE(p.use_count() == 3);
+
+		auto copy = v;
+		REQUIRE(p.use_count() == 5);
+
+		vector_t moved;
+		moved = std::move(copy);
+		REQUIRE(p.use_count() == 5);
+
+		moved.pop_back();
+		REQUIRE(p.use_count() == 4);
+	}
+
+	REQUIRE(p.use_count() == 1);
+
+	util::small_vector<std::string, 2> s(3, "abc");
+	s.insert(s.begin(), { "x", "y" });
+	REQUIRE(s.size() == 5);
+	REQUIRE(s[0] == "x");
+	REQUIRE(s[4] == "abc");
+}
+
+namespace{
+
+/**
+  * an element whose move may throw, so the vector relocates it by copy,
+  * and whose copy throws while `fail` is set
+  */
+struct throwing_copy{
+	static inline bool fail = false;
+
+	explicit throwing_copy(std::shared_ptr<int> a_p)
+		: p(std::move(a_p))
+	{}
+
+	throwing_copy(throwing_copy const& other)
+		: p(other.p)
+	{
+		if(fail)
+			throw std::runtime_error("copy failed");
+	}
+
+	throwing_copy(throwing_copy&& other)
+		: p(std::move(other.p))
+	{}
+
+	std::shared_ptr<int> p;
+};
+
+} // end of anonymous namespace
+
+TEST_CASE("small vector growth with a throwing relocation", "[util]")
+{
+	auto const p = std::make_shared<int>(42);
+
+	{
+		util::small_vector<throwing_copy, 2> v;
+		v.emplace_back(p);
+		v.emplace_back(p);
+		REQUIRE(p.use_count() == 3);
+
+		throwing_copy::fail = true;
+		REQUIRE_THROWS_AS(v.emplace_back(p), std::runtime_error);
+		throwing_copy::fail = false;
+
+		// the new element is destroyed and the old ones are kept
+		REQUIRE(v.size() == 2);
+		REQUIRE(v.is_inline());
+		REQUIRE(p.use_count() == 3);
+
+		v.emplace_back(p);
+		REQUIRE(v.size() == 3);
+		REQUIRE(p.use_count() == 4);
+	}
+
+	REQUIRE(p.use_count() == 1);
+}
@@ -0,0 +1,97 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+#include <vector>
+
+#include "util/static-vector.hpp"
+
+constexpr bool constexpr_static_vector()
+{
+	util::static_vector<int, 8> v{ 1, 2, 3 };
+	v.push_back(5);
+	v.insert(v.begin() + 3, 4);
+	v.erase(v.begin());
+	v.emplace(v.begin(), 0);
+
+	int const extra[] = { 6, 7 };
+	v.append(extra);
+
+	return v.size() == 7
+		&& v.front() == 0
+		&& v.back() == 7
+		&& v[3] == 4
+		&& v.try_emplace_back(8) != nullptr
+		&& v.try_emplace_back(9) == nullptr;
+}
+
+TEST_CASE("static vector of trivial elements", "[util]")
+{
+	using vector_t = util::static_vector<int, 8>;
+
+	STATIC_REQUIRE(std::is_trivially_copyable_v<vector_t>);
+	STATIC_REQUIRE(vector_t::capacity() == 8);
+	STATIC_REQUIRE(constexpr_static_vector());
+
+	vector_t v;
+	REQUIRE(v.empty());
+
+	for(int i=0; i<8; ++i)
+		v.push_back(i);
+
+	REQUIRE(v.full());
+	REQUIRE_THROWS_AS(v.push_back(8), std::runtime_error);
+	REQUIRE_THROWS_AS(v.at(8), std::out_of_range);
+
+	v.erase(v.begin() + 2, v.begin() + 5);
+	REQUIRE(v == vector_t{ 0, 1, 5, 6, 7 });
+
+	v.insert(v.begin() + 1, 2, 9);
+	REQUIRE(v == vector_t{ 0, 9, 9, 1, 5, 6, 7 });
+
+	REQUIRE_THROWS_AS(v.insert(v.end(), 2, 0), std::runtime_error);
+	REQUIRE(v.size() == 7);
+
+	auto copy = v;
+	copy.pop_back();
+	REQUIRE(copy.size() == 6);
+	REQUIRE(v.size() == 7);
+
+	v.resize(2);
+	REQUIRE(v == vector_t{ 0, 9 });
+	v.resize(4, 3);
+	REQUIRE(v == vector_t{ 0, 9, 3, 3 });
+
+	std::vector<int> const values{ 4, 5 };
+	v.insert(v.begin(), values.begin(), values.end());
+	REQUIRE(v == vector_t{ 4, 5, 0, 9, 3, 3 });
+}
+
+TEST_CASE("static vector of non trivial elements", "[util]")
+{
+	using vector_t = util::static_vector<std::string, 4>;
+
+	STATIC_REQUIRE(!std::is_trivially_copyable_v<vector_t>);
+
+	vector_t v;
+	v.emplace_back(40, 'a');
+	v.emplace_back("b");
+	v.emplace(v.begin(), "c");
+
+	REQUIRE(v.size() == 3);
+	REQUIRE(v[0] == "c");
+	REQUIRE(v[1] == std::string(40, 'a'));
+	REQUIRE(v[2] == "b");
+
+	auto copy = v;
+	auto moved = std::move(copy);
+	REQUIRE(moved == v);
+
+	v.erase(v.begin() + 1);
+	REQUIRE(v == vector_t{ "c", "b" });
+
+	v = moved;
+	REQUIRE(v.size() == 3);
+
+	v.clear();
+	REQUIRE(v.empty());
+}